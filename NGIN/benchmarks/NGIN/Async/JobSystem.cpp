@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <NGIN/Async/JobSystem.hpp>
+
+#include <atomic>
+
+using namespace NGIN;
+
+namespace
+{
+    // Spawning many empty jobs from the main thread, mostly measures allocation, push and steal
+    void BM_SpawnAndWait(benchmark::State& state)
+    {
+        Async::JobSystem jobSystem(static_cast<UInt32>(state.range(1)));
+        const Int64 jobCount = state.range(0);
+
+        for (auto _: state)
+        {
+            Async::JobCounter counter;
+            for (Int64 i = 0; i < jobCount; ++i)
+                jobSystem.Spawn([]() {}, &counter);
+            jobSystem.Wait(counter);
+        }
+        state.SetItemsProcessed(state.iterations() * jobCount);
+    }
+
+    // Every job is spawned by the main thread and must be stolen to run on a worker
+    void BM_StealHeavy(benchmark::State& state)
+    {
+        Async::JobSystem jobSystem(static_cast<UInt32>(state.range(0)));
+        std::atomic<Int64> sink = 0;
+
+        for (auto _: state)
+        {
+            Async::JobCounter counter;
+            for (Int64 i = 0; i < 1024; ++i)
+            {
+                jobSystem.Spawn([&sink]()
+                {
+                    Int64 value = 0;
+                    for (Int64 j = 0; j < 256; ++j)
+                        benchmark::DoNotOptimize(value += j);
+                    sink.fetch_add(value, std::memory_order_relaxed);
+                }, &counter);
+            }
+            jobSystem.Wait(counter);
+        }
+        state.SetItemsProcessed(state.iterations() * 1024);
+    }
+
+    // A tree of jobs, each level spawned by the jobs of the level above
+    void SpawnTree(Async::JobSystem& jobSystem, Async::JobCounter& counter, Int64 depth)
+    {
+        if (depth == 0)
+            return;
+        for (int i = 0; i < 4; ++i)
+            jobSystem.Spawn([&jobSystem, &counter, depth]() { SpawnTree(jobSystem, counter, depth - 1); }, &counter);
+    }
+
+    void BM_NestedSpawn(benchmark::State& state)
+    {
+        Async::JobSystem jobSystem(static_cast<UInt32>(state.range(0)));
+
+        for (auto _: state)
+        {
+            Async::JobCounter counter;
+            SpawnTree(jobSystem, counter, 6);
+            jobSystem.Wait(counter);
+        }
+        // 4 + 4^2 + ... + 4^6 jobs
+        state.SetItemsProcessed(state.iterations() * 5460);
+    }
+
+    void BM_ParallelFor(benchmark::State& state)
+    {
+        Async::JobSystem jobSystem(static_cast<UInt32>(state.range(1)));
+        std::vector<F64> values(1 << 20, 1.0);
+
+        for (auto _: state)
+        {
+            jobSystem.ParallelFor(values.size(), static_cast<Size>(state.range(0)), [&values](Size begin, Size end)
+            {
+                for (Size i = begin; i < end; ++i)
+                    values[i] = values[i] * 1.0001 + 0.5;
+            });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<Int64>(values.size()));
+    }
+
+    // Cost of waiting on a counter that has already reached zero
+    void BM_WaitOnFinishedCounter(benchmark::State& state)
+    {
+        Async::JobSystem jobSystem(1);
+        Async::JobCounter counter;
+
+        for (auto _: state)
+            jobSystem.Wait(counter);
+    }
+}
+
+BENCHMARK(BM_SpawnAndWait)->ArgsProduct({{64, 1024, 16384}, {1, 3, 7}})->UseRealTime();
+BENCHMARK(BM_StealHeavy)->Arg(1)->Arg(3)->Arg(7)->UseRealTime();
+BENCHMARK(BM_NestedSpawn)->Arg(1)->Arg(3)->Arg(7)->UseRealTime();
+BENCHMARK(BM_ParallelFor)->ArgsProduct({{1024, 16384}, {1, 3, 7}})->UseRealTime();
+BENCHMARK(BM_WaitOnFinishedCounter);
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <NGIN/Core/World.hpp>
+
+#include <vector>
+
+using namespace NGIN;
+
+namespace
+{
+    constexpr Int64 ENTITY_COUNT = 1 << 16;
+
+    struct Position
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 1.0f;
+        float y = 1.0f;
+        float z = 1.0f;
+    };
+
+    struct TableTag
+    {
+        int frames = 0;
+    };
+
+    struct SparseTag
+    {
+        static constexpr Core::ECS::ComponentStorage STORAGE = Core::ECS::ComponentStorage::SparseSet;
+
+        int frames = 0;
+    };
+
+    std::vector<Core::ECS::Entity> CreateEntities(Core::World& world)
+    {
+        std::vector<Core::ECS::Entity> entities;
+        for (Int64 i = 0; i < ENTITY_COUNT; ++i)
+            entities.push_back(world.CreateEntity(Position {}, Velocity {}));
+        return entities;
+    }
+
+    // A tag toggled on a quarter of the entities per frame, the archetype move versus the sparse set append
+    template<typename Tag>
+    void BM_ToggleTag(benchmark::State& state)
+    {
+        Core::World world;
+        const std::vector<Core::ECS::Entity> entities = CreateEntities(world);
+        for (auto _: state)
+        {
+            for (Size i = 0; i < entities.size(); i += 4)
+                world.AddComponent<Tag>(entities[i]);
+            for (Size i = 0; i < entities.size(); i += 4)
+                world.RemoveComponent<Tag>(entities[i]);
+        }
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT / 2);
+    }
+
+    // Integrating the positions of the tagged entities, tagged every range(0)-th entity
+    template<typename Tag>
+    void BM_QueryTagged(benchmark::State& state)
+    {
+        Core::World world;
+        const std::vector<Core::ECS::Entity> entities = CreateEntities(world);
+        for (Size i = 0; i < entities.size(); i += static_cast<Size>(state.range(0)))
+            world.AddComponent<Tag>(entities[i]);
+
+        for (auto _: state)
+        {
+            world.Query<Position&, const Velocity&, Core::ECS::With<Tag>>().ForEach(
+                    [](Position& position, const Velocity& velocity)
+                    {
+                        position.x += velocity.x * 0.016f;
+                        position.y += velocity.y * 0.016f;
+                        position.z += velocity.z * 0.016f;
+                    });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT / state.range(0));
+    }
+}
+
+BENCHMARK(BM_ToggleTag<TableTag>);
+BENCHMARK(BM_ToggleTag<SparseTag>);
+BENCHMARK(BM_QueryTagged<TableTag>)->Arg(1)->Arg(64);
+BENCHMARK(BM_QueryTagged<SparseTag>)->Arg(1)->Arg(64);
@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+#include <NGIN/Core/World.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace NGIN;
+
+namespace
+{
+    constexpr UInt32 ENTITY_COUNT = 1 << 20;
+    constexpr UInt32 QUERY_COUNT = 1024;
+    constexpr F32 EXTENT = 1000.0f;
+
+    Core::SpatialIndexSettings GetSettings(Int64 kind)
+    {
+        Core::SpatialIndexSettings settings;
+        settings.kind = static_cast<Core::SpatialIndexKind>(kind);
+        settings.cellSize = 25.0f;
+        settings.octreeHalfSize = EXTENT;
+        settings.octreeMaxDepth = 6;
+        return settings;
+    }
+
+    // ENTITY_COUNT spheres of radius up to 2 spread uniformly over a cube of 2 * EXTENT
+    Scope<Core::SpatialIndex> BuildIndex(Int64 kind, std::vector<glm::vec3>& centers)
+    {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<F32> position(-EXTENT, EXTENT);
+        std::uniform_real_distribution<F32> radius(0.0f, 2.0f);
+        Scope<Core::SpatialIndex> index = Core::CreateSpatialIndex(GetSettings(kind));
+        centers.clear();
+        for (UInt32 i = 0; i < ENTITY_COUNT; ++i)
+        {
+            centers.emplace_back(position(random), position(random), position(random));
+            index->Set(Core::ECS::Entity::FromParts(i, 0), centers.back(), radius(random));
+        }
+        return index;
+    }
+
+    std::vector<glm::vec3> MakePoints(UInt32 count, UInt32 seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<F32> position(-EXTENT, EXTENT);
+        std::vector<glm::vec3> points;
+        for (UInt32 i = 0; i < count; ++i)
+            points.emplace_back(position(random), position(random), position(random));
+        return points;
+    }
+
+    void BM_SpatialIndexQueryRadius(benchmark::State& state)
+    {
+        std::vector<glm::vec3> centers;
+        const Scope<Core::SpatialIndex> index = BuildIndex(state.range(0), centers);
+        std::vector<Core::SpatialSphere> queries;
+        for (glm::vec3 point: MakePoints(QUERY_COUNT, 2))
+            queries.push_back({point, 25.0f});
+
+        Core::SpatialQueryResults results;
+        for (auto _: state)
+        {
+            index->QueryRadius(queries, results);
+            benchmark::DoNotOptimize(results.entities.data());
+        }
+        state.SetItemsProcessed(state.iterations() * QUERY_COUNT);
+        state.counters["hits"] = static_cast<F64>(results.entities.size()) / QUERY_COUNT;
+    }
+
+    void BM_SpatialIndexFindNearest(benchmark::State& state)
+    {
+        std::vector<glm::vec3> centers;
+        const Scope<Core::SpatialIndex> index = BuildIndex(state.range(0), centers);
+        const std::vector<glm::vec3> points = MakePoints(QUERY_COUNT, 3);
+
+        std::vector<Core::ECS::Entity> nearest(QUERY_COUNT);
+        for (auto _: state)
+        {
+            index->FindNearest(points, std::numeric_limits<F32>::infinity(), nearest);
+            benchmark::DoNotOptimize(nearest.data());
+        }
+        state.SetItemsProcessed(state.iterations() * QUERY_COUNT);
+    }
+
+    // Every entity moves a little per iteration, as the world does for entities whose transform changed
+    void BM_SpatialIndexUpdate(benchmark::State& state)
+    {
+        std::vector<glm::vec3> centers;
+        const Scope<Core::SpatialIndex> index = BuildIndex(state.range(0), centers);
+
+        F32 offset = 0.0f;
+        for (auto _: state)
+        {
+            offset = offset > 0.0f ? -0.5f : 0.5f;
+            for (UInt32 i = 0; i < ENTITY_COUNT; ++i)
+            {
+                centers[i].x += offset;
+                index->Set(Core::ECS::Entity::FromParts(i, 0), centers[i], 1.0f);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+    }
+
+    // Moving a root of the transform hierarchy reindexes it through the world's change detection
+    void BM_WorldUpdateTransforms(benchmark::State& state)
+    {
+        Core::World world(GetSettings(state.range(0)));
+        std::mt19937 random(4);
+        std::uniform_real_distribution<F32> position(-EXTENT, EXTENT);
+        std::vector<Core::ECS::Entity> entities;
+        for (UInt32 i = 0; i < ENTITY_COUNT; ++i)
+        {
+            entities.push_back(world.CreateEntity(Core::SpatialBounds {1.0f}));
+            Core::Transform local;
+            local.position = glm::vec3(position(random), position(random), position(random));
+            world.GetTransforms().Add(entities.back(), local);
+        }
+        world.UpdateTransforms();
+
+        // A thousandth of the entities move per frame
+        UInt32 next = 0;
+        for (auto _: state)
+        {
+            for (UInt32 i = 0; i < ENTITY_COUNT / 1024; ++i, next = (next + 1021) % ENTITY_COUNT)
+            {
+                Core::Transform local = world.GetTransforms().GetLocal(entities[next]);
+                local.position.y += 1.0f;
+                world.GetTransforms().SetLocal(entities[next], local);
+            }
+            world.UpdateTransforms();
+        }
+        state.SetItemsProcessed(state.iterations() * (ENTITY_COUNT / 1024));
+    }
+}
+
+// Argument 0 is the hash grid, 1 the loose octree
+BENCHMARK(BM_SpatialIndexQueryRadius)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SpatialIndexFindNearest)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SpatialIndexUpdate)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WorldUpdateTransforms)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
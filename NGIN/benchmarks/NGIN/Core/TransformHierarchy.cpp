@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <NGIN/Core/TransformHierarchy.hpp>
+
+#include <vector>
+
+using namespace NGIN;
+
+namespace
+{
+    // A complete 4-ary tree of range(0) nodes, every node offset and rotated relative to its parent
+    std::vector<Core::ECS::Entity> BuildTree(Core::TransformHierarchy& hierarchy, Int64 count)
+    {
+        std::vector<Core::ECS::Entity> entities;
+        for (Int64 i = 0; i < count; ++i)
+        {
+            Core::Transform local;
+            local.position = glm::vec3(1.0f, 0.5f, 0.0f);
+            local.rotation = glm::angleAxis(0.1f, glm::vec3(0.0f, 0.0f, 1.0f));
+            entities.push_back(Core::ECS::Entity::FromParts(static_cast<UInt32>(i), 0));
+            hierarchy.Add(entities.back(), local, i == 0 ? Core::ECS::Entity() : entities[(i - 1) / 4]);
+        }
+        hierarchy.Update();
+        return entities;
+    }
+
+    // Moving the root, every world matrix is recomputed level by level
+    void BM_TransformHierarchyFullUpdate(benchmark::State& state)
+    {
+        Core::TransformHierarchy hierarchy;
+        const std::vector<Core::ECS::Entity> entities = BuildTree(hierarchy, state.range(0));
+
+        Core::Transform root = hierarchy.GetLocal(entities[0]);
+        for (auto _: state)
+        {
+            root.position.x += 1.0f;
+            hierarchy.SetLocal(entities[0], root);
+            hierarchy.Update();
+            benchmark::DoNotOptimize(hierarchy.GetWorldMatrix(entities.back()));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Moving one leaf, only its own matrix is recomputed while the clean levels above are skipped
+    void BM_TransformHierarchyLeafUpdate(benchmark::State& state)
+    {
+        Core::TransformHierarchy hierarchy;
+        const std::vector<Core::ECS::Entity> entities = BuildTree(hierarchy, state.range(0));
+
+        Core::Transform leaf = hierarchy.GetLocal(entities.back());
+        for (auto _: state)
+        {
+            leaf.position.x += 1.0f;
+            hierarchy.SetLocal(entities.back(), leaf);
+            hierarchy.Update();
+            benchmark::DoNotOptimize(hierarchy.GetWorldMatrix(entities.back()));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(BM_TransformHierarchyFullUpdate)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_TransformHierarchyLeafUpdate)->Arg(1 << 16);
@@ -0,0 +1,244 @@
+#include <benchmark/benchmark.h>
+#include <NGIN/Async/JobSystem.hpp>
+#include <NGIN/Core/World.hpp>
+
+#include <vector>
+
+using namespace NGIN;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 1.0f;
+        float y = 1.0f;
+        float z = 1.0f;
+    };
+
+    struct Health
+    {
+        float value = 100.0f;
+    };
+
+    // Integrating positions over entities spread across two archetypes, a linear walk of the columns
+    void BM_WorldEach(benchmark::State& state)
+    {
+        Core::World world;
+        const Int64 entityCount = state.range(0);
+        for (Int64 i = 0; i < entityCount; ++i)
+        {
+            if (i % 2 == 0)
+                world.CreateEntity(Position {}, Velocity {});
+            else
+                world.CreateEntity(Position {}, Velocity {}, Health {});
+        }
+
+        for (auto _: state)
+        {
+            world.Each<Position, const Velocity>([](Position& position, const Velocity& velocity)
+            {
+                position.x += velocity.x * 0.016f;
+                position.y += velocity.y * 0.016f;
+                position.z += velocity.z * 0.016f;
+            });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * entityCount);
+    }
+
+    // The same integration over per-chunk spans, the inner loop is a plain vectorizable array loop
+    void BM_WorldQueryChunks(benchmark::State& state)
+    {
+        Core::World world;
+        const Int64 entityCount = state.range(0);
+        for (Int64 i = 0; i < entityCount; ++i)
+        {
+            if (i % 2 == 0)
+                world.CreateEntity(Position {}, Velocity {});
+            else
+                world.CreateEntity(Position {}, Velocity {}, Health {});
+        }
+
+        for (auto _: state)
+        {
+            for (auto chunk: world.Query<Position&, const Velocity&>())
+            {
+                Position* positions = chunk.Get<Position>().data();
+                const Velocity* velocities = chunk.Get<Velocity>().data();
+                const Size count = chunk.GetCount();
+                for (Size i = 0; i < count; ++i)
+                {
+                    positions[i].x += velocities[i].x * 0.016f;
+                    positions[i].y += velocities[i].y * 0.016f;
+                    positions[i].z += velocities[i].z * 0.016f;
+                }
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * entityCount);
+    }
+
+    // Three systems, two of them independent, over 1M entities on a job system of range(0) threads
+    void BM_WorldRunSystems(benchmark::State& state)
+    {
+        Async::JobSystem jobSystem(static_cast<UInt32>(state.range(0)) - 1);
+        Core::World world;
+        constexpr Int64 ENTITY_COUNT = 1 << 20;
+        for (Int64 i = 0; i < ENTITY_COUNT; ++i)
+            world.CreateEntity(Position {}, Velocity {}, Health {});
+
+        world.AddSystem<Position&, const Velocity&>("Integrate", [](const auto& chunk, F64 deltaTime)
+        {
+            auto positions = chunk.template Get<Position>();
+            auto velocities = chunk.template Get<Velocity>();
+            for (Size i = 0; i < chunk.GetCount(); ++i)
+            {
+                positions[i].x += velocities[i].x * static_cast<float>(deltaTime);
+                positions[i].y += velocities[i].y * static_cast<float>(deltaTime);
+                positions[i].z += velocities[i].z * static_cast<float>(deltaTime);
+            }
+        });
+        world.AddSystem<Health&>("Regenerate", [](const auto& chunk)
+        {
+            for (Health& health: chunk.template Get<Health>())
+                health.value = health.value < 100.0f ? health.value + 1.0f : health.value;
+        });
+        world.AddSystem<Velocity&, const Position&>("Bounce", [](const auto& chunk)
+        {
+            auto velocities = chunk.template Get<Velocity>();
+            auto positions = chunk.template Get<Position>();
+            for (Size i = 0; i < chunk.GetCount(); ++i)
+                velocities[i].y = positions[i].y > 100.0f ? -velocities[i].y : velocities[i].y;
+        });
+
+        for (auto _: state)
+            world.RunSystems(0.016, &jobSystem);
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+    }
+
+    // Structural changes, every iteration moves entities to another archetype and back
+    void BM_WorldAddRemoveComponent(benchmark::State& state)
+    {
+        Core::World world;
+        std::vector<Core::ECS::Entity> entities;
+        for (Int64 i = 0; i < state.range(0); ++i)
+            entities.push_back(world.CreateEntity(Position {}, Velocity {}));
+
+        for (auto _: state)
+        {
+            for (Core::ECS::Entity entity: entities)
+                world.AddComponent<Health>(entity);
+            for (Core::ECS::Entity entity: entities)
+                world.RemoveComponent<Health>(entity);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+    }
+
+    // The same structural changes recorded into a command buffer and played back sorted by entity
+    void BM_WorldDeferredAddRemoveComponent(benchmark::State& state)
+    {
+        Core::World world;
+        std::vector<Core::ECS::Entity> entities;
+        for (Int64 i = 0; i < state.range(0); ++i)
+            entities.push_back(world.CreateEntity(Position {}, Velocity {}));
+
+        Core::ECS::CommandBuffer& commands = world.GetCommandBuffer();
+        for (auto _: state)
+        {
+            for (Core::ECS::Entity entity: entities)
+                commands.AddComponent<Health>(entity);
+            world.FlushCommands();
+            for (Core::ECS::Entity entity: entities)
+                commands.RemoveComponent<Health>(entity);
+            world.FlushCommands();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+    }
+
+    void BM_WorldCreateDestroy(benchmark::State& state)
+    {
+        Core::World world;
+        std::vector<Core::ECS::Entity> entities(static_cast<Size>(state.range(0)));
+
+        for (auto _: state)
+        {
+            for (Core::ECS::Entity& entity: entities)
+                entity = world.CreateEntity(Position {}, Velocity {});
+            for (Core::ECS::Entity entity: entities)
+                world.DestroyEntity(entity);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Random access through handles, a generation compare and an index into the entity table
+    void BM_WorldGetComponent(benchmark::State& state)
+    {
+        Core::World world;
+        std::vector<Core::ECS::Entity> entities;
+        for (Int64 i = 0; i < state.range(0); ++i)
+            entities.push_back(world.CreateEntity(Position {}, Velocity {}));
+        // Recycle half of the slots so handles carry different generations
+        for (Size i = 0; i < entities.size(); i += 2)
+        {
+            world.DestroyEntity(entities[i]);
+            entities[i] = world.CreateEntity(Position {}, Velocity {});
+        }
+
+        for (auto _: state)
+        {
+            float sum = 0.0f;
+            for (Core::ECS::Entity entity: entities)
+            {
+                if (const Position* position = world.TryGetComponent<Position>(entity))
+                    sum += position->x;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // A Changed<T> pass over 1M entities of which range(0), spread evenly, changed since the last pass
+    void BM_WorldChangedQuery(benchmark::State& state)
+    {
+        Core::World world;
+        constexpr Int64 ENTITY_COUNT = 1 << 20;
+        std::vector<Core::ECS::Entity> entities;
+        for (Int64 i = 0; i < ENTITY_COUNT; ++i)
+            entities.push_back(world.CreateEntity(Position {}, Velocity {}));
+        const Size stride = entities.size() / static_cast<Size>(state.range(0));
+
+        for (auto _: state)
+        {
+            state.PauseTiming();
+            const UInt64 since = world.AdvanceChangeTick();
+            for (Size i = 0; i < entities.size(); i += stride)
+                world.GetComponent<Position>(entities[i]).x += 1.0f;
+            state.ResumeTiming();
+
+            float sum = 0.0f;
+            for (auto chunk: world.Query<const Position&, Core::ECS::Changed<Position>>(since))
+            {
+                for (const Position& position: chunk.Get<Position>())
+                    sum += position.x;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+    }
+}
+
+BENCHMARK(BM_WorldEach)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_WorldQueryChunks)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_WorldRunSystems)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WorldAddRemoveComponent)->Arg(1 << 12);
+BENCHMARK(BM_WorldDeferredAddRemoveComponent)->Arg(1 << 12);
+BENCHMARK(BM_WorldCreateDestroy)->Arg(1 << 12);
+BENCHMARK(BM_WorldGetComponent)->Arg(1 << 16);
+BENCHMARK(BM_WorldChangedQuery)->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+#include <NGIN/Core/WorldSnapshot.hpp>
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace NGIN;
+
+namespace
+{
+    constexpr Int64 ENTITY_COUNT = 1 << 20;
+
+    struct Position
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 1.0f;
+        float y = 1.0f;
+        float z = 1.0f;
+    };
+
+    void Populate(Core::World& world)
+    {
+        for (Int64 i = 0; i < ENTITY_COUNT; ++i)
+            world.CreateEntity(Position {static_cast<float>(i)}, Velocity {});
+    }
+
+    const std::filesystem::path& GetSnapshotPath()
+    {
+        static const std::filesystem::path path = []
+        {
+            std::filesystem::path snapshot = std::filesystem::temp_directory_path() / "ngin_world_snapshot_bench.bin";
+            Core::World world;
+            Populate(world);
+            Core::WorldSnapshot::Save(world, snapshot.string());
+            return snapshot;
+        }();
+        return path;
+    }
+
+    void BM_Save(benchmark::State& state)
+    {
+        Core::World world;
+        Populate(world);
+        for (auto _: state)
+        {
+            std::ostringstream stream;
+            Core::WorldSnapshot::Save(world, stream);
+            benchmark::DoNotOptimize(stream.tellp());
+        }
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+    }
+
+    // Restoring from memory, every chunk copied into the world's allocator
+    void BM_Load(benchmark::State& state)
+    {
+        Core::World world;
+        Populate(world);
+        std::ostringstream stream;
+        Core::WorldSnapshot::Save(world, stream);
+        const std::string snapshot = stream.str();
+        const std::span data(reinterpret_cast<const std::byte*>(snapshot.data()), snapshot.size());
+
+        for (auto _: state)
+        {
+            Core::World restored;
+            Core::WorldSnapshot::Load(restored, data);
+            benchmark::DoNotOptimize(restored.GetEntityCount());
+        }
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+    }
+
+    // Restoring from the mapped file, the chunks adopted in place and only the entity table copied
+    void BM_Map(benchmark::State& state)
+    {
+        const std::string path = GetSnapshotPath().string();
+        for (auto _: state)
+        {
+            Core::World restored;
+            Core::WorldSnapshot::Map(restored, path);
+            benchmark::DoNotOptimize(restored.GetEntityCount());
+        }
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+    }
+
+    // Mapping and then integrating every position, the pages read and copied on first touch
+    void BM_MapAndTouch(benchmark::State& state)
+    {
+        const std::string path = GetSnapshotPath().string();
+        for (auto _: state)
+        {
+            Core::World restored;
+            Core::WorldSnapshot::Map(restored, path);
+            restored.Query<Position&, const Velocity&>().ForEach([](Position& position, const Velocity& velocity)
+                                                                 {
+                                                                     position.x += velocity.x * 0.016f;
+                                                                 });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+    }
+}
+
+BENCHMARK(BM_Save)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Load)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Map)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapAndTouch)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <NGIN/Util/Delegate.hpp>
+#include <vector>
+
+using namespace NGIN;
+
+namespace
+{
+    struct Counter
+    {
+        Int64 total = 0;
+
+        void Add(Int64 value)
+        {
+            total += value;
+        }
+    };
+
+    // Same broadcast through the vector-of-delegates pattern previously used by EventBus
+    void BM_VectorOfDynamicDelegates(benchmark::State& state)
+    {
+        std::vector<Counter> counters(static_cast<Size>(state.range(0)));
+        std::vector<DynamicDelegate> delegates;
+        for (auto& counter: counters)
+            delegates.emplace_back(&Counter::Add, &counter);
+
+        Int64 value = 1;
+        for (auto _: state)
+        {
+            for (auto& delegate: delegates)
+                delegate(value);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_VectorOfStaticDelegates(benchmark::State& state)
+    {
+        std::vector<Counter> counters(static_cast<Size>(state.range(0)));
+        std::vector<StaticDelegate<void(Int64)>> delegates;
+        for (auto& counter: counters)
+            delegates.emplace_back(&Counter::Add, &counter);
+
+        for (auto _: state)
+        {
+            for (auto& delegate: delegates)
+                delegate(1);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_MulticastDelegate(benchmark::State& state)
+    {
+        std::vector<Counter> counters(static_cast<Size>(state.range(0)));
+        MulticastDelegate<void(Int64)> delegate;
+        for (auto& counter: counters)
+            delegate.Add(&Counter::Add, &counter);
+
+        for (auto _: state)
+        {
+            delegate(1);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_MulticastDelegateAddRemove(benchmark::State& state)
+    {
+        std::vector<Counter> counters(static_cast<Size>(state.range(0)));
+        MulticastDelegate<void(Int64)> delegate;
+        std::vector<MulticastDelegate<void(Int64)>::Token> tokens(counters.size());
+
+        for (auto _: state)
+        {
+            for (Size i = 0; i < counters.size(); ++i)
+                tokens[i] = delegate.Add(&Counter::Add, &counters[i]);
+            for (auto& token: tokens)
+                delegate.Remove(token);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_VectorOfDynamicDelegates)->RangeMultiplier(8)->Range(8, 8 << 12);
+BENCHMARK(BM_VectorOfStaticDelegates)->RangeMultiplier(8)->Range(8, 8 << 12);
+BENCHMARK(BM_MulticastDelegate)->RangeMultiplier(8)->Range(8, 8 << 12);
+BENCHMARK(BM_MulticastDelegateAddRemove)->RangeMultiplier(8)->Range(8, 8 << 12);
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Time/Timer.hpp>
+#include "Task.hpp"
+
+#include <coroutine>
+#include <stdexcept>
+#include <vector>
+
+namespace NGIN::Async
+{
+    /// \class CoroutineScheduler
+    /// \brief Owns spawned tasks and resumes them at frame boundaries.
+    ///
+    /// Tasks suspended on NextFrame or Seconds are resumed from Update, which the engine calls once per
+    /// frame on the main thread. The scheduler is not thread-safe, tasks must only be spawned and awaited
+    /// on the thread calling Update.
+    class CoroutineScheduler
+    {
+    public:
+        CoroutineScheduler() = default;
+
+        /// \brief Destroys every unfinished task.
+        NGIN_API ~CoroutineScheduler();
+
+        CoroutineScheduler(const CoroutineScheduler&) = delete;
+
+        CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+        /// \brief Takes ownership of a task and runs it until its first suspension.
+        NGIN_API void Spawn(Task<void> task);
+
+        /// \brief Resumes the tasks waiting for the next frame and those whose wait time has elapsed,
+        /// then destroys finished tasks. Rethrows the first exception that escaped a spawned task.
+        NGIN_API void Update();
+
+        /// \brief Seconds elapsed since the scheduler was created, the clock Seconds waits on.
+        [[nodiscard]] NGIN_API F64 GetTime() const;
+
+        /// \brief Number of times Update has been called.
+        [[nodiscard]] NGIN_API UInt64 GetFrame() const noexcept;
+
+        /// \brief Number of spawned tasks that have not finished yet.
+        [[nodiscard]] NGIN_API Size GetTaskCount() const noexcept;
+
+        /// \brief Resumes a coroutine in the next Update.
+        NGIN_API void ResumeNextFrame(std::coroutine_handle<> handle);
+
+        /// \brief Resumes a coroutine in the first Update at or after the given time.
+        NGIN_API void ResumeAt(F64 time, std::coroutine_handle<> handle);
+
+    private:
+        struct TimedResume
+        {
+            F64 time;
+            std::coroutine_handle<> handle;
+        };
+
+        using RootHandle = std::coroutine_handle<Internal::TaskPromise<void>>;
+
+        std::vector<RootHandle> roots;
+        UInt32 finishedRootCount = 0;
+
+        /// \brief Resumed in the next Update, swapped with resuming so waits issued while resuming land in the frame after.
+        std::vector<std::coroutine_handle<>> nextFrame;
+        std::vector<std::coroutine_handle<>> resuming;
+        /// \brief Min-heap on time.
+        std::vector<TimedResume> timed;
+
+        Time::Timer timer;
+        UInt64 frame = 0;
+
+        void DestroyFinishedRoots();
+    };
+
+    /// \brief Awaitable suspending a task until the next frame.
+    struct NextFrameAwaiter
+    {
+        Bool await_ready() const noexcept
+        { return false; }
+
+        template<typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) const
+        {
+            CoroutineScheduler* scheduler = Internal::GetScheduler(handle);
+            if (scheduler == nullptr)
+                throw std::logic_error("NextFrame awaited by a task that was not spawned on a CoroutineScheduler.");
+            scheduler->ResumeNextFrame(handle);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /// \brief Awaitable suspending a task for a duration measured by the scheduler's timer.
+    struct SecondsAwaiter
+    {
+        F64 seconds;
+
+        Bool await_ready() const noexcept
+        { return seconds <= 0.0; }
+
+        template<typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) const
+        {
+            CoroutineScheduler* scheduler = Internal::GetScheduler(handle);
+            if (scheduler == nullptr)
+                throw std::logic_error("Seconds awaited by a task that was not spawned on a CoroutineScheduler.");
+            scheduler->ResumeAt(scheduler->GetTime() + seconds, handle);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /// \brief co_await NextFrame() resumes the task in the next frame.
+    [[nodiscard]] inline NextFrameAwaiter NextFrame() noexcept
+    {
+        return {};
+    }
+
+    /// \brief co_await Seconds(x) resumes the task in the first frame at least x seconds later.
+    [[nodiscard]] inline SecondsAwaiter Seconds(F64 seconds) noexcept
+    {
+        return {seconds};
+    }
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Util/Delegate/InplaceDelegate.hpp>
+#include "WorkStealingQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NGIN::Async
+{
+    class JobSystem;
+    class JobCounter;
+
+    /// \brief A job, a small callable run once by any thread of a JobSystem.
+    struct Job
+    {
+        /// \brief Inline capacity of a job callable, sized so a job fills one cache line.
+        static constexpr Size CAPACITY = sizeof(void*) * 4;
+
+        Util::MoveOnlyInplaceDelegate<void(), CAPACITY> function;
+        /// \brief Counter decremented once the job has run, may be null.
+        JobCounter* counter = nullptr;
+        /// \brief Thread the job must run on, or JobSystem::ANY_THREAD.
+        UInt32 affinity = std::numeric_limits<UInt32>::max();
+    };
+
+    /// \class JobCounter
+    /// \brief Counts unfinished jobs so a thread can wait on them or chain continuations after them.
+    ///
+    /// Every job spawned with a counter increments it and decrements it once it has run. When the counter
+    /// drops to zero its continuations are spawned. A counter may be reused once it has reached zero.
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        /// \brief Number of unfinished jobs.
+        [[nodiscard]] Int64 GetValue() const noexcept
+        { return value.load(std::memory_order_acquire); }
+
+        /// \brief True once every job has run and no thread is still finishing up with the counter.
+        [[nodiscard]] Bool IsDone() const noexcept
+        { return GetValue() == 0 && busy.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<Int64> value = 0;
+        /// \brief Threads currently completing a job of this counter. Keeps waiters from
+        /// destroying the counter while the last job is still spawning its continuations.
+        std::atomic<Int64> busy = 0;
+
+        std::mutex continuationMutex;
+        std::vector<Job*> continuations;
+    };
+
+    /// \class JobSystem
+    /// \brief A work-stealing job scheduler.
+    ///
+    /// Every thread of the system owns a lock-free Chase-Lev deque. Jobs spawned from a thread of the system
+    /// are pushed onto its own deque and popped LIFO, idle threads steal FIFO from the others. Jobs spawned
+    /// from outside the system go to a shared injection queue.
+    ///
+    /// Thread 0 is the thread that created the system, typically the main thread. It only runs jobs while it
+    /// waits on a counter, the other threads are workers. A job can be given an affinity to a single thread,
+    /// it then goes to that thread's inbox and is never stolen, e.g. for work that must run on the main thread.
+    ///
+    /// Waiting on a counter does not block: the waiting thread keeps running other jobs until the counter
+    /// reaches zero, so jobs may wait on jobs they spawned. Jobs must not throw.
+    class JobSystem
+    {
+    public:
+        /// \brief Affinity of jobs that may run on any thread.
+        static constexpr UInt32 ANY_THREAD = std::numeric_limits<UInt32>::max();
+        /// \brief Index of the thread that created the system.
+        static constexpr UInt32 MAIN_THREAD = 0;
+
+        /// \brief Starts the worker threads and registers the calling thread as thread 0.
+        /// \param workerCount Number of worker threads besides the calling thread.
+        NGIN_API explicit JobSystem(UInt32 workerCount = DefaultWorkerCount());
+
+        /// \brief Runs the remaining jobs and joins the worker threads.
+        NGIN_API ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /// \brief Spawns a job.
+        /// \param function Callable taking no arguments, at most Job::CAPACITY bytes.
+        /// \param counter Counter to increment now and decrement once the job has run, may be null.
+        /// \param affinity Thread index the job must run on, or ANY_THREAD.
+        template<typename F>
+        void Spawn(F&& function, JobCounter* counter = nullptr, UInt32 affinity = ANY_THREAD);
+
+        /// \brief Spawns a job once a counter reaches zero, immediately if it already has.
+        /// \param function Callable taking no arguments, at most Job::CAPACITY bytes.
+        /// \param waitCounter The counter to wait for.
+        /// \param next Counter of the continuation itself, incremented now, may be null.
+        /// \param affinity Thread index the job must run on, or ANY_THREAD.
+        template<typename F>
+        void ContinueWith(JobCounter& waitCounter, F&& function, JobCounter* next = nullptr, UInt32 affinity = ANY_THREAD);
+
+        /// \brief Runs other jobs on the calling thread until the counter reaches zero.
+        NGIN_API void Wait(JobCounter& counter);
+
+        /// \brief Runs a single job on the calling thread, if there is one.
+        /// \return True if a job was run.
+        NGIN_API Bool TryRunOne();
+
+        /// \brief Splits [0, count) into batches run as jobs and waits for all of them.
+        /// \param count Number of iterations.
+        /// \param batchSize Iterations per job, at least 1.
+        /// \param function Callable taking the begin and end index of a batch.
+        template<typename F>
+        void ParallelFor(Size count, Size batchSize, F&& function);
+
+        /// \brief Number of threads running jobs, the creating thread included.
+        [[nodiscard]] NGIN_API UInt32 GetThreadCount() const noexcept;
+
+        /// \brief Index of the calling thread in this system, or ANY_THREAD if it is not part of it.
+        [[nodiscard]] NGIN_API UInt32 GetCurrentThreadIndex() const noexcept;
+
+        /// \brief One less than the number of hardware threads, at least one.
+        [[nodiscard]] NGIN_API static UInt32 DefaultWorkerCount() noexcept;
+
+    private:
+        struct alignas(64) ThreadContext
+        {
+            WorkStealingQueue<Job> queue;
+
+            /// \brief Jobs with an affinity to this thread.
+            std::mutex inboxMutex;
+            std::deque<Job*> inbox;
+            std::atomic<Int64> inboxCount = 0;
+        };
+
+        std::vector<Scope<ThreadContext>> contexts;
+        std::vector<std::thread> workers;
+
+        /// \brief Jobs spawned from threads outside the system, or that did not fit a full deque.
+        std::mutex injectionMutex;
+        std::deque<Job*> injectionQueue;
+        std::atomic<Int64> injectionCount = 0;
+
+        /// \brief Jobs that any thread may pick up and that have not been picked up yet.
+        std::atomic<Int64> stealableCount = 0;
+        std::atomic<Bool> stop = false;
+
+        std::mutex sleepMutex;
+        std::condition_variable sleepCondition;
+        std::atomic<UInt32> sleepingCount = 0;
+
+        /// \brief Identifies this system in the per-thread job caches.
+        const UInt64 systemID;
+
+        /// \brief Blocks of jobs, freed jobs are recycled through per-thread caches and this free list.
+        std::mutex jobPoolMutex;
+        std::vector<Scope<Job[]>> jobBlocks;
+        std::vector<Job*> freeJobs;
+
+        NGIN_API Job* AllocateJob();
+
+        NGIN_API void FreeJob(Job* job);
+
+        NGIN_API void Schedule(Job* job);
+
+        /// \brief Finds a job the calling thread may run.
+        Job* FindJob(UInt32 threadIndex);
+
+        void Execute(Job* job);
+
+        void Complete(JobCounter& counter);
+
+        void WakeWorkers(Bool all);
+
+        void WorkerLoop(UInt32 index);
+    };
+
+
+    template<typename F>
+    void JobSystem::Spawn(F&& function, JobCounter* counter, UInt32 affinity)
+    {
+        Job* job = AllocateJob();
+        job->function = Util::MoveOnlyInplaceDelegate<void(), Job::CAPACITY>(std::forward<F>(function));
+        job->counter = counter;
+        job->affinity = affinity;
+        if (counter)
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+        Schedule(job);
+    }
+
+    template<typename F>
+    void JobSystem::ContinueWith(JobCounter& waitCounter, F&& function, JobCounter* next, UInt32 affinity)
+    {
+        Job* job = AllocateJob();
+        job->function = Util::MoveOnlyInplaceDelegate<void(), Job::CAPACITY>(std::forward<F>(function));
+        job->counter = next;
+        job->affinity = affinity;
+        if (next)
+            next->value.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            // Completion takes the same lock after the counter reached zero, so the job is either
+            // seen by it or the zero is seen here
+            std::lock_guard<std::mutex> lock(waitCounter.continuationMutex);
+            if (waitCounter.GetValue() != 0)
+            {
+                waitCounter.continuations.push_back(job);
+                return;
+            }
+        }
+        Schedule(job);
+    }
+
+    template<typename F>
+    void JobSystem::ParallelFor(Size count, Size batchSize, F&& function)
+    {
+        if (count == 0)
+            return;
+        if (batchSize == 0)
+            batchSize = 1;
+
+        JobCounter counter;
+        auto* callable = &function;
+        for (Size begin = 0; begin < count; begin += batchSize)
+        {
+            const Size end = begin + batchSize < count ? begin + batchSize : count;
+            Spawn([callable, begin, end]() { (*callable)(begin, end); }, &counter);
+        }
+        Wait(counter);
+    }
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace NGIN::Async
+{
+    class CoroutineScheduler;
+
+    template<typename T>
+    class Task;
+
+    namespace Internal
+    {
+        /// \brief Allocates a coroutine frame from the size-classed frame pools.
+        [[nodiscard]] NGIN_API void* AllocateCoroutineFrame(Size size);
+
+        /// \brief Returns a coroutine frame, size must be the size it was allocated with.
+        NGIN_API void DeallocateCoroutineFrame(void* ptr, Size size) noexcept;
+
+        /// \brief State shared by the promises of every Task.
+        struct TaskPromiseBase
+        {
+            /// \brief Scheduler that resumes the task after frame and time awaits, inherited from the awaiting task.
+            CoroutineScheduler* scheduler = nullptr;
+            /// \brief Coroutine awaiting this task, resumed once it finishes.
+            std::coroutine_handle<> continuation;
+            /// \brief Incremented once a root task finishes, so the scheduler only sweeps when needed.
+            UInt32* finishedCounter = nullptr;
+            std::exception_ptr exception;
+
+            static void* operator new(Size size)
+            {
+                return AllocateCoroutineFrame(size);
+            }
+
+            static void operator delete(void* ptr, Size size) noexcept
+            {
+                DeallocateCoroutineFrame(ptr, size);
+            }
+
+            struct FinalAwaiter
+            {
+                Bool await_ready() const noexcept
+                { return false; }
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                {
+                    TaskPromiseBase& promise = handle.promise();
+                    if (promise.finishedCounter)
+                        ++*promise.finishedCounter;
+                    if (promise.continuation)
+                        return promise.continuation;
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            /// \brief Tasks are lazy, they start when awaited or spawned on a scheduler.
+            std::suspend_always initial_suspend() const noexcept
+            { return {}; }
+
+            FinalAwaiter final_suspend() const noexcept
+            { return {}; }
+
+            void unhandled_exception() noexcept
+            { exception = std::current_exception(); }
+        };
+
+        template<typename T>
+        struct TaskPromise : TaskPromiseBase
+        {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template<typename U>
+            requires std::is_convertible_v<U&&, T>
+            void return_value(U&& result)
+            { value.emplace(std::forward<U>(result)); }
+
+            T GetResult()
+            {
+                if (exception)
+                    std::rethrow_exception(exception);
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct TaskPromise<void> : TaskPromiseBase
+        {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept {}
+
+            void GetResult() const
+            {
+                if (exception)
+                    std::rethrow_exception(exception);
+            }
+        };
+
+        /// \brief The scheduler of the coroutine awaiting a frame or time awaitable.
+        template<typename Promise>
+        CoroutineScheduler* GetScheduler(std::coroutine_handle<Promise> handle) noexcept
+        {
+            static_assert(std::is_base_of_v<TaskPromiseBase, Promise>, "Scheduler awaitables can only be awaited inside a Task.");
+            return handle.promise().scheduler;
+        }
+    }
+
+    /// \class Task
+    /// \brief A lazily started coroutine producing a value of type T.
+    ///
+    /// A task does not run until it is awaited by another coroutine or spawned on a CoroutineScheduler.
+    /// Awaiting a task transfers control to it directly and resumes the awaiting coroutine once it
+    /// finishes, exceptions thrown inside the task are rethrown from the co_await.
+    ///
+    /// Frames are allocated from pooled size classes instead of the global heap, so short-lived
+    /// per-frame coroutines do not churn the general purpose allocator.
+    /// \tparam T The result type, void for tasks without a result.
+    template<typename T = void>
+    class [[nodiscard]] Task
+    {
+    public:
+        using promise_type = Internal::TaskPromise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Task() = default;
+
+        explicit Task(Handle handle) noexcept
+                : handle(handle)
+        {}
+
+        Task(Task&& other) noexcept
+                : handle(std::exchange(other.handle, nullptr))
+        {}
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle)
+                    handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+
+        Task& operator=(const Task&) = delete;
+
+        ~Task()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+        /// \brief True if the task has run to completion.
+        [[nodiscard]] Bool IsDone() const noexcept
+        { return !handle || handle.done(); }
+
+        [[nodiscard]] Bool IsValid() const noexcept
+        { return static_cast<Bool>(handle); }
+
+        /// \brief Gives up ownership of the coroutine frame.
+        [[nodiscard]] Handle Release() noexcept
+        { return std::exchange(handle, nullptr); }
+
+        struct Awaiter
+        {
+            Handle handle;
+
+            Bool await_ready() const noexcept
+            { return !handle || handle.done(); }
+
+            /// \brief Starts the task and resumes the awaiting coroutine once it finishes.
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                if constexpr (std::is_base_of_v<Internal::TaskPromiseBase, Promise>)
+                    handle.promise().scheduler = awaiting.promise().scheduler;
+                return handle;
+            }
+
+            T await_resume()
+            { return handle.promise().GetResult(); }
+        };
+
+        Awaiter operator co_await() const noexcept
+        { return Awaiter {handle}; }
+
+    private:
+        Handle handle = nullptr;
+    };
+
+    namespace Internal
+    {
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept
+        {
+            return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept
+        {
+            return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+        }
+    }
+}
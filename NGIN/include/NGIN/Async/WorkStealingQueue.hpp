@@ -0,0 +1,103 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+
+#include <atomic>
+
+namespace NGIN::Async
+{
+    /// \class WorkStealingQueue
+    /// \brief A fixed-capacity Chase-Lev work-stealing deque of pointers.
+    ///
+    /// The owning thread pushes and pops at the bottom without locks, other threads steal from the top
+    /// with a single compare-and-swap. Only the owner may call Push and Pop, any thread may call Steal.
+    /// Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+    /// \tparam T Type of the pointed-to elements.
+    /// \tparam Capacity Maximum number of elements, must be a power of two.
+    template<typename T, Size Capacity = 4096>
+    class WorkStealingQueue
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "WorkStealingQueue capacity must be a power of two.");
+
+    public:
+        WorkStealingQueue() = default;
+
+        WorkStealingQueue(const WorkStealingQueue&) = delete;
+
+        WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+        /// \brief Pushes an element at the bottom. Owner only.
+        /// \return False if the queue is full.
+        Bool Push(T* item) noexcept
+        {
+            const Int64 b = bottom.load(std::memory_order_relaxed);
+            const Int64 t = top.load(std::memory_order_acquire);
+            if (b - t >= static_cast<Int64>(Capacity))
+                return false;
+
+            buffer[b & MASK].store(item, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// \brief Pops the most recently pushed element. Owner only.
+        /// \return The element, or nullptr if the queue is empty or the last element was stolen.
+        T* Pop() noexcept
+        {
+            const Int64 b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_seq_cst);
+            Int64 t = top.load(std::memory_order_seq_cst);
+
+            if (t > b)
+            {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = buffer[b & MASK].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // Last element, race against thieves for it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        /// \brief Steals the least recently pushed element. Any thread.
+        /// \return The element, or nullptr if the queue is empty or another thread won the race.
+        T* Steal() noexcept
+        {
+            Int64 t = top.load(std::memory_order_seq_cst);
+            const Int64 b = bottom.load(std::memory_order_seq_cst);
+            if (t >= b)
+                return nullptr;
+
+            T* item = buffer[t & MASK].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return item;
+        }
+
+        /// \brief Approximate number of elements, exact only when called by the owner without concurrent thieves.
+        [[nodiscard]] Size GetSize() const noexcept
+        {
+            const Int64 b = bottom.load(std::memory_order_relaxed);
+            const Int64 t = top.load(std::memory_order_relaxed);
+            return b > t ? static_cast<Size>(b - t) : 0;
+        }
+
+        [[nodiscard]] Bool IsEmpty() const noexcept
+        {
+            return GetSize() == 0;
+        }
+
+    private:
+        static constexpr Int64 MASK = static_cast<Int64>(Capacity) - 1;
+
+        alignas(64) std::atomic<Int64> top = 0;
+        alignas(64) std::atomic<Int64> bottom = 0;
+        alignas(64) std::atomic<T*> buffer[Capacity] {};
+    };
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Meta/TypeMap.hpp>
+#include "Chunk.hpp"
+#include "Component.hpp"
+#include "Entity.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace NGIN::Core::ECS
+{
+    /// \class Archetype
+    /// \brief Storage of every entity that has exactly one particular set of component types.
+    ///
+    /// Entities are stored in fixed-size chunks in structure-of-arrays layout: a chunk starts with a
+    /// header of change ticks, followed by the entity column and one contiguous column per component
+    /// type, sorted by component ID.
+    /// Chunks are kept dense, only the last chunk may be partially filled, so removing a row moves the
+    /// last row of the archetype into the hole.
+    ///
+    /// The header holds two ticks per column, the last tick the column was accessed mutably and the last
+    /// tick a component was added to a row of the chunk. Change detection works on whole chunks, a chunk
+    /// whose tick is not newer than the last run of a query is skipped without touching its rows.
+    ///
+    /// Transitions to the archetypes with one component added or removed are cached on the archetype,
+    /// so repeated structural changes of the same kind skip the signature lookup.
+    class Archetype
+    {
+    public:
+        static constexpr UInt32 INVALID_COLUMN = std::numeric_limits<UInt32>::max();
+        static constexpr UInt32 INVALID_ARCHETYPE = std::numeric_limits<UInt32>::max();
+
+        struct Column
+        {
+            const ComponentInfo* info;
+            /// \brief Byte offset of the column from the start of the chunk.
+            Size offset;
+        };
+
+        /// \brief Location of an entity's row inside the archetype.
+        struct Location
+        {
+            UInt32 chunk;
+            UInt32 row;
+        };
+
+        /// \brief Creates the archetype of a set of component types.
+        /// \param components Descriptions of the component types, sorted by ID without duplicates.
+        /// \param allocator Allocator the chunks are taken from, must outlive the archetype.
+        /// \throws std::invalid_argument if a component is aligned stricter than CHUNK_ALIGNMENT.
+        /// \throws std::length_error if a single row does not fit a chunk.
+        NGIN_API Archetype(std::vector<const ComponentInfo*> components, ChunkAllocator& allocator);
+
+        /// \brief Destroys every stored component and returns the chunks.
+        NGIN_API ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+
+        Archetype& operator=(const Archetype&) = delete;
+
+        /// \brief Component IDs of the archetype in ascending order.
+        [[nodiscard]] std::span<const Meta::TypeIDType> GetSignature() const noexcept
+        { return signature; }
+
+        [[nodiscard]] std::span<const Column> GetColumns() const noexcept
+        { return columns; }
+
+        /// \brief Index of the column storing a component type, INVALID_COLUMN if the archetype lacks it.
+        [[nodiscard]] NGIN_API UInt32 FindColumn(Meta::TypeIDType id) const noexcept;
+
+        [[nodiscard]] Bool Has(Meta::TypeIDType id) const noexcept
+        { return FindColumn(id) != INVALID_COLUMN; }
+
+        /// \brief Maximum number of rows per chunk.
+        [[nodiscard]] UInt32 GetChunkCapacity() const noexcept
+        { return chunkCapacity; }
+
+        [[nodiscard]] Size GetChunkCount() const noexcept
+        { return chunks.size(); }
+
+        [[nodiscard]] const Chunk& GetChunk(Size chunkIndex) const noexcept
+        { return chunks[chunkIndex]; }
+
+        /// \brief Number of entities stored in the archetype.
+        [[nodiscard]] NGIN_API Size GetEntityCount() const noexcept;
+
+        /// \brief The entity column of a chunk.
+        [[nodiscard]] Entity* GetEntities(Size chunkIndex) const noexcept
+        { return reinterpret_cast<Entity*>(chunks[chunkIndex].memory + entitiesOffset); }
+
+        /// \brief Start of a component column in a chunk.
+        [[nodiscard]] std::byte* GetColumnData(UInt32 columnIndex, Size chunkIndex) const noexcept
+        { return chunks[chunkIndex].memory + columns[columnIndex].offset; }
+
+        /// \brief Typed start of a component column in a chunk.
+        template<typename T>
+        [[nodiscard]] T* GetColumnData(UInt32 columnIndex, Size chunkIndex) const noexcept
+        { return reinterpret_cast<T*>(GetColumnData(columnIndex, chunkIndex)); }
+
+        /// \brief Address of one component of one row.
+        [[nodiscard]] std::byte* GetComponent(UInt32 columnIndex, Location location) const noexcept
+        { return GetColumnData(columnIndex, location.chunk) + location.row * columns[columnIndex].info->size; }
+
+        /// \brief Per column of a chunk, the latest tick at which the column was accessed mutably.
+        [[nodiscard]] UInt64* GetChangedTicks(Size chunkIndex) const noexcept
+        { return reinterpret_cast<UInt64*>(chunks[chunkIndex].memory); }
+
+        /// \brief Per column of a chunk, the latest tick at which a component was added to one of its rows.
+        [[nodiscard]] UInt64* GetAddedTicks(Size chunkIndex) const noexcept
+        { return GetChangedTicks(chunkIndex) + columns.size(); }
+
+        /// \brief Records a mutable access to a column of a chunk.
+        void MarkChanged(UInt32 columnIndex, Size chunkIndex, UInt64 tick) const noexcept
+        {
+            UInt64& changed = GetChangedTicks(chunkIndex)[columnIndex];
+            changed = std::max(changed, tick);
+        }
+
+        /// \brief Records that a component was added to a row of a chunk, which also counts as a change.
+        void MarkAdded(UInt32 columnIndex, Size chunkIndex, UInt64 tick) const noexcept
+        {
+            MergeTicks(columnIndex, chunkIndex, tick, tick);
+        }
+
+        /// \brief Raises the ticks of a column of a chunk to at least the given ones, used when a row
+        /// carrying changes moves into the chunk.
+        void MergeTicks(UInt32 columnIndex, Size chunkIndex, UInt64 changedTick, UInt64 addedTick) const noexcept
+        {
+            MarkChanged(columnIndex, chunkIndex, changedTick);
+            UInt64& added = GetAddedTicks(chunkIndex)[columnIndex];
+            added = std::max(added, addedTick);
+        }
+
+        /// \brief Appends a row for an entity, its components are left uninitialized for the caller to construct.
+        NGIN_API Location AllocateRow(Entity entity);
+
+        /// \brief Appends a chunk whose tick header, entity column and rows [0, count) are already
+        /// initialized, like a chunk restored from a snapshot. The memory must come from the archetype's
+        /// allocator and is returned to it.
+        /// \throws std::invalid_argument if count is zero or exceeds the chunk capacity, or the last chunk is not full.
+        NGIN_API void AdoptChunk(std::byte* memory, UInt32 count);
+
+        /// \brief Removes a row by moving the last row of the archetype into it. The ticks of the moved row's
+        /// chunk are merged into the ticks of the row's chunk, so its changes stay visible.
+        /// \param location Row to remove.
+        /// \param destroyComponents Whether the components of the row are still alive and must be destroyed,
+        /// false if the caller already moved or destroyed them.
+        /// \return The entity that was moved into the row, or an invalid entity if the removed row was the last.
+        NGIN_API Entity RemoveRow(Location location, Bool destroyComponents);
+
+        /// \brief Cached archetype index reached by adding a component, INVALID_ARCHETYPE if not cached yet.
+        [[nodiscard]] UInt32 GetAddEdge(Meta::TypeIDType id) const noexcept
+        {
+            const UInt32* edge = addEdges.Find(id);
+            return edge ? *edge : INVALID_ARCHETYPE;
+        }
+
+        /// \brief Cached archetype index reached by removing a component, INVALID_ARCHETYPE if not cached yet.
+        [[nodiscard]] UInt32 GetRemoveEdge(Meta::TypeIDType id) const noexcept
+        {
+            const UInt32* edge = removeEdges.Find(id);
+            return edge ? *edge : INVALID_ARCHETYPE;
+        }
+
+        void SetAddEdge(Meta::TypeIDType id, UInt32 archetypeIndex)
+        { addEdges.Insert(id, archetypeIndex); }
+
+        void SetRemoveEdge(Meta::TypeIDType id, UInt32 archetypeIndex)
+        { removeEdges.Insert(id, archetypeIndex); }
+
+    private:
+        std::vector<Meta::TypeIDType> signature;
+        std::vector<Column> columns;
+        std::vector<Chunk> chunks;
+        UInt32 chunkCapacity = 0;
+        /// \brief Byte offset of the entity column, after the tick header.
+        Size entitiesOffset = 0;
+        ChunkAllocator* allocator;
+
+        Meta::TypeMap<UInt32> addEdges;
+        Meta::TypeMap<UInt32> removeEdges;
+
+        void DestroyRows(Size chunkIndex, UInt32 begin, UInt32 end) noexcept;
+    };
+
+    /// \brief Slot of a world's entity table, indexed by the entity index.
+    struct EntityRecord
+    {
+        /// \brief Archetype of the entity, INVALID_ARCHETYPE while the slot is free.
+        UInt32 archetype = Archetype::INVALID_ARCHETYPE;
+        /// \brief Generation of the entity in the slot, bumped when it is destroyed.
+        UInt32 generation = 0;
+
+        union
+        {
+            /// \brief Row of the entity while the slot is in use.
+            Archetype::Location location = {};
+            /// \brief Next free slot while the slot is free.
+            UInt32 nextFree;
+        };
+    };
+}
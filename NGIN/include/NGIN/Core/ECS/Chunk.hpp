@@ -0,0 +1,76 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Memory/PoolAllocator.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace NGIN::Core::ECS
+{
+    /// \brief Size of the memory block of a chunk.
+    inline constexpr Size CHUNK_SIZE = 16 * 1024;
+    /// \brief Alignment of chunk memory, columns start on cache lines.
+    inline constexpr Size CHUNK_ALIGNMENT = 64;
+
+    /// \brief A block of CHUNK_SIZE bytes holding the components of up to capacity entities of one
+    /// archetype, one contiguous column per component type.
+    struct Chunk
+    {
+        std::byte* memory = nullptr;
+        /// \brief Number of occupied rows, rows [0, count) are live.
+        UInt32 count = 0;
+    };
+
+    /// \class ChunkAllocator
+    /// \brief Hands out chunk memory from pages of pooled blocks.
+    ///
+    /// Every page is a PoolAllocator of CHUNKS_PER_PAGE chunks, a new page is added when all are in use.
+    /// Pages are kept for reuse once their chunks are freed.
+    ///
+    /// Chunks placed in memory the allocator does not own, like a mapped snapshot file, can be adopted
+    /// as allocated. Once freed they are reused before new pages are added, and the memory is released
+    /// with the allocator.
+    class ChunkAllocator
+    {
+    public:
+        static constexpr Size CHUNKS_PER_PAGE = 64;
+
+        ChunkAllocator() = default;
+
+        ChunkAllocator(const ChunkAllocator&) = delete;
+
+        ChunkAllocator& operator=(const ChunkAllocator&) = delete;
+
+        /// \brief Allocates the memory of one chunk.
+        NGIN_API std::byte* Allocate();
+
+        /// \brief Returns the memory of a chunk.
+        NGIN_API void Deallocate(std::byte* memory);
+
+        /// \brief Takes count back to back chunks of external memory, all counted as allocated.
+        /// \param memory Start of the chunks, aligned to CHUNK_ALIGNMENT.
+        /// \param owner Keeps the memory alive until the allocator is destroyed.
+        /// \throws std::invalid_argument if memory is misaligned.
+        NGIN_API void AdoptChunks(std::byte* memory, Size count, std::shared_ptr<void> owner);
+
+        /// \brief Number of chunks currently allocated.
+        [[nodiscard]] NGIN_API Size GetAllocatedCount() const noexcept;
+
+    private:
+        struct ExternalChunks
+        {
+            std::byte* memory;
+            Size count;
+            std::shared_ptr<void> owner;
+            /// \brief Chunks of the range that were freed.
+            std::vector<std::byte*> freeChunks;
+        };
+
+        std::vector<Scope<Memory::PoolAllocator>> pages;
+        std::vector<ExternalChunks> externalChunks;
+        /// \brief Page that served the last allocation, checked first.
+        Size currentPage = 0;
+        Size allocatedCount = 0;
+    };
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Memory/LinearAllocator.hpp>
+#include "Component.hpp"
+#include "Entity.hpp"
+
+#include <algorithm>
+#include <array>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace NGIN::Core::ECS
+{
+    /// \class CommandBuffer
+    /// \brief Records structural changes to apply to a World later, at a sync point.
+    ///
+    /// Component values are constructed into a linear arena when recorded, and moved into the world on
+    /// playback. The arena and the command list keep their memory between frames, so recording
+    /// usually does not allocate. A buffer is used by one thread at a time, World::GetCommandBuffer
+    /// hands every thread its own buffer, so recording never locks.
+    class CommandBuffer
+    {
+    public:
+        enum class CommandType : UInt8
+        {
+            Create,
+            Destroy,
+            Add,
+            Remove,
+        };
+
+        /// \brief A component value stored in the arena.
+        struct ComponentValue
+        {
+            const ComponentInfo* info;
+            /// \brief The value, null once moved out or destroyed.
+            void* value;
+        };
+
+        struct Command
+        {
+            CommandType type;
+            /// \brief Number of components of a Create command.
+            UInt32 componentCount;
+            Entity entity;
+            /// \brief The component of an Add or Remove command, the first of componentCount for Create.
+            ComponentValue* components;
+            /// \brief ID of the removed component.
+            Meta::TypeIDType id;
+        };
+
+        /// \brief Size of an arena block, larger values get a block of their own.
+        static constexpr Size BLOCK_SIZE = 64 * 1024;
+
+        CommandBuffer() = default;
+
+        CommandBuffer(const CommandBuffer&) = delete;
+
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /// \brief Destroys the component values of commands that were not played back.
+        NGIN_API ~CommandBuffer();
+
+        /// \brief Records creating an entity with the given components.
+        template<IsComponent... Ts>
+        void CreateEntity(Ts... components)
+        {
+            static_assert(AreDistinctComponents<Ts...>(), "CreateEntity requires distinct component types.");
+
+            auto* values = static_cast<ComponentValue*>(Allocate(sizeof(ComponentValue) * sizeof...(Ts), alignof(ComponentValue)));
+            // The command is recorded first and counts the values constructed so far, so a throwing
+            // constructor only has to destroy those
+            Command& command = commands.emplace_back(Command {CommandType::Create, 0, Entity {}, values, 0});
+            try
+            {
+                ([&]
+                 {
+                     Ts* value = ::new(Allocate(sizeof(Ts), alignof(Ts))) Ts(std::move(components));
+                     values[command.componentCount] = {&GetComponentInfo<Ts>(), value};
+                     ++command.componentCount;
+                 }(), ...);
+            } catch (...)
+            {
+                DropLastCommand();
+                throw;
+            }
+        }
+
+        /// \brief Records destroying an entity.
+        void DestroyEntity(Entity entity)
+        {
+            commands.push_back({CommandType::Destroy, 0, entity, nullptr, 0});
+        }
+
+        /// \brief Records adding a component, replacing it if the entity has it by then.
+        template<IsComponent T, typename... Args>
+        void AddComponent(Entity entity, Args&& ... args)
+        {
+            auto* value = static_cast<ComponentValue*>(Allocate(sizeof(ComponentValue), alignof(ComponentValue)));
+            *value = {&GetComponentInfo<T>(), nullptr};
+            Command& command = commands.emplace_back(Command {CommandType::Add, 0, entity, value,
+                                                              GetComponentInfo<T>().id});
+            try
+            {
+                value->value = ::new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+                command.componentCount = 1;
+            } catch (...)
+            {
+                DropLastCommand();
+                throw;
+            }
+        }
+
+        /// \brief Records removing a component.
+        template<IsComponent T>
+        void RemoveComponent(Entity entity)
+        {
+            commands.push_back({CommandType::Remove, 0, entity, nullptr, ComponentID<T>()});
+        }
+
+        /// \brief The recorded commands in recording order.
+        [[nodiscard]] std::vector<Command>& GetCommands() noexcept
+        { return commands; }
+
+        [[nodiscard]] Size GetCommandCount() const noexcept
+        { return commands.size(); }
+
+        [[nodiscard]] Bool IsEmpty() const noexcept
+        { return commands.empty(); }
+
+        /// \brief Drops every command, destroying the component values not moved out, and rewinds the arena.
+        NGIN_API void Clear();
+
+    private:
+        std::vector<Memory::LinearAllocator> blocks;
+        Size currentBlock = 0;
+        std::vector<Command> commands;
+
+        NGIN_API void* Allocate(Size size, Size alignment);
+
+        /// \brief Destroys the component values of the last command and drops it, for a command whose
+        /// recording threw.
+        NGIN_API void DropLastCommand() noexcept;
+    };
+}
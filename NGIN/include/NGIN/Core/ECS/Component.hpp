@@ -0,0 +1,142 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Meta/TypeID.hpp>
+#include <NGIN/Meta/TypeName.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace NGIN::Core::ECS
+{
+    /// \brief Types that can be stored as components: plain object types that can be moved between chunks.
+    template<typename T>
+    concept IsComponent = std::is_object_v<T> && !std::is_const_v<T> && !std::is_array_v<T>
+                          && std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>;
+
+    /// \brief Where the components of a type are stored.
+    enum class ComponentStorage : UInt8
+    {
+        /// \brief In the chunk columns of the entity's archetype, the fastest to iterate. Adding or removing
+        /// the component moves the entity to another archetype.
+        Table,
+        /// \brief In a sparse set beside the archetypes, for components added and removed often like tags.
+        /// Adding or removing the component leaves the entity in its archetype.
+        SparseSet,
+    };
+
+    /// \brief The storage of a component type, the value of its static STORAGE member if it declares one:
+    /// \code
+    /// struct Stunned
+    /// {
+    ///     static constexpr ECS::ComponentStorage STORAGE = ECS::ComponentStorage::SparseSet;
+    /// };
+    /// \endcode
+    /// Specialize it for types that cannot declare the member.
+    template<typename T>
+    inline constexpr ComponentStorage COMPONENT_STORAGE = []
+    {
+        if constexpr (requires { { T::STORAGE } -> std::convertible_to<ComponentStorage>; })
+            return static_cast<ComponentStorage>(T::STORAGE);
+        else
+            return ComponentStorage::Table;
+    }();
+
+    /// \brief Type-erased description of a component type, enough to store it in a chunk column.
+    struct ComponentInfo
+    {
+        Meta::TypeIDType id = 0;
+        StringView name;
+        Size size = 0;
+        Size alignment = 0;
+        /// \brief Move-constructs dst from src and destroys src.
+        void (* relocate)(void* dst, void* src) noexcept = nullptr;
+        void (* destroy)(void* ptr) noexcept = nullptr;
+        /// \brief True if relocating is a memcpy and destroying is a no-op.
+        Bool trivial = false;
+        ComponentStorage storage = ComponentStorage::Table;
+    };
+
+    namespace Internal
+    {
+        template<typename T>
+        void Relocate(void* dst, void* src) noexcept
+        {
+            T* source = static_cast<T*>(src);
+            ::new(dst) T(std::move(*source));
+            source->~T();
+        }
+
+        template<typename T>
+        void Destroy(void* ptr) noexcept
+        {
+            static_cast<T*>(ptr)->~T();
+        }
+
+        template<typename T>
+        inline constexpr ComponentInfo COMPONENT_INFO = {
+                Meta::TypeID<T>(),
+                Meta::TypeName<T>::Full(),
+                sizeof(T),
+                alignof(T),
+                &Relocate<T>,
+                &Destroy<T>,
+                std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                COMPONENT_STORAGE<T>};
+    }
+
+    /// \brief The description of a component type, one static instance per type.
+    template<IsComponent T>
+    [[nodiscard]] constexpr const ComponentInfo& GetComponentInfo() noexcept
+    {
+        return Internal::COMPONENT_INFO<T>;
+    }
+
+    /// \brief Makes a component type known to FindComponentInfo. Worlds register the types they store,
+    /// a process restoring a snapshot registers those it has not stored yet.
+    NGIN_API void RegisterComponent(const ComponentInfo& info);
+
+    template<IsComponent T>
+    void RegisterComponent()
+    {
+        RegisterComponent(GetComponentInfo<T>());
+    }
+
+    /// \brief The description of a registered component type, nullptr if it was never registered.
+    [[nodiscard]] NGIN_API const ComponentInfo* FindComponentInfo(Meta::TypeIDType id);
+
+    /// \brief The component ID of a possibly cv- or reference-qualified component type.
+    template<typename T>
+    [[nodiscard]] constexpr Meta::TypeIDType ComponentID() noexcept
+    {
+        return Meta::TypeID<std::remove_cvref_t<T>>();
+    }
+
+    /// \brief True if no two of the component types Ts are the same once unqualified.
+    template<typename... Ts>
+    [[nodiscard]] constexpr Bool AreDistinctComponents() noexcept
+    {
+        constexpr std::array<Meta::TypeIDType, sizeof...(Ts)> ids = {ComponentID<Ts>()...};
+        for (Size i = 0; i < ids.size(); ++i)
+            for (Size j = i + 1; j < ids.size(); ++j)
+                if (ids[i] == ids[j])
+                    return false;
+        return true;
+    }
+
+    /// \brief Moves count components described by info from src to dst, dst being uninitialized.
+    inline void RelocateComponents(const ComponentInfo& info, std::byte* dst, std::byte* src, Size count) noexcept
+    {
+        if (info.trivial)
+        {
+            std::memcpy(dst, src, info.size * count);
+            return;
+        }
+        for (Size i = 0; i < count; ++i)
+            info.relocate(dst + i * info.size, src + i * info.size);
+    }
+}
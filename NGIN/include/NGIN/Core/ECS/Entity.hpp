@@ -0,0 +1,45 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+
+#include <functional>
+#include <limits>
+
+namespace NGIN::Core::ECS
+{
+    /// \brief Handle of an entity in a World.
+    ///
+    /// Packs the index of the entity's slot in the world's entity table in the low 32 bits and the
+    /// generation of the slot in the high 32 bits. Slots are recycled with a bumped generation, so a
+    /// handle to a destroyed entity never refers to an entity created later in the same slot.
+    struct Entity
+    {
+        static constexpr UInt32 INVALID_INDEX = std::numeric_limits<UInt32>::max();
+        static constexpr UInt64 INVALID_VALUE = std::numeric_limits<UInt64>::max();
+
+        UInt64 value = INVALID_VALUE;
+
+        [[nodiscard]] static constexpr Entity FromParts(UInt32 index, UInt32 generation) noexcept
+        { return {static_cast<UInt64>(generation) << 32 | index}; }
+
+        [[nodiscard]] constexpr UInt32 GetIndex() const noexcept
+        { return static_cast<UInt32>(value); }
+
+        [[nodiscard]] constexpr UInt32 GetGeneration() const noexcept
+        { return static_cast<UInt32>(value >> 32); }
+
+        [[nodiscard]] constexpr Bool IsValid() const noexcept
+        { return GetIndex() != INVALID_INDEX; }
+
+        constexpr Bool operator==(const Entity&) const noexcept = default;
+    };
+}
+
+template<>
+struct std::hash<NGIN::Core::ECS::Entity>
+{
+    NGIN::Size operator()(const NGIN::Core::ECS::Entity& entity) const noexcept
+    {
+        return std::hash<NGIN::UInt64> {}(entity.value);
+    }
+};
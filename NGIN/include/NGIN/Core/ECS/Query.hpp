@@ -0,0 +1,814 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include "Archetype.hpp"
+#include "Component.hpp"
+#include "Entity.hpp"
+#include "SparseSet.hpp"
+
+#include <array>
+#include <limits>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace NGIN::Core::ECS
+{
+    /// \brief Query term matching entities that have component T, without fetching it.
+    template<IsComponent T>
+    struct With
+    {
+    };
+
+    /// \brief Query term matching entities that do not have component T.
+    template<IsComponent T>
+    struct Without
+    {
+    };
+
+    /// \brief Query filter matching the chunks whose component T was accessed mutably since the query's
+    /// last run, or added to one of their rows. Requires T, which counts as read.
+    ///
+    /// Changes are tracked per chunk and column, so a matched chunk may contain unchanged rows. Only
+    /// components stored in archetype tables are tracked.
+    template<IsComponent T>
+    struct Changed
+    {
+    };
+
+    /// \brief Query filter matching the chunks where component T was added to a row since the query's
+    /// last run, including entities created with it. Requires T, which counts as read.
+    template<IsComponent T>
+    struct Added
+    {
+    };
+
+    /// \brief How a query term accesses component data.
+    enum class ComponentAccess
+    {
+        None,
+        Read,
+        Write,
+    };
+
+    namespace Internal
+    {
+        template<typename... Ts>
+        struct TypeList
+        {
+        };
+
+        template<typename... Lists>
+        struct Concat;
+
+        template<>
+        struct Concat<>
+        {
+            using Type = TypeList<>;
+        };
+
+        template<typename... Ts>
+        struct Concat<TypeList<Ts...>>
+        {
+            using Type = TypeList<Ts...>;
+        };
+
+        template<typename... As, typename... Bs, typename... Rest>
+        struct Concat<TypeList<As...>, TypeList<Bs...>, Rest...>
+        {
+            using Type = typename Concat<TypeList<As..., Bs...>, Rest...>::Type;
+        };
+
+        enum class TermKind
+        {
+            /// \brief Required and fetched.
+            Fetch,
+            /// \brief Required, not fetched.
+            With,
+            /// \brief Excluded.
+            Without,
+            /// \brief Required, chunks are filtered by their changed tick.
+            Changed,
+            /// \brief Required, chunks are filtered by their added tick.
+            Added,
+        };
+
+        /// \brief Compile-time description of one query term. Plain component terms are fetched,
+        /// T& for write access and const T& for read access.
+        template<typename T>
+        struct QueryTerm
+        {
+            using Component = std::remove_cvref_t<T>;
+            static_assert(IsComponent<Component>, "Query terms must be components, or filters like With and Without.");
+
+            using Fetched = TypeList<T>;
+            static constexpr TermKind KIND = TermKind::Fetch;
+            static constexpr ComponentAccess ACCESS = std::is_const_v<std::remove_reference_t<T>>
+                                                      ? ComponentAccess::Read : ComponentAccess::Write;
+            static constexpr ComponentStorage STORAGE = COMPONENT_STORAGE<Component>;
+        };
+
+        template<typename T>
+        struct QueryTerm<With<T>>
+        {
+            using Component = T;
+            using Fetched = TypeList<>;
+            static constexpr TermKind KIND = TermKind::With;
+            static constexpr ComponentAccess ACCESS = ComponentAccess::None;
+            static constexpr ComponentStorage STORAGE = COMPONENT_STORAGE<T>;
+        };
+
+        template<typename T>
+        struct QueryTerm<Without<T>>
+        {
+            using Component = T;
+            using Fetched = TypeList<>;
+            static constexpr TermKind KIND = TermKind::Without;
+            static constexpr ComponentAccess ACCESS = ComponentAccess::None;
+            static constexpr ComponentStorage STORAGE = COMPONENT_STORAGE<T>;
+        };
+
+        template<typename T>
+        struct QueryTerm<Changed<T>>
+        {
+            static_assert(COMPONENT_STORAGE<T> == ComponentStorage::Table, "Changed<T> requires a component stored in tables.");
+
+            using Component = T;
+            using Fetched = TypeList<>;
+            static constexpr TermKind KIND = TermKind::Changed;
+            static constexpr ComponentAccess ACCESS = ComponentAccess::Read;
+            static constexpr ComponentStorage STORAGE = ComponentStorage::Table;
+        };
+
+        template<typename T>
+        struct QueryTerm<Added<T>>
+        {
+            static_assert(COMPONENT_STORAGE<T> == ComponentStorage::Table, "Added<T> requires a component stored in tables.");
+
+            using Component = T;
+            using Fetched = TypeList<>;
+            static constexpr TermKind KIND = TermKind::Added;
+            static constexpr ComponentAccess ACCESS = ComponentAccess::Read;
+            static constexpr ComponentStorage STORAGE = ComponentStorage::Table;
+        };
+
+        /// \brief The fetched terms read from chunk columns.
+        template<typename T>
+        using ChunkFetched = std::conditional_t<QueryTerm<T>::STORAGE == ComponentStorage::Table,
+                                                typename QueryTerm<T>::Fetched, TypeList<>>;
+
+        using TermPredicate = Bool (*)(TermKind, ComponentAccess, ComponentStorage);
+
+        /// \brief IDs of the components of the terms accepted by Predicate, in term order.
+        template<TermPredicate Predicate, typename... Terms>
+        consteval auto CollectTermIDs()
+        {
+            constexpr Size count = ((Predicate(QueryTerm<Terms>::KIND, QueryTerm<Terms>::ACCESS, QueryTerm<Terms>::STORAGE) ? 1 : 0) + ... + 0);
+            std::array<Meta::TypeIDType, count> ids = {};
+            Size i = 0;
+            ((Predicate(QueryTerm<Terms>::KIND, QueryTerm<Terms>::ACCESS, QueryTerm<Terms>::STORAGE)
+              ? (void) (ids[i++] = Meta::TypeID<typename QueryTerm<Terms>::Component>()) : (void) 0), ...);
+            return ids;
+        }
+
+        /// \brief Per fetched chunk column, whether it is fetched for writing, in term order.
+        template<typename... Terms>
+        consteval auto CollectFetchedWrites()
+        {
+            constexpr auto isColumn = [](TermKind kind, ComponentStorage storage)
+            { return kind == TermKind::Fetch && storage == ComponentStorage::Table; };
+            constexpr Size count = ((isColumn(QueryTerm<Terms>::KIND, QueryTerm<Terms>::STORAGE) ? 1 : 0) + ... + 0);
+            std::array<Bool, count> writes = {};
+            Size i = 0;
+            ((isColumn(QueryTerm<Terms>::KIND, QueryTerm<Terms>::STORAGE)
+              ? (void) (writes[i++] = QueryTerm<Terms>::ACCESS == ComponentAccess::Write) : (void) 0), ...);
+            return writes;
+        }
+
+        /// \brief Kinds of the terms on sparse set components, in term order.
+        template<typename... Terms>
+        consteval auto CollectSparseKinds()
+        {
+            constexpr Size count = ((QueryTerm<Terms>::STORAGE == ComponentStorage::SparseSet ? 1 : 0) + ... + 0);
+            std::array<TermKind, count> kinds = {};
+            Size i = 0;
+            ((QueryTerm<Terms>::STORAGE == ComponentStorage::SparseSet ? (void) (kinds[i++] = QueryTerm<Terms>::KIND) : (void) 0), ...);
+            return kinds;
+        }
+
+        /// \brief Where a fetched term is read from.
+        struct FetchSource
+        {
+            Bool sparse = false;
+            /// \brief Index among the fetched chunk columns, or among the sparse set terms if sparse.
+            UInt32 index = 0;
+        };
+
+        /// \brief Per fetched term, where it is read from, in term order.
+        template<typename... Terms>
+        consteval auto CollectFetchSources()
+        {
+            constexpr Size count = ((QueryTerm<Terms>::KIND == TermKind::Fetch ? 1 : 0) + ... + 0);
+            std::array<FetchSource, count> sources = {};
+            Size i = 0;
+            UInt32 columns = 0;
+            UInt32 sparseTerms = 0;
+            auto collect = [&](TermKind kind, ComponentStorage storage)
+            {
+                const Bool sparse = storage == ComponentStorage::SparseSet;
+                if (kind == TermKind::Fetch)
+                    sources[i++] = {sparse, sparse ? sparseTerms : columns++};
+                if (sparse)
+                    ++sparseTerms;
+            };
+            (collect(QueryTerm<Terms>::KIND, QueryTerm<Terms>::STORAGE), ...);
+            return sources;
+        }
+
+        /// \brief Mixes ID arrays into one FNV-1a style hash, the array sizes are mixed in to keep them apart.
+        template<Size... Ns>
+        consteval UInt64 HashTermIDs(const std::array<Meta::TypeIDType, Ns>& ... arrays)
+        {
+            UInt64 hash = 14695981039346656037ull;
+            auto mix = [&hash](UInt64 value) { hash = (hash ^ value) * 1099511628211ull; };
+            ((mix(Ns), [&]() { for (Meta::TypeIDType id: arrays) mix(id); }()), ...);
+            return hash;
+        }
+
+        constexpr Bool IsFetched(TermKind kind, ComponentAccess, ComponentStorage storage) noexcept
+        { return kind == TermKind::Fetch && storage == ComponentStorage::Table; }
+
+        constexpr Bool IsRequired(TermKind kind, ComponentAccess, ComponentStorage storage) noexcept
+        { return kind != TermKind::Without && storage == ComponentStorage::Table; }
+
+        constexpr Bool IsExcluded(TermKind kind, ComponentAccess, ComponentStorage storage) noexcept
+        { return kind == TermKind::Without && storage == ComponentStorage::Table; }
+
+        constexpr Bool IsChangedFilter(TermKind kind, ComponentAccess, ComponentStorage) noexcept
+        { return kind == TermKind::Changed; }
+
+        constexpr Bool IsAddedFilter(TermKind kind, ComponentAccess, ComponentStorage) noexcept
+        { return kind == TermKind::Added; }
+
+        constexpr Bool IsSparse(TermKind, ComponentAccess, ComponentStorage storage) noexcept
+        { return storage == ComponentStorage::SparseSet; }
+
+        constexpr Bool IsRead(TermKind, ComponentAccess access, ComponentStorage) noexcept
+        { return access == ComponentAccess::Read; }
+
+        constexpr Bool IsWritten(TermKind, ComponentAccess access, ComponentStorage) noexcept
+        { return access == ComponentAccess::Write; }
+    }
+
+    /// \brief The component signature of a query, computed at compile time from its terms.
+    ///
+    /// The archetype signature only covers the components stored in tables, the terms on sparse set
+    /// components are joined per entity.
+    template<typename... Terms>
+    struct QueryTraits
+    {
+        /// \brief The fetched terms in order, as a TypeList.
+        using Fetched = typename Internal::Concat<typename Internal::QueryTerm<Terms>::Fetched...>::Type;
+        /// \brief The fetched terms stored in tables in order, the columns of a query chunk.
+        using ChunkFetched = typename Internal::Concat<Internal::ChunkFetched<Terms>...>::Type;
+
+        /// \brief IDs of the fetched components stored in tables, in term order.
+        static constexpr auto FETCHED_IDS = Internal::CollectTermIDs<Internal::IsFetched, Terms...>();
+        /// \brief IDs of the components stored in tables a matching archetype must have.
+        static constexpr auto REQUIRED_IDS = Internal::CollectTermIDs<Internal::IsRequired, Terms...>();
+        /// \brief IDs of the components stored in tables a matching archetype must not have.
+        static constexpr auto EXCLUDED_IDS = Internal::CollectTermIDs<Internal::IsExcluded, Terms...>();
+        /// \brief IDs of the components whose chunks must have changed.
+        static constexpr auto CHANGED_IDS = Internal::CollectTermIDs<Internal::IsChangedFilter, Terms...>();
+        /// \brief IDs of the components whose chunks must have had additions.
+        static constexpr auto ADDED_IDS = Internal::CollectTermIDs<Internal::IsAddedFilter, Terms...>();
+        /// \brief Per fetched chunk column, whether it is fetched for writing, in term order.
+        static constexpr auto FETCHED_WRITES = Internal::CollectFetchedWrites<Terms...>();
+        /// \brief IDs of the components of the terms on sparse set components, in term order.
+        static constexpr auto SPARSE_IDS = Internal::CollectTermIDs<Internal::IsSparse, Terms...>();
+        /// \brief Kinds of the terms on sparse set components, in term order.
+        static constexpr auto SPARSE_KINDS = Internal::CollectSparseKinds<Terms...>();
+        /// \brief Per fetched term, whether it is read from a chunk column or a sparse set, in term order.
+        static constexpr auto FETCH_SOURCES = Internal::CollectFetchSources<Terms...>();
+        /// \brief IDs of the components the query only reads.
+        static constexpr auto READ_IDS = Internal::CollectTermIDs<Internal::IsRead, Terms...>();
+        /// \brief IDs of the components the query writes.
+        static constexpr auto WRITE_IDS = Internal::CollectTermIDs<Internal::IsWritten, Terms...>();
+        /// \brief Identifies the archetypes a query matches and its column order, queries that only
+        /// differ in access share it.
+        static constexpr UInt64 SIGNATURE_HASH = Internal::HashTermIDs(FETCHED_IDS, REQUIRED_IDS, EXCLUDED_IDS, CHANGED_IDS, ADDED_IDS);
+    };
+
+    /// \class QueryState
+    /// \brief The archetypes matching a query signature and the columns of the fetched and filtered
+    /// components in each.
+    ///
+    /// Matching is incremental, Update only tests the archetypes created since the previous update,
+    /// archetypes are never destroyed so earlier matches stay valid.
+    class QueryState
+    {
+    public:
+        static constexpr UInt32 NO_MATCH = std::numeric_limits<UInt32>::max();
+
+        NGIN_API QueryState(std::span<const Meta::TypeIDType> fetched,
+                            std::span<const Meta::TypeIDType> required,
+                            std::span<const Meta::TypeIDType> excluded,
+                            std::span<const Meta::TypeIDType> changed = {},
+                            std::span<const Meta::TypeIDType> added = {});
+
+        /// \brief True if the state was created for exactly these component lists, telling apart the
+        /// signatures that share a hash.
+        [[nodiscard]] NGIN_API Bool HasSignature(std::span<const Meta::TypeIDType> fetched,
+                                                 std::span<const Meta::TypeIDType> required,
+                                                 std::span<const Meta::TypeIDType> excluded,
+                                                 std::span<const Meta::TypeIDType> changed,
+                                                 std::span<const Meta::TypeIDType> added) const noexcept;
+
+        /// \brief Tests the archetypes added since the last update.
+        NGIN_API void Update(std::span<const Scope<Archetype>> archetypes);
+
+        /// \brief Number of matching archetypes.
+        [[nodiscard]] Size GetMatchCount() const noexcept
+        { return matches.size(); }
+
+        /// \brief Index of a matching archetype in the world.
+        [[nodiscard]] UInt32 GetArchetypeIndex(Size match) const noexcept
+        { return matches[match]; }
+
+        /// \brief Match index of an archetype of the world, NO_MATCH if it does not match or was not
+        /// tested yet.
+        [[nodiscard]] UInt32 FindMatch(UInt32 archetypeIndex) const noexcept
+        { return archetypeIndex < matchIndices.size() ? matchIndices[archetypeIndex] : NO_MATCH; }
+
+        /// \brief Column indices of the fetched components in a matching archetype, in term order.
+        [[nodiscard]] const UInt32* GetColumns(Size match) const noexcept
+        { return columns.data() + match * GetColumnsPerMatch(); }
+
+        /// \brief Column indices of the Changed<T> filters in a matching archetype, in term order.
+        [[nodiscard]] std::span<const UInt32> GetChangedColumns(Size match) const noexcept
+        { return {GetColumns(match) + fetched.size(), changed.size()}; }
+
+        /// \brief Column indices of the Added<T> filters in a matching archetype, in term order.
+        [[nodiscard]] std::span<const UInt32> GetAddedColumns(Size match) const noexcept
+        { return {GetColumns(match) + fetched.size() + changed.size(), added.size()}; }
+
+        /// \brief True if chunks are filtered by change ticks.
+        [[nodiscard]] Bool HasChangeFilters() const noexcept
+        { return !changed.empty() || !added.empty(); }
+
+        /// \brief Number of archetypes tested so far.
+        [[nodiscard]] Size GetCheckedCount() const noexcept
+        { return checkedCount; }
+
+    private:
+        std::vector<Meta::TypeIDType> fetched;
+        std::vector<Meta::TypeIDType> required;
+        std::vector<Meta::TypeIDType> excluded;
+        std::vector<Meta::TypeIDType> changed;
+        std::vector<Meta::TypeIDType> added;
+
+        std::vector<UInt32> matches;
+        /// \brief Match index per tested archetype, NO_MATCH for those that do not match.
+        std::vector<UInt32> matchIndices;
+        /// \brief Column indices per match, those of the fetched, changed and added components.
+        std::vector<UInt32> columns;
+        Size checkedCount = 0;
+
+        [[nodiscard]] Size GetColumnsPerMatch() const noexcept
+        { return fetched.size() + changed.size() + added.size(); }
+    };
+
+    /// \class QueryChunk
+    /// \brief The rows of one chunk matched by a query, each fetched component as a contiguous span.
+    /// \tparam Ts The fetched terms, T& or const T&.
+    template<typename... Ts>
+    class QueryChunk
+    {
+    public:
+        QueryChunk(const Entity* entities, UInt32 count, std::tuple<std::remove_reference_t<Ts>* ...> data) noexcept
+                : entities(entities), count(count), data(data)
+        {}
+
+        /// \brief The rows of a chunk of an archetype.
+        /// \param columns Column indices of the fetched terms in the archetype, in term order.
+        [[nodiscard]] static QueryChunk Make(const Archetype& archetype, Size chunkIndex, const UInt32* columns) noexcept
+        {
+            return Make(archetype, chunkIndex, columns, std::index_sequence_for<Ts...> {});
+        }
+
+        /// \brief Number of rows in the chunk.
+        [[nodiscard]] Size GetCount() const noexcept
+        { return count; }
+
+        [[nodiscard]] std::span<const Entity> GetEntities() const noexcept
+        { return {entities, count}; }
+
+        /// \brief The column of the I-th fetched term.
+        template<Size I>
+        [[nodiscard]] auto Get() const noexcept
+        {
+            return std::span<std::remove_reference_t<std::tuple_element_t<I, std::tuple<Ts...>>>>(std::get<I>(data), count);
+        }
+
+        /// \brief The column of a fetched component, const if the query only reads it.
+        template<typename T>
+        [[nodiscard]] auto Get() const noexcept
+        {
+            return Get<IndexOf<std::remove_cvref_t<T>>()>();
+        }
+
+        /// \brief Raw column pointers of the fetched terms, in term order.
+        [[nodiscard]] const std::tuple<std::remove_reference_t<Ts>* ...>& GetData() const noexcept
+        { return data; }
+
+        /// \brief Calls func for every row, as func(components...) or func(entity, components...).
+        template<typename F>
+        void ForEach(F&& func) const
+        {
+            ForEach(func, std::index_sequence_for<Ts...> {});
+        }
+
+    private:
+        const Entity* entities;
+        UInt32 count;
+        std::tuple<std::remove_reference_t<Ts>* ...> data;
+
+        template<Size... Is>
+        static QueryChunk Make(const Archetype& archetype, Size chunkIndex, const UInt32* columns, std::index_sequence<Is...>) noexcept
+        {
+            return QueryChunk(archetype.GetEntities(chunkIndex), archetype.GetChunk(chunkIndex).count,
+                              {archetype.GetColumnData<std::remove_reference_t<Ts>>(columns[Is], chunkIndex)...});
+        }
+
+        template<typename F, Size... Is>
+        void ForEach(F& func, std::index_sequence<Is...>) const
+        {
+            for (UInt32 row = 0; row < count; ++row)
+            {
+                if constexpr (std::is_invocable_v<F&, Entity, std::remove_reference_t<Ts>& ...>)
+                    func(entities[row], std::get<Is>(data)[row]...);
+                else
+                    func(std::get<Is>(data)[row]...);
+            }
+        }
+
+        template<typename T>
+        static consteval Size IndexOf()
+        {
+            constexpr Bool matches[] = {std::is_same_v<T, std::remove_cvref_t<Ts>>...};
+            for (Size i = 0; i < sizeof...(Ts); ++i)
+                if (matches[i])
+                    return i;
+            return sizeof...(Ts);
+        }
+    };
+
+    namespace Internal
+    {
+        template<typename List>
+        struct QueryChunkOf;
+
+        template<typename... Ts>
+        struct QueryChunkOf<TypeList<Ts...>>
+        {
+            using Type = QueryChunk<Ts...>;
+        };
+
+        template<typename List>
+        struct TupleOf;
+
+        template<typename... Ts>
+        struct TupleOf<TypeList<Ts...>>
+        {
+            using Type = std::tuple<Ts...>;
+        };
+    }
+
+    /// \class Query
+    /// \brief A view of the chunks matching a compile-time component signature.
+    ///
+    /// Obtained from World::Query, iterating it yields a QueryChunk per non-empty matching chunk:
+    /// \code
+    /// for (auto chunk: world.Query<const Position&, Velocity&, Without<Frozen>>())
+    /// {
+    ///     auto positions = chunk.Get<Position>();
+    ///     auto velocities = chunk.Get<Velocity>();
+    ///     for (Size i = 0; i < chunk.GetCount(); ++i)
+    ///         velocities[i].y -= positions[i].y;
+    /// }
+    /// \endcode
+    /// A query is invalidated by structural changes to the world.
+    ///
+    /// Yielding a chunk marks the columns fetched as T& as changed at the query's write tick. Chunks
+    /// failing the Changed<T> and Added<T> filters, those whose tick is not newer than the query's since
+    /// tick, are skipped as a whole.
+    ///
+    /// Terms on components stored in sparse sets are joined per entity, such queries are only iterated
+    /// with ForEach. The join is driven by the smallest required sparse set when it holds fewer entities
+    /// than the matching archetypes, the other sets and the entity's row are looked up per entity.
+    /// Otherwise the matching chunks are walked and the sparse sets probed per row.
+    /// \tparam Terms Components to fetch as T& or const T&, and filters like With<T>, Without<T> and Changed<T>.
+    template<typename... Terms>
+    class Query
+    {
+    public:
+        using Traits = QueryTraits<Terms...>;
+        using Chunk = typename Internal::QueryChunkOf<typename Traits::ChunkFetched>::Type;
+
+        /// \brief Number of terms on components stored in sparse sets.
+        static constexpr Size SPARSE_COUNT = Traits::SPARSE_IDS.size();
+        /// \brief The set of each sparse set term in term order, nullptr if the world has none yet. Only
+        /// the terms fetched as T& write through them.
+        using SparseSets = std::array<SparseSet*, SPARSE_COUNT>;
+
+        /// \param sinceTick Chunks must have changed after this tick to pass the change filters.
+        /// \param writeTick Tick the chunks yielded for writing are marked with.
+        /// \param records The world's entity table, only required by queries with sparse set terms.
+        Query(std::span<const Scope<Archetype>> archetypes, const QueryState& state,
+              UInt64 sinceTick = 0, UInt64 writeTick = 0,
+              SparseSets sparseSets = {}, std::span<const EntityRecord> records = {}) noexcept
+                : archetypes(archetypes), state(&state), sinceTick(sinceTick), writeTick(writeTick),
+                  sparseSets(sparseSets), records(records)
+        {}
+
+        class Iterator
+        {
+        public:
+            Iterator(const Query* query, Size match) noexcept
+                    : query(query), match(match)
+            {
+                SkipFiltered();
+            }
+
+            Chunk operator*() const noexcept
+            {
+                return query->MakeChunk(match, chunk);
+            }
+
+            Iterator& operator++() noexcept
+            {
+                ++chunk;
+                SkipFiltered();
+                return *this;
+            }
+
+            /// \brief Index of the current matching archetype.
+            [[nodiscard]] Size GetMatch() const noexcept
+            { return match; }
+
+            /// \brief Index of the current chunk in its archetype.
+            [[nodiscard]] Size GetChunk() const noexcept
+            { return chunk; }
+
+            Bool operator==(const Iterator& other) const noexcept
+            { return match == other.match && chunk == other.chunk; }
+
+        private:
+            const Query* query;
+            Size match;
+            Size chunk = 0;
+
+            /// \brief Advances to the next chunk passing the change filters, past empty archetypes.
+            void SkipFiltered() noexcept
+            {
+                while (match < query->state->GetMatchCount())
+                {
+                    if (chunk >= query->GetArchetype(match).GetChunkCount())
+                    {
+                        ++match;
+                        chunk = 0;
+                    } else if (!query->PassesFilters(match, chunk))
+                        ++chunk;
+                    else
+                        break;
+                }
+            }
+        };
+
+        [[nodiscard]] Iterator begin() const noexcept
+        {
+            static_assert(SPARSE_COUNT == 0, "Queries with sparse set terms are iterated with ForEach.");
+            return Iterator(this, 0);
+        }
+
+        [[nodiscard]] Iterator end() const noexcept
+        {
+            static_assert(SPARSE_COUNT == 0, "Queries with sparse set terms are iterated with ForEach.");
+            return Iterator(this, state->GetMatchCount());
+        }
+
+        /// \brief Calls func with every matching chunk.
+        template<typename F>
+        void ForEachChunk(F&& func) const
+        {
+            for (Chunk chunk: *this)
+                func(chunk);
+        }
+
+        /// \brief Calls func for every matching entity, as func(components...) or func(entity, components...).
+        template<typename F>
+        void ForEach(F&& func) const
+        {
+            if constexpr (SPARSE_COUNT == 0)
+            {
+                for (Chunk chunk: *this)
+                    chunk.ForEach(func);
+            } else
+            {
+                Join<true>([&](Entity entity, const Chunk& chunk, UInt32 row, const DenseIndices& dense)
+                           { Invoke(func, entity, chunk, row, dense, std::make_index_sequence<Traits::FETCH_SOURCES.size()> {}); });
+            }
+        }
+
+        /// \brief Number of matching entities, those in chunks passing the change filters and matching the
+        /// sparse set terms.
+        [[nodiscard]] Size GetEntityCount() const noexcept
+        {
+            if constexpr (SPARSE_COUNT != 0)
+            {
+                Size joined = 0;
+                Join<false>([&](Entity, const Chunk&, UInt32, const DenseIndices&) { ++joined; });
+                return joined;
+            }
+
+            Size count = 0;
+            for (Size i = 0; i < state->GetMatchCount(); ++i)
+            {
+                const Archetype& archetype = GetArchetype(i);
+                if (!state->HasChangeFilters())
+                {
+                    count += archetype.GetEntityCount();
+                    continue;
+                }
+                for (Size chunk = 0; chunk < archetype.GetChunkCount(); ++chunk)
+                    if (PassesFilters(i, chunk))
+                        count += archetype.GetChunk(chunk).count;
+            }
+            return count;
+        }
+
+        /// \brief Number of matching archetypes, including empty ones.
+        [[nodiscard]] Size GetArchetypeCount() const noexcept
+        { return state->GetMatchCount(); }
+
+        /// \brief The rows of the chunkIndex-th chunk of the match-th matching archetype, marks the
+        /// columns fetched for writing as changed.
+        [[nodiscard]] Chunk MakeChunk(Size match, Size chunkIndex) const noexcept
+        {
+            MarkWrites(match, chunkIndex);
+            return Chunk::Make(GetArchetype(match), chunkIndex, state->GetColumns(match));
+        }
+
+        /// \brief True if a chunk passes the Changed<T> and Added<T> filters of the query.
+        [[nodiscard]] Bool PassesFilters(Size match, Size chunkIndex) const noexcept
+        {
+            if constexpr (Traits::CHANGED_IDS.empty() && Traits::ADDED_IDS.empty())
+                return true;
+            else
+            {
+                const Archetype& archetype = GetArchetype(match);
+                const UInt64* changed = archetype.GetChangedTicks(chunkIndex);
+                for (UInt32 column: state->GetChangedColumns(match))
+                    if (changed[column] <= sinceTick)
+                        return false;
+                const UInt64* added = archetype.GetAddedTicks(chunkIndex);
+                for (UInt32 column: state->GetAddedColumns(match))
+                    if (added[column] <= sinceTick)
+                        return false;
+                return true;
+            }
+        }
+
+        [[nodiscard]] const Archetype& GetArchetype(Size match) const noexcept
+        { return *archetypes[state->GetArchetypeIndex(match)]; }
+
+    private:
+        using DenseIndices = std::array<UInt32, SPARSE_COUNT>;
+        using FetchedTuple = typename Internal::TupleOf<typename Traits::Fetched>::Type;
+
+        std::span<const Scope<Archetype>> archetypes;
+        const QueryState* state;
+        UInt64 sinceTick;
+        UInt64 writeTick;
+        SparseSets sparseSets;
+        std::span<const EntityRecord> records;
+
+        void MarkWrites(Size match, Size chunkIndex) const noexcept
+        {
+            const Archetype& archetype = GetArchetype(match);
+            const UInt32* columns = state->GetColumns(match);
+            for (Size i = 0; i < Traits::FETCHED_WRITES.size(); ++i)
+            {
+                if (Traits::FETCHED_WRITES[i])
+                    archetype.MarkChanged(columns[i], chunkIndex, writeTick);
+            }
+        }
+
+        /// \brief Looks an entity up in the sparse sets of the query.
+        /// \return True if it is in the sets of the required terms and not in those of the excluded ones.
+        Bool ProbeSparseSets(Entity entity, DenseIndices& dense) const noexcept
+        {
+            for (Size i = 0; i < SPARSE_COUNT; ++i)
+            {
+                dense[i] = sparseSets[i] != nullptr ? sparseSets[i]->Find(entity) : SparseSet::NO_INDEX;
+                if ((dense[i] != SparseSet::NO_INDEX) == (Traits::SPARSE_KINDS[i] == Internal::TermKind::Without))
+                    return false;
+            }
+            return true;
+        }
+
+        /// \brief Calls visit(entity, chunk, row, dense) for every entity matching all terms, with the
+        /// unmarked chunk of its row and its dense indices in the sparse sets.
+        /// \tparam MARK_WRITES Whether chunks holding a visited entity are marked as written.
+        template<Bool MARK_WRITES, typename V>
+        void Join(V&& visit) const
+        {
+            // The smallest required set bounds the result, a required set the world lacks empties it
+            const SparseSet* driver = nullptr;
+            for (Size i = 0; i < SPARSE_COUNT; ++i)
+            {
+                if (Traits::SPARSE_KINDS[i] == Internal::TermKind::Without)
+                    continue;
+                if (sparseSets[i] == nullptr)
+                    return;
+                if (driver == nullptr || sparseSets[i]->GetCount() < driver->GetCount())
+                    driver = sparseSets[i];
+            }
+
+            Size tableCount = 0;
+            for (Size i = 0; driver != nullptr && i < state->GetMatchCount(); ++i)
+                tableCount += GetArchetype(i).GetEntityCount();
+
+            DenseIndices dense;
+            if (driver != nullptr && driver->GetCount() < tableCount)
+            {
+                for (Entity entity: driver->GetEntities())
+                {
+                    const EntityRecord& record = records[entity.GetIndex()];
+                    const UInt32 match = state->FindMatch(record.archetype);
+                    if (match == QueryState::NO_MATCH || !PassesFilters(match, record.location.chunk)
+                        || !ProbeSparseSets(entity, dense))
+                        continue;
+                    if constexpr (MARK_WRITES)
+                        MarkWrites(match, record.location.chunk);
+                    visit(entity, Chunk::Make(GetArchetype(match), record.location.chunk, state->GetColumns(match)),
+                          record.location.row, dense);
+                }
+                return;
+            }
+
+            for (Size match = 0; match < state->GetMatchCount(); ++match)
+            {
+                const Archetype& archetype = GetArchetype(match);
+                for (Size chunkIndex = 0; chunkIndex < archetype.GetChunkCount(); ++chunkIndex)
+                {
+                    if (!PassesFilters(match, chunkIndex))
+                        continue;
+                    const Chunk chunk = Chunk::Make(archetype, chunkIndex, state->GetColumns(match));
+                    const std::span<const Entity> entities = chunk.GetEntities();
+                    Bool marked = !MARK_WRITES;
+                    for (UInt32 row = 0; row < entities.size(); ++row)
+                    {
+                        if (!ProbeSparseSets(entities[row], dense))
+                            continue;
+                        if (!marked)
+                        {
+                            MarkWrites(match, chunkIndex);
+                            marked = true;
+                        }
+                        visit(entities[row], chunk, row, dense);
+                    }
+                }
+            }
+        }
+
+        /// \brief Reference to the I-th fetched term of an entity, from its chunk row or its sparse set.
+        template<Size I>
+        [[nodiscard]] auto& Fetch(const Chunk& chunk, UInt32 row, const DenseIndices& dense) const noexcept
+        {
+            using Component = std::remove_reference_t<std::tuple_element_t<I, FetchedTuple>>;
+            constexpr Internal::FetchSource SOURCE = Traits::FETCH_SOURCES[I];
+            if constexpr (SOURCE.sparse && std::is_const_v<Component>)
+            {
+                const SparseSet& set = *sparseSets[SOURCE.index];
+                return *std::launder(reinterpret_cast<Component*>(set.Get(dense[SOURCE.index])));
+            } else if constexpr (SOURCE.sparse)
+                return *std::launder(reinterpret_cast<Component*>(sparseSets[SOURCE.index]->Get(dense[SOURCE.index])));
+            else
+                return std::get<SOURCE.index>(chunk.GetData())[row];
+        }
+
+        template<typename F, Size... Is>
+        void Invoke(F& func, Entity entity, const Chunk& chunk, UInt32 row, const DenseIndices& dense,
+                    std::index_sequence<Is...>) const
+        {
+            if constexpr (std::is_invocable_v<F&, Entity, std::remove_reference_t<std::tuple_element_t<Is, FetchedTuple>>& ...>)
+                func(entity, Fetch<Is>(chunk, row, dense)...);
+            else
+                func(Fetch<Is>(chunk, row, dense)...);
+        }
+    };
+}
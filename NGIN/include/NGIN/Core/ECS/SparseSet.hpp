@@ -0,0 +1,110 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include "Component.hpp"
+#include "Entity.hpp"
+
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace NGIN::Core::ECS
+{
+    /// \class SparseSet
+    /// \brief Storage of the components of one sparse set component type, see ComponentStorage::SparseSet.
+    ///
+    /// Components are packed densely in insertion order next to the entities owning them, and a sparse
+    /// array maps entity indices to dense indices. The sparse array is split into pages allocated on first
+    /// use, so a set holding a few entities with high indices stays small. Finding, adding and removing
+    /// a component are O(1), removing moves the last component into the hole.
+    class SparseSet
+    {
+    public:
+        static constexpr UInt32 NO_INDEX = std::numeric_limits<UInt32>::max();
+        /// \brief Number of entity indices per sparse page.
+        static constexpr UInt32 PAGE_SIZE = 4096;
+
+        /// \throws std::invalid_argument if the component type is not stored in sparse sets.
+        NGIN_API explicit SparseSet(const ComponentInfo& info);
+
+        /// \brief Destroys every stored component.
+        NGIN_API ~SparseSet();
+
+        SparseSet(const SparseSet&) = delete;
+
+        SparseSet& operator=(const SparseSet&) = delete;
+
+        [[nodiscard]] const ComponentInfo& GetInfo() const noexcept
+        { return *info; }
+
+        /// \brief Dense index of an entity's component, NO_INDEX if the entity has none.
+        [[nodiscard]] UInt32 Find(Entity entity) const noexcept
+        {
+            const UInt32 index = entity.GetIndex();
+            const Size page = index / PAGE_SIZE;
+            if (page >= pages.size() || pages[page] == nullptr)
+                return NO_INDEX;
+            const UInt32 dense = pages[page][index % PAGE_SIZE];
+            return dense != NO_INDEX && entities[dense] == entity ? dense : NO_INDEX;
+        }
+
+        [[nodiscard]] Bool Contains(Entity entity) const noexcept
+        { return Find(entity) != NO_INDEX; }
+
+        /// \brief Address of the component at a dense index.
+        [[nodiscard]] std::byte* Get(UInt32 dense) noexcept
+        { return data + dense * info->size; }
+
+        [[nodiscard]] const std::byte* Get(UInt32 dense) const noexcept
+        { return data + dense * info->size; }
+
+        /// \brief Address of an entity's component, nullptr if it has none.
+        [[nodiscard]] std::byte* TryGet(Entity entity) noexcept
+        {
+            const UInt32 dense = Find(entity);
+            return dense == NO_INDEX ? nullptr : Get(dense);
+        }
+
+        [[nodiscard]] const std::byte* TryGet(Entity entity) const noexcept
+        {
+            const UInt32 dense = Find(entity);
+            return dense == NO_INDEX ? nullptr : Get(dense);
+        }
+
+        /// \brief Appends storage for the component of an entity that has none, left uninitialized for the
+        /// caller to construct. The component of an entity with the same index and another generation is
+        /// destroyed and its storage reused.
+        /// \throws std::invalid_argument if the entity already has a component in the set.
+        NGIN_API std::byte* Emplace(Entity entity);
+
+        /// \brief Destroys an entity's component.
+        /// \return False if the entity has none.
+        NGIN_API Bool Remove(Entity entity) noexcept;
+
+        /// \brief Number of stored components.
+        [[nodiscard]] Size GetCount() const noexcept
+        { return entities.size(); }
+
+        /// \brief The entities owning the components, in dense order.
+        [[nodiscard]] std::span<const Entity> GetEntities() const noexcept
+        { return entities; }
+
+        /// \brief Start of the densely packed components.
+        [[nodiscard]] std::byte* GetData() const noexcept
+        { return data; }
+
+    private:
+        const ComponentInfo* info;
+        /// \brief Dense index per entity index, NO_INDEX where there is none, nullptr for pages never used.
+        std::vector<std::unique_ptr<UInt32[]>> pages;
+        std::vector<Entity> entities;
+        std::byte* data = nullptr;
+        /// \brief Number of components data has room for.
+        Size capacity = 0;
+
+        UInt32& GetSparse(UInt32 index);
+
+        void Reallocate(Size newCapacity);
+    };
+}
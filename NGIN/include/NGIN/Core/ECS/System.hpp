@@ -0,0 +1,151 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include "Archetype.hpp"
+#include "Query.hpp"
+
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace NGIN::Core::ECS
+{
+    /// \brief The component data a system touches, used to decide which systems may run concurrently.
+    struct SystemAccess
+    {
+        std::vector<Meta::TypeIDType> reads;
+        std::vector<Meta::TypeIDType> writes;
+        /// \brief The system may touch the whole world, including structural changes.
+        Bool exclusive = false;
+
+        /// \brief True if the systems cannot run concurrently: either is exclusive, or one writes a
+        /// component the other reads or writes.
+        [[nodiscard]] NGIN_API Bool ConflictsWith(const SystemAccess& other) const noexcept;
+    };
+
+    /// \class System
+    /// \brief A unit of per-frame work over the world, split into work items that may run concurrently.
+    class System
+    {
+    public:
+        System(String name, SystemAccess access)
+                : name(std::move(name)), access(std::move(access))
+        {}
+
+        virtual ~System() = default;
+
+        /// \brief Collects the work items of the coming run. Called on the main thread while no system runs.
+        /// \param changeTick Tick of the coming run, newer than the tick of every earlier run of any system.
+        /// \return Number of work items.
+        virtual Size Prepare(std::span<const Scope<Archetype>> archetypes, UInt64 changeTick) = 0;
+
+        /// \brief Runs the work items [begin, end). Disjoint ranges may run concurrently.
+        virtual void Run(Size begin, Size end, F64 deltaTime) = 0;
+
+        [[nodiscard]] const String& GetName() const noexcept
+        { return name; }
+
+        [[nodiscard]] const SystemAccess& GetAccess() const noexcept
+        { return access; }
+
+    private:
+        String name;
+        SystemAccess access;
+    };
+
+    /// \class ChunkSystem
+    /// \brief A system calling a function for every chunk matched by a query, one chunk per work item.
+    ///
+    /// The function is called as func(chunk, deltaTime) or func(chunk) with a Query<Terms...>::Chunk,
+    /// its read and write sets are those of the query. Change filters compare against the tick of the
+    /// system's previous run, so a Changed<T> system sees every change made since it last ran, except
+    /// its own. Filters are evaluated when a chunk's work item runs, after the systems it depends on.
+    /// The query may not have terms on sparse set components.
+    template<typename F, typename... Terms>
+    class ChunkSystem : public System
+    {
+    public:
+        using QueryType = Query<Terms...>;
+        using Traits = typename QueryType::Traits;
+        static_assert(QueryType::SPARSE_COUNT == 0, "Chunk systems only take terms on components stored in tables.");
+
+        ChunkSystem(String name, QueryState& state, F function)
+                : System(std::move(name), {{Traits::READ_IDS.begin(), Traits::READ_IDS.end()},
+                                           {Traits::WRITE_IDS.begin(), Traits::WRITE_IDS.end()}, false}),
+                  state(&state), function(std::move(function))
+        {}
+
+        Size Prepare(std::span<const Scope<Archetype>> archetypes, UInt64 changeTick) override
+        {
+            this->archetypes = archetypes;
+            sinceTick = runTick;
+            runTick = changeTick;
+            state->Update(archetypes);
+            chunks.clear();
+
+            const QueryType query(archetypes, *state, sinceTick, runTick);
+            for (UInt32 match = 0; match < query.GetArchetypeCount(); ++match)
+            {
+                const Size chunkCount = query.GetArchetype(match).GetChunkCount();
+                for (UInt32 chunk = 0; chunk < chunkCount; ++chunk)
+                    chunks.push_back({match, chunk});
+            }
+            return chunks.size();
+        }
+
+        void Run(Size begin, Size end, F64 deltaTime) override
+        {
+            const QueryType query(archetypes, *state, sinceTick, runTick);
+            for (Size i = begin; i < end; ++i)
+            {
+                if (!query.PassesFilters(chunks[i].match, chunks[i].chunk))
+                    continue;
+                const typename QueryType::Chunk chunk = query.MakeChunk(chunks[i].match, chunks[i].chunk);
+                if constexpr (std::is_invocable_v<F&, const typename QueryType::Chunk&, F64>)
+                    function(chunk, deltaTime);
+                else
+                    function(chunk);
+            }
+        }
+
+    private:
+        struct ChunkRef
+        {
+            UInt32 match;
+            UInt32 chunk;
+        };
+
+        QueryState* state;
+        F function;
+        std::span<const Scope<Archetype>> archetypes;
+        std::vector<ChunkRef> chunks;
+        /// \brief Tick of the previous run, chunks must have changed after it to pass change filters.
+        UInt64 sinceTick = 0;
+        /// \brief Tick of the current run, the chunks it writes are marked with it.
+        UInt64 runTick = 0;
+    };
+
+    /// \class ExclusiveSystem
+    /// \brief A system with a single work item that runs alone, called as func(deltaTime).
+    ///
+    /// Exclusive systems act as sync points, every system registered before one finishes before it
+    /// starts and every system registered after it starts after it finished.
+    template<typename F>
+    class ExclusiveSystem : public System
+    {
+    public:
+        ExclusiveSystem(String name, F function)
+                : System(std::move(name), {{}, {}, true}), function(std::move(function))
+        {}
+
+        Size Prepare(std::span<const Scope<Archetype>>, UInt64) override
+        { return 1; }
+
+        void Run(Size, Size, F64 deltaTime) override
+        { function(deltaTime); }
+
+    private:
+        F function;
+    };
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Async/JobSystem.hpp>
+#include "Archetype.hpp"
+#include "System.hpp"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace NGIN::Core::ECS
+{
+    /// \class SystemScheduler
+    /// \brief Runs the systems of a world, concurrently where their component access allows it.
+    ///
+    /// Systems are split into stages at exclusive systems. Within a stage, a system depends on every
+    /// earlier system it conflicts with, so systems touching disjoint data run concurrently while
+    /// conflicting ones keep their registration order. The work items of a system, its chunks, are
+    /// further split into batches run as jobs, so a single heavy system also uses every core.
+    ///
+    /// Without a job system every system runs serially on the calling thread in registration order.
+    /// The end of every stage is a sync point where the world plays back deferred structural changes.
+    class SystemScheduler
+    {
+    public:
+        /// \brief Adds a system after the already added ones.
+        /// \return Registration index of the system.
+        NGIN_API UInt32 AddSystem(Scope<System> system);
+
+        /// \brief Runs every system of a stage once and waits for all of them.
+        /// Rethrows the first exception thrown by a system once the stage is done.
+        /// Must be called from the main thread of the job system, which helps running jobs while it waits.
+        /// \param stage Index of the stage, stages run in order and are separated by exclusive systems.
+        /// \param archetypes Archetypes of the world.
+        /// \param changeTick Change tick of the world, advanced once per system in registration order.
+        /// \param jobSystem Job system to run systems on, or nullptr to run serially.
+        NGIN_API void RunStage(UInt32 stage, std::span<const Scope<Archetype>> archetypes, UInt64& changeTick,
+                               F64 deltaTime, Async::JobSystem* jobSystem);
+
+        [[nodiscard]] NGIN_API Size GetSystemCount() const noexcept;
+
+        [[nodiscard]] NGIN_API const System& GetSystem(UInt32 index) const;
+
+        /// \brief Registration indices of the systems a system waits for within its stage.
+        [[nodiscard]] NGIN_API const std::vector<UInt32>& GetDependencies(UInt32 index) const;
+
+        /// \brief Number of stages, consecutive non-exclusive systems share a stage.
+        [[nodiscard]] NGIN_API Size GetStageCount() const noexcept;
+
+    private:
+        struct Node
+        {
+            Scope<System> system;
+            std::vector<UInt32> dependencies;
+            std::vector<UInt32> dependents;
+            /// \brief Work items and items per batch of the running stage.
+            Size itemCount = 0;
+            Size batchSize = 0;
+        };
+
+        struct Stage
+        {
+            UInt32 begin;
+            UInt32 end;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<Stage> stages;
+
+        /// \brief Unfinished dependencies and batches of each node in the running stage.
+        Scope<std::atomic<UInt32>[]> remainingDependencies;
+        Scope<std::atomic<UInt32>[]> remainingBatches;
+
+        F64 currentDeltaTime = 0.0;
+        Async::JobSystem* currentJobSystem = nullptr;
+        Async::JobCounter stageCounter;
+
+        std::mutex exceptionMutex;
+        std::exception_ptr firstException;
+
+        /// \brief Spawns the batches of a node whose dependencies finished.
+        void Schedule(UInt32 index);
+
+        /// \brief Runs a batch, the last batch of a node schedules the dependents it unblocks.
+        void RunBatch(UInt32 index, Size begin, Size end);
+
+        void Finish(UInt32 index);
+    };
+}
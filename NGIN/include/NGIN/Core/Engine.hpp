@@ -5,13 +5,20 @@
 
 #include <NGIN/Meta/TypeName.hpp>
 #include <NGIN/Meta/TypeWrapper.hpp>
+#include <NGIN/Meta/TypeMap.hpp>
 
 #include "Module.hpp"
+#include "ModuleScheduler.hpp"
+#include "FixedTimestep.hpp"
+#include "FramePacer.hpp"
+#include "TickProfiler.hpp"
+#include "World.hpp"
+#include <NGIN/Async/CoroutineScheduler.hpp>
+#include <NGIN/Async/JobSystem.hpp>
 #include <NGIN/Time.hpp>
 #include <NGIN/Core/EventBus.hpp>
 #include <NGIN/Core/Events/Quit.hpp>
 
-#include <unordered_map>
 #include <vector>
 
 namespace NGIN::Core
@@ -30,6 +37,53 @@ namespace NGIN::Core
 
         NGIN_API EventBus& GetEventBus();
 
+        /// \brief The engine's job system, modules submit fine-grained jobs to it.
+        ///
+        /// Created on first use, the calling thread becomes its main thread and should be the thread
+        /// calling Tick.
+        NGIN_API Async::JobSystem& GetJobSystem();
+
+        /// \brief The engine's coroutine scheduler, resumed once per frame before the modules tick.
+        NGIN_API Async::CoroutineScheduler& GetCoroutineScheduler();
+
+        /// \brief The engine's world, its systems run every frame after the modules' OnTick and before OnPostTick.
+        NGIN_API World& GetWorld();
+
+        /// \brief Enables running independent modules' tick phases and world systems concurrently on the job system.
+        ///
+        /// Disabled by default: modules then tick and systems run serially in registration order, which is
+        /// deterministic and easier to debug. Modules ticking concurrently must not publish immediate events or share
+        /// other unsynchronized state, and modules that need the main thread declare MainThreadOnly.
+        /// \param enabled True to tick in parallel.
+        NGIN_API void SetParallelTick(Bool enabled);
+
+        [[nodiscard]] NGIN_API Bool IsParallelTick() const noexcept;
+
+        /// \brief Sets how Tick waits between frames, Unlimited by default.
+        /// \param targetFrameRate Frames per second to hold, ignored when Unlimited.
+        NGIN_API void SetFramePacing(FramePacing pacing, F64 targetFrameRate = 60.0);
+
+        /// \brief Runs OnFixedTick with a constant step, as often per frame as the elapsed time requires.
+        /// \param step Length of a step in seconds, 0 disables fixed ticking.
+        /// \param maxStepsPerFrame Upper bound of fixed ticks per frame, excess time is dropped.
+        NGIN_API void SetFixedTimestep(F64 step, UInt32 maxStepsPerFrame = 8);
+
+        /// \brief Fraction of a fixed step elapsed since the last fixed tick, for interpolating rendered state.
+        [[nodiscard]] NGIN_API F64 GetInterpolationAlpha() const noexcept;
+
+        /// \brief Enables timing every module's tick phases and the frame into the tick profiler.
+        NGIN_API void SetProfiling(Bool enabled);
+
+        [[nodiscard]] NGIN_API Bool IsProfiling() const noexcept;
+
+        /// \brief Per-module, per-phase timing statistics, filled while profiling.
+        [[nodiscard]] NGIN_API const TickProfiler& GetTickProfiler() const noexcept;
+
+        /// \brief Periodically logs the profiler statistics while profiling.
+        /// \param intervalSeconds Seconds between reports, 0 disables reporting.
+        /// \param jsonPath File overwritten with the statistics as JSON on every report, empty to only log.
+        NGIN_API void SetProfileReport(F64 intervalSeconds, const String& jsonPath = {});
+
         template<typename T, typename ... Args>
         requires std::is_base_of_v<Module, T>
         void AddModule(Args&& ... args);
@@ -51,10 +105,32 @@ namespace NGIN::Core
 
         void UnpackModuleDependencies(Meta::TypeWrapper<void>) {}
 
-        std::unordered_map<String, UInt64> moduleIndexMap;
+        template<typename... Ts>
+        std::vector<UInt32> GetModuleDependencyIndices(Meta::TypeWrapper<Ts...>);
+
+        std::vector<UInt32> GetModuleDependencyIndices(Meta::TypeWrapper<void>) { return {}; }
+
+        Meta::TypeMap<UInt32> moduleIndexMap;
         std::vector<Module*> moduleVector;
 
-        Time::Timer timer = Time::Timer();
+        Scope<Async::JobSystem> jobSystem;
+        ModuleScheduler moduleScheduler;
+        Bool parallelTick = false;
+
+        Async::CoroutineScheduler coroutineScheduler;
+
+        World world;
+
+        FramePacer framePacer;
+        FixedTimestep fixedTimestep;
+
+        TickProfiler tickProfiler;
+        Bool profiling = false;
+        F64 profileReportInterval = 0.0;
+        String profileReportPath;
+        Time::Timer profileReportTimer;
+
+        void ReportProfile();
 
         EventBus eventBus = EventBus();
 
@@ -69,10 +145,8 @@ namespace NGIN::Core
     requires std::is_base_of_v<Module, T>
     void Engine::AddModule(Args&& ... args)
     {
-        const String TName = String(NGIN::Meta::TypeName<T>::Class());
-
         // Check if layer already exists
-        if (moduleIndexMap.contains(TName))
+        if (moduleIndexMap.Contains<T>())
             return;
 
         // Unpack dependencies with compiler magic. Passing empty struct with compile time type information it just makes sense.
@@ -80,12 +154,14 @@ namespace NGIN::Core
 
         // Check if layer was created due to circular dependencies
         //TODO: Check if this is the correct way to handle circular dependencies
-        if (moduleIndexMap.contains(TName))
+        if (moduleIndexMap.Contains<T>())
             return;
 
         // Create layer
-        moduleIndexMap[TName] = moduleVector.size();
+        moduleIndexMap.Insert<T>(static_cast<UInt32>(moduleVector.size()));
         moduleVector.emplace_back(new T(std::forward<Args>(args)...));
+        moduleScheduler.AddModule(moduleVector.back(), GetModuleDependencyIndices(typename T::Dependencies {}), T::MainThreadOnly);
+        tickProfiler.AddModule(Meta::TypeName<T>::Full());
         moduleVector.back()->OnInit(this);
     }
 
@@ -93,10 +169,8 @@ namespace NGIN::Core
     requires std::is_base_of_v<Module, T>
     T* Engine::GetModule()
     {
-        const String TName = String(NGIN::Meta::TypeName<T>::Class());
-        if (!moduleIndexMap.contains(TName))
-            return nullptr;
-        return static_cast<T*>(moduleVector[moduleIndexMap[TName]]);
+        const UInt32* index = moduleIndexMap.Find<T>();
+        return index ? static_cast<T*>(moduleVector[*index]) : nullptr;
     }
 
     template<typename... Ts>
@@ -104,4 +178,17 @@ namespace NGIN::Core
     {
         (AddModule<Ts>(), ...);
     }
+
+    template<typename... Ts>
+    std::vector<UInt32> Engine::GetModuleDependencyIndices(Meta::TypeWrapper<Ts...>)
+    {
+        std::vector<UInt32> indices;
+        // Dependencies missing due to circular dependencies are skipped
+        ([&]()
+        {
+            if (const UInt32* index = moduleIndexMap.Find<Ts>())
+                indices.push_back(*index);
+        }(), ...);
+        return indices;
+    }
 }
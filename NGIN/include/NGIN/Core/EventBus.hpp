@@ -4,10 +4,15 @@
 #include <NGIN/Util/Delegate.hpp>
 #include <NGIN/Meta/TypeID.hpp>
 #include <NGIN/Meta/FunctionTraits.hpp>
+#include <NGIN/Core/Events/ConsumableEvent.hpp>
 #include <vector>
 #include <type_traits>
 #include <unordered_map>
 #include <deque>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <optional>
 
 namespace NGIN::Core
 {
@@ -20,23 +25,69 @@ namespace NGIN::Core
         Queued
     };
 
+    /// @brief How repeated queued events of one type are merged before the queue is flushed.
+    enum class CoalescePolicy : UInt8
+    {
+        /// @brief Every queued event is delivered.
+        None,
+        /// @brief Only the most recently queued event is delivered.
+        KeepLatest,
+        /// @brief Queued events are accumulated with operator+=.
+        Sum,
+        /// @brief Queued events are merged by a user supplied function.
+        Custom
+    };
+
+    /// @brief Events that can be coalesced with CoalescePolicy::Sum.
+    template<typename EventType>
+    concept SummableEvent = requires(EventType& a, const EventType& b) { a += b; };
+
+    /// @brief Handle to a listener registered with EventBus::Subscribe.
+    ///
+    /// The handle is a generation-checked index into the listener slot table of one event type.
+    /// Once the listener is unsubscribed the slot generation is bumped, so stale handles are
+    /// rejected without touching the listener array.
+    struct SubscriptionHandle
+    {
+        static constexpr UInt32 INVALID_INDEX = std::numeric_limits<UInt32>::max();
+
+        /// @brief Type ID of the event the listener is subscribed to.
+        UInt64 eventTypeID = 0;
+        /// @brief Index of the listener slot.
+        UInt32 index = INVALID_INDEX;
+        /// @brief Generation of the slot at the time of subscription.
+        UInt32 generation = 0;
+
+        [[nodiscard]] bool IsValid() const noexcept
+        { return index != INVALID_INDEX; }
+    };
+
 
     class EventBus
     {
     public:
-        using EventVector = std::vector<DynamicDelegate>;
+        /// @brief Listener type stored for events of type EventType.
+        template<typename EventType>
+        using Listener = StaticDelegate<void(const EventType&)>;
         using QueuedEvent = StaticDelegate<void()>;
 
+        /**
+         * @brief Subscribe a callable to an event.
+         *
+         * Listeners with a higher priority are dispatched first, listeners with equal priority
+         * are dispatched in subscription order. The order is resolved once here, not on publish.
+         * @tparam EventType The type of event.
+         * @param func The callable, taking the event as a const reference.
+         * @param priority The dispatch priority of the listener.
+         * @return Handle that can be passed to Unsubscribe.
+         */
         template<typename EventType, typename FuncType>
-        requires std::is_same_v<typename Meta::FunctionTraits<FuncType>::template ArgNType<0>, const EventType&>
-        void Subscribe(FuncType&& func)
+        requires std::is_invocable_v<FuncType, const EventType&>
+                 && std::is_same_v<typename Meta::FunctionTraits<std::decay_t<FuncType>>::template ArgNType<0>, const EventType&>
+        SubscriptionHandle Subscribe(FuncType&& func, const Int32 priority = 0)
         {
-            auto eventTypeIndex = NGIN::Meta::TypeID<EventType>();
-
-            auto& listeners = listenersMap[eventTypeIndex];
-            //auto test = EventListener<EventType>(std::move(listener));
-
-            listeners.emplace_back(std::forward<FuncType>(func));
+            constexpr auto eventTypeIndex = Meta::TypeID<EventType>();
+            return GetListenerList<EventType>().Add(eventTypeIndex, Listener<EventType>(std::forward<FuncType>(func)), priority);
         }
 
 
@@ -47,39 +98,98 @@ namespace NGIN::Core
          * @tparam T The type of the instance's class.
          * @param instance Pointer to the instance.
          * @param memberFunction Pointer to the member function.
+         * @param priority The dispatch priority of the listener.
+         * @return Handle that can be passed to Unsubscribe.
          */
         template<typename EventType, typename T>
-        void Subscribe(T* instance, void (T::* memberFunction)(const EventType&))
+        SubscriptionHandle Subscribe(T* instance, void (T::* memberFunction)(const EventType&), const Int32 priority = 0)
         {
             constexpr auto eventTypeIndex = Meta::TypeID<EventType>();
-            auto& listeners = listenersMap[eventTypeIndex];
-            listeners.emplace_back(std::move(DynamicDelegate(memberFunction, instance)));
+            return GetListenerList<EventType>().Add(eventTypeIndex, Listener<EventType>(memberFunction, instance), priority);
+        }
+
+        /**
+         * @brief Remove a listener previously registered with Subscribe.
+         *
+         * The listener is tombstoned in O(1) and will not be called again.
+         * The listener array is compacted during FlushEvents.
+         * @param handle The handle returned by Subscribe.
+         * @return True if the listener was removed, false if the handle was stale or invalid.
+         */
+        bool Unsubscribe(const SubscriptionHandle& handle)
+        {
+            auto it = listenersMap.find(handle.eventTypeID);
+            if (it == listenersMap.end())
+                return false;
+            return it->second->Remove(handle);
+        }
+
+        /**
+         * @brief Check if a handle still refers to a subscribed listener.
+         * @param handle The handle returned by Subscribe.
+         */
+        [[nodiscard]] bool IsSubscribed(const SubscriptionHandle& handle) const
+        {
+            auto it = listenersMap.find(handle.eventTypeID);
+            if (it == listenersMap.end())
+                return false;
+            return it->second->Contains(handle);
         }
 
         /**
          * @brief Publish (dispatch) an event.
-         *  This will call all listeners subscribed to the event type.
+         *  This will call all listeners subscribed to the event type in priority order.
          *  The event will be passed to the listeners.
+         *  If the event derives from Events::ConsumableEvent, dispatch stops at the listener that consumes it.
          * @tparam EventType The type of event.
          * @param event The event to dispatch.
          */
         template<typename EventType>
         void Publish(EventType event, const EventMode mode = EventMode::Immediate)
         {
-            constexpr auto eventTypeIndex = Meta::TypeID<EventType>();
-
-            const EventType& constEvent = event;
-            if (listenersMap.count(eventTypeIndex) != 0)
+            if (mode == EventMode::Immediate)
             {
-                auto& listeners = listenersMap[eventTypeIndex];
-                for (auto& delegate: listeners)
-                {
-                    if (mode == EventMode::Immediate)
-                        delegate(constEvent);
-                    else
-                        eventQueue.push_back([=]() mutable { delegate(constEvent); });
-                }
+                Dispatch<EventType>(event);
+                return;
             }
+
+            constexpr auto eventTypeIndex = Meta::TypeID<EventType>();
+            auto it = coalescersMap.find(eventTypeIndex);
+            if (it == coalescersMap.end() || !Enqueue(static_cast<Coalescer<EventType>&>(*it->second), std::move(event)))
+                eventQueue.push_back([this, event]() { Dispatch<EventType>(event); });
+        }
+
+        /**
+         * @brief Set how queued events of a type are coalesced.
+         *
+         * While an event of the type is waiting in the queue, further queued events of the same type
+         * are merged into it instead of being queued. The merged event is delivered at the position
+         * of the first one. Immediate events are never coalesced.
+         * @tparam EventType The type of event.
+         * @tparam Policy CoalescePolicy::None, KeepLatest, or Sum for events with operator+=. Use the
+         * overload taking a merge function for Custom.
+         */
+        template<typename EventType, CoalescePolicy Policy>
+        requires (Policy != CoalescePolicy::Custom) && (Policy != CoalescePolicy::Sum || SummableEvent<EventType>)
+        void SetCoalescePolicy()
+        {
+            auto& coalescer = GetCoalescer<EventType>();
+            coalescer.policy = Policy;
+            coalescer.merge.reset();
+        }
+
+        /**
+         * @brief Coalesce queued events of a type with a custom merge function.
+         * @tparam EventType The type of event.
+         * @param merge Callable of the form void(EventType& pending, const EventType& incoming).
+         */
+        template<typename EventType, typename MergeFunc>
+        requires std::is_invocable_v<MergeFunc, EventType&, const EventType&>
+        void SetCoalescePolicy(MergeFunc&& merge)
+        {
+            auto& coalescer = GetCoalescer<EventType>();
+            coalescer.policy = CoalescePolicy::Custom;
+            coalescer.merge.emplace(std::forward<MergeFunc>(merge));
         }
 
         void FlushEvents()
@@ -89,6 +199,8 @@ namespace NGIN::Core
                 eventQueue.front()();
                 eventQueue.pop_front();
             }
+            for (auto& [eventTypeID, listeners]: listenersMap)
+                listeners->Compact();
         }
 
         /**
@@ -100,11 +212,311 @@ namespace NGIN::Core
         }
 
     private:
+        /// @brief Type-independent bookkeeping of the listeners of a single event type.
+        ///
+        /// Listeners live contiguously in dispatch order, sorted by descending priority on insertion.
+        /// Unsubscribed listeners are tombstoned and removed by Compact, which keeps handles stable
+        /// through the slot table.
+        /// Listeners subscribed while the list is being dispatched are parked in a pending array
+        /// and appended once the outermost dispatch returns, so the dense array never reallocates
+        /// underneath a running listener.
+        class ListenerListBase
+        {
+        public:
+            virtual ~ListenerListBase() = default;
+
+            bool Remove(const SubscriptionHandle& handle)
+            {
+                if (!Contains(handle))
+                    return false;
+
+                auto& slot = slots[handle.index];
+                if (slot.denseIndex & PENDING_BIT)
+                    pendingSlots[slot.denseIndex & ~PENDING_BIT] = SubscriptionHandle::INVALID_INDEX;
+                else
+                {
+                    listenerSlots[slot.denseIndex] = SubscriptionHandle::INVALID_INDEX;
+                    ++tombstoneCount;
+                }
+
+                slot.denseIndex = SubscriptionHandle::INVALID_INDEX;
+                ++slot.generation;
+                freeSlots.push_back(handle.index);
+
+                // Keep the dense array from filling up with tombstones when nobody flushes
+                if (tombstoneCount > listenerSlots.size() / 2)
+                    Compact();
+                return true;
+            }
+
+            [[nodiscard]] bool Contains(const SubscriptionHandle& handle) const
+            {
+                return handle.index < slots.size()
+                       && slots[handle.index].generation == handle.generation
+                       && slots[handle.index].denseIndex != SubscriptionHandle::INVALID_INDEX;
+            }
+
+            /// @brief Removes tombstoned listeners while preserving the order of the live ones.
+            virtual void Compact() = 0;
+
+        protected:
+            static constexpr UInt32 PENDING_BIT = 1u << 31;
+
+            struct Slot
+            {
+                UInt32 denseIndex = SubscriptionHandle::INVALID_INDEX;
+                UInt32 generation = 0;
+            };
+
+            UInt32 AllocateSlot()
+            {
+                if (freeSlots.empty())
+                {
+                    slots.push_back({});
+                    return static_cast<UInt32>(slots.size() - 1);
+                }
+                const UInt32 slotIndex = freeSlots.back();
+                freeSlots.pop_back();
+                return slotIndex;
+            }
+
+            /// @brief Slot index of each dense listener, INVALID_INDEX for tombstones.
+            std::vector<UInt32> listenerSlots;
+            /// @brief Priority of each dense listener, in descending order.
+            std::vector<Int32> listenerPriorities;
+            /// @brief Slot and priority of each listener subscribed during dispatch.
+            std::vector<UInt32> pendingSlots;
+            std::vector<Int32> pendingPriorities;
+            /// @brief Maps handle indices to dense indices.
+            std::vector<Slot> slots;
+            std::vector<UInt32> freeSlots;
+            Size tombstoneCount = 0;
+            UInt32 dispatchDepth = 0;
+
+            /// @brief Raises the dispatch depth for its lifetime, so a throwing listener does not leave it
+            /// raised and block compaction and merging of later subscriptions for good.
+            struct DispatchScope
+            {
+                explicit DispatchScope(UInt32& depth) noexcept
+                        : depth(depth)
+                { ++depth; }
+
+                ~DispatchScope()
+                { --depth; }
+
+                DispatchScope(const DispatchScope&) = delete;
+                DispatchScope& operator=(const DispatchScope&) = delete;
+
+                UInt32& depth;
+            };
+        };
+
+        /// @brief Typed listener array of a single event type.
+        ///
+        /// Listeners are stored as StaticDelegate<void(const EventType&)>, type erasure only happens
+        /// at the container level, so dispatch calls a correctly typed invoker per listener.
+        template<typename EventType>
+        class ListenerList : public ListenerListBase
+        {
+        public:
+            using ListenerVector = Util::DelegateVector<Listener<EventType>>;
+
+            SubscriptionHandle Add(UInt64 eventTypeID, Listener<EventType>&& listener, Int32 priority)
+            {
+                const UInt32 slotIndex = AllocateSlot();
+                if (dispatchDepth > 0)
+                {
+                    slots[slotIndex].denseIndex = PENDING_BIT | static_cast<UInt32>(pending.GetSize());
+                    pending.PushBack(std::move(listener));
+                    pendingSlots.push_back(slotIndex);
+                    pendingPriorities.push_back(priority);
+                } else
+                {
+                    Insert(std::move(listener), slotIndex, priority);
+                }
+                return {eventTypeID, slotIndex, slots[slotIndex].generation};
+            }
+
+            void Dispatch(const EventType& event)
+            {
+                {
+                    const DispatchScope scope(dispatchDepth);
+                    const Size count = listeners.GetSize();
+                    for (Size i = 0; i < count; ++i)
+                    {
+                        if (listenerSlots[i] == SubscriptionHandle::INVALID_INDEX)
+                            continue;
+                        listeners[i](event);
+                        if constexpr (std::is_base_of_v<Events::ConsumableEvent, EventType>)
+                        {
+                            if (event.IsConsumed())
+                                break;
+                        }
+                    }
+                }
+                if (dispatchDepth == 0 && !pending.IsEmpty())
+                    MergePending();
+            }
+
+            void Compact() override
+            {
+                if (dispatchDepth > 0 || tombstoneCount == 0)
+                    return;
+
+                Size write = 0;
+                for (Size read = 0; read < listeners.GetSize(); ++read)
+                {
+                    const UInt32 slotIndex = listenerSlots[read];
+                    if (slotIndex == SubscriptionHandle::INVALID_INDEX)
+                        continue;
+                    if (write != read)
+                        listeners[write] = std::move(listeners[read]);
+                    listenerSlots[write] = slotIndex;
+                    listenerPriorities[write] = listenerPriorities[read];
+                    slots[slotIndex].denseIndex = static_cast<UInt32>(write);
+                    ++write;
+                }
+                listeners.Truncate(write);
+                listenerSlots.resize(write);
+                listenerPriorities.resize(write);
+                tombstoneCount = 0;
+            }
+
+        private:
+            /// @brief Inserts a listener after all listeners with greater or equal priority.
+            void Insert(Listener<EventType>&& listener, UInt32 slotIndex, Int32 priority)
+            {
+                // Common case, equal or lower priority than everything subscribed so far
+                if (listenerPriorities.empty() || listenerPriorities.back() >= priority)
+                {
+                    slots[slotIndex].denseIndex = static_cast<UInt32>(listeners.GetSize());
+                    listeners.PushBack(std::move(listener));
+                    listenerSlots.push_back(slotIndex);
+                    listenerPriorities.push_back(priority);
+                    return;
+                }
+
+                const auto position = static_cast<Size>(std::upper_bound(listenerPriorities.begin(), listenerPriorities.end(),
+                                                                         priority, std::greater<>()) - listenerPriorities.begin());
+
+                listeners.Insert(position, std::move(listener));
+                listenerSlots.insert(listenerSlots.begin() + static_cast<std::ptrdiff_t>(position), slotIndex);
+                listenerPriorities.insert(listenerPriorities.begin() + static_cast<std::ptrdiff_t>(position), priority);
+                for (Size i = position; i < listenerSlots.size(); ++i)
+                {
+                    if (listenerSlots[i] != SubscriptionHandle::INVALID_INDEX)
+                        slots[listenerSlots[i]].denseIndex = static_cast<UInt32>(i);
+                }
+            }
+
+            void MergePending()
+            {
+                for (Size i = 0; i < pending.GetSize(); ++i)
+                {
+                    const UInt32 slotIndex = pendingSlots[i];
+                    if (slotIndex == SubscriptionHandle::INVALID_INDEX)
+                        continue;
+                    Insert(std::move(pending[i]), slotIndex, pendingPriorities[i]);
+                }
+                pending.Clear();
+                pendingSlots.clear();
+                pendingPriorities.clear();
+            }
+
+            /// @brief Live and tombstoned listeners, in dispatch order.
+            ListenerVector listeners;
+            /// @brief Listeners subscribed during dispatch, waiting to be appended.
+            ListenerVector pending;
+        };
+
+        template<typename EventType>
+        ListenerList<EventType>& GetListenerList()
+        {
+            constexpr auto eventTypeIndex = Meta::TypeID<EventType>();
+            auto& listenerList = listenersMap[eventTypeIndex];
+            if (!listenerList)
+                listenerList = CreateScope<ListenerList<EventType>>();
+            return static_cast<ListenerList<EventType>&>(*listenerList);
+        }
+
+        struct CoalescerBase
+        {
+            virtual ~CoalescerBase() = default;
+        };
+
+        /// @brief Holds the queued event of a coalesced type until the queue reaches it.
+        template<typename EventType>
+        struct Coalescer : CoalescerBase
+        {
+            CoalescePolicy policy = CoalescePolicy::None;
+            std::optional<StaticDelegate<void(EventType&, const EventType&)>> merge;
+            std::optional<EventType> pendingEvent;
+        };
+
+        template<typename EventType>
+        Coalescer<EventType>& GetCoalescer()
+        {
+            constexpr auto eventTypeIndex = Meta::TypeID<EventType>();
+            auto& coalescer = coalescersMap[eventTypeIndex];
+            // Never replaced once created, queued events refer to it
+            if (!coalescer)
+                coalescer = CreateScope<Coalescer<EventType>>();
+            return static_cast<Coalescer<EventType>&>(*coalescer);
+        }
+
+        /// @brief Queues or merges an event of a coalesced type.
+        /// @return False if the type is not coalesced and the event must be queued normally.
+        template<typename EventType>
+        bool Enqueue(Coalescer<EventType>& coalescer, EventType&& event)
+        {
+            if (coalescer.policy == CoalescePolicy::None)
+                return false;
+
+            if (!coalescer.pendingEvent)
+            {
+                coalescer.pendingEvent.emplace(std::move(event));
+                eventQueue.push_back([this, &coalescer]()
+                                     {
+                                         EventType pendingEvent = std::move(*coalescer.pendingEvent);
+                                         coalescer.pendingEvent.reset();
+                                         Dispatch<EventType>(pendingEvent);
+                                     });
+                return true;
+            }
+
+            switch (coalescer.policy)
+            {
+                case CoalescePolicy::KeepLatest:
+                    coalescer.pendingEvent.emplace(std::move(event));
+                    break;
+                case CoalescePolicy::Sum:
+                    if constexpr (SummableEvent<EventType>)
+                        *coalescer.pendingEvent += event;
+                    break;
+                case CoalescePolicy::Custom:
+                    (*coalescer.merge)(*coalescer.pendingEvent, event);
+                    break;
+                default:
+                    break;
+            }
+            return true;
+        }
+
+        template<typename EventType>
+        void Dispatch(const EventType& event)
+        {
+            constexpr auto eventTypeIndex = Meta::TypeID<EventType>();
+            auto it = listenersMap.find(eventTypeIndex);
+            if (it != listenersMap.end())
+                static_cast<ListenerList<EventType>&>(*it->second).Dispatch(event);
+        }
 
         /// @brief Map of event listeners indexed by event type.
-        std::unordered_map<UInt64, EventVector> listenersMap;
+        std::unordered_map<UInt64, Scope<ListenerListBase>> listenersMap;
+        /// @brief Coalescing state of event types with a CoalescePolicy, indexed by event type.
+        std::unordered_map<UInt64, Scope<CoalescerBase>> coalescersMap;
         /// @brief Queue for events to be processed later.
         std::deque<QueuedEvent> eventQueue;
     };
 
-}
\ No newline at end of file
+}
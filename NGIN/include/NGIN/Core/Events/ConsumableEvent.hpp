@@ -0,0 +1,21 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+
+namespace NGIN::Core::Events
+{
+    /// Base for events whose propagation can be stopped by a listener.
+    /// Listeners receive events as const references, consuming therefore only touches a mutable flag.
+    struct ConsumableEvent
+    {
+        /// Stops the event from reaching any listener with a lower priority.
+        void Consume() const noexcept
+        { consumed = true; }
+
+        [[nodiscard]] Bool IsConsumed() const noexcept
+        { return consumed; }
+
+    private:
+        mutable Bool consumed = false;
+    };
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+
+namespace NGIN::Core
+{
+    /// \class FixedTimestep
+    /// \brief Accumulates variable frame time into a whole number of fixed steps.
+    ///
+    /// Simulation advanced in fixed steps gives the same result regardless of frame rate. The time left
+    /// over after the last whole step is exposed as an interpolation alpha in [0, 1), so rendering can
+    /// blend between the previous and current simulation state.
+    class FixedTimestep
+    {
+    public:
+        /// \param step Length of a step in seconds, 0 disables fixed stepping.
+        /// \param maxStepsPerFrame Upper bound of steps per frame, time beyond it is dropped so a slow
+        /// frame cannot cause ever more steps in the frames after it.
+        explicit FixedTimestep(F64 step = 0.0, UInt32 maxStepsPerFrame = 8) noexcept
+                : step(step), maxStepsPerFrame(maxStepsPerFrame)
+        {}
+
+        /// \brief Adds frame time and returns the number of steps to run this frame.
+        UInt32 Advance(F64 deltaTime) noexcept
+        {
+            if (step <= 0.0)
+                return 0;
+
+            accumulator += deltaTime;
+            UInt32 steps = 0;
+            while (accumulator >= step && steps < maxStepsPerFrame)
+            {
+                accumulator -= step;
+                ++steps;
+            }
+
+            if (accumulator >= step)
+                accumulator = 0.0;
+            return steps;
+        }
+
+        /// \brief Fraction of a step accumulated but not yet simulated.
+        [[nodiscard]] F64 GetAlpha() const noexcept
+        { return step > 0.0 ? accumulator / step : 0.0; }
+
+        [[nodiscard]] F64 GetStep() const noexcept
+        { return step; }
+
+        [[nodiscard]] UInt32 GetMaxStepsPerFrame() const noexcept
+        { return maxStepsPerFrame; }
+
+        [[nodiscard]] Bool IsEnabled() const noexcept
+        { return step > 0.0; }
+
+        void Reset() noexcept
+        { accumulator = 0.0; }
+
+    private:
+        F64 step = 0.0;
+        UInt32 maxStepsPerFrame = 8;
+        F64 accumulator = 0.0;
+    };
+}
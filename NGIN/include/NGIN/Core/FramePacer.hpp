@@ -0,0 +1,58 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+
+#include <chrono>
+
+namespace NGIN::Core
+{
+    /// \brief How the engine loop waits between frames.
+    enum class FramePacing : UInt8
+    {
+        /// \brief Start the next frame immediately.
+        Unlimited,
+        /// \brief Hold a target frame rate, sleeping most of the wait and spinning the rest for accuracy.
+        Precise,
+        /// \brief Hold a target frame rate by sleeping only, the lowest CPU use at the cost of some jitter.
+        /// Meant for headless servers and idle applications.
+        Throttled
+    };
+
+    /// \class FramePacer
+    /// \brief Paces a loop to a target frame rate and measures the time between frames.
+    ///
+    /// Frame deadlines are spaced evenly from the first frame rather than from whenever a frame ended,
+    /// so oversleeping in one frame is made up in the next. A frame running more than a whole period
+    /// late restarts the schedule instead of rushing the following frames.
+    class FramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// \brief Sets how to wait and the frame rate to wait for, ignored when Unlimited.
+        NGIN_API void SetPacing(FramePacing pacing, F64 targetFrameRate = 60.0) noexcept;
+
+        /// \brief Remaining wait below which Precise pacing spins instead of sleeping, defaults to 2 ms.
+        NGIN_API void SetSpinThreshold(F64 seconds) noexcept;
+
+        [[nodiscard]] NGIN_API FramePacing GetPacing() const noexcept;
+
+        [[nodiscard]] NGIN_API F64 GetTargetFrameRate() const noexcept;
+
+        /// \brief Starts the schedule at the current time.
+        NGIN_API void Reset();
+
+        /// \brief Waits until the next frame is due.
+        /// \return Seconds since the previous frame started.
+        NGIN_API F64 WaitForNextFrame();
+
+    private:
+        FramePacing pacing = FramePacing::Unlimited;
+        F64 targetFrameRate = 60.0;
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<F64>(1.0 / 60.0));
+        Clock::duration spinThreshold = std::chrono::milliseconds(2);
+
+        Clock::time_point frameStart = Clock::now();
+        Clock::time_point deadline = frameStart;
+    };
+}
@@ -17,9 +17,14 @@ namespace NGIN::Core
     {
     public:
         friend class Engine;
+        friend class ModuleScheduler;
 
         using Dependencies = Meta::TypeWrapper<void>;
 
+        /// \brief Set to true in modules that must tick on the thread running Engine::Tick,
+        /// e.g. modules pumping platform events.
+        static constexpr Bool MainThreadOnly = false;
+
         Module() = default;
 
         virtual ~Module() = default;
@@ -29,6 +34,9 @@ namespace NGIN::Core
 
         NGIN_API virtual void OnShutdown() {}
 
+        /// \brief Called zero or more times per frame with a constant step when the engine runs a fixed timestep.
+        NGIN_API virtual void OnFixedTick(const F64 fixedDeltaTime) {}
+
         NGIN_API virtual void OnPreTick(const F64 deltaTime) {}
 
         NGIN_API virtual void OnTick(const F64 deltaTime) {}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Async/JobSystem.hpp>
+#include "Module.hpp"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace NGIN::Core
+{
+    /// \brief The tick phases of a module, run one after another for all modules.
+    enum class TickPhase : UInt8
+    {
+        FixedTick,
+        PreTick,
+        Tick,
+        PostTick
+    };
+
+    class TickProfiler;
+
+    /// \class ModuleScheduler
+    /// \brief Runs the tick phases of the engine modules, in parallel where their dependencies allow it.
+    ///
+    /// Modules form a DAG through their declared dependencies. Within a phase a module starts once every
+    /// module it depends on has finished that phase, so independent modules tick concurrently as jobs of
+    /// the job system. Phases act as barriers: no module starts OnTick before every module finished OnPreTick.
+    ///
+    /// Without a job system, or with a single module, modules run serially on the calling thread in
+    /// registration order. Registration order is always a valid topological order since dependencies are
+    /// added before their dependents, so serial ticking is deterministic and useful for debugging.
+    class ModuleScheduler
+    {
+    public:
+        /// \brief Adds a module to the graph.
+        /// \param module The module, must outlive the scheduler.
+        /// \param dependencies Registration indices of the modules it depends on, all already added.
+        /// \param mainThreadOnly True if the module must tick on the main thread of the job system.
+        NGIN_API void AddModule(Module* module, const std::vector<UInt32>& dependencies, Bool mainThreadOnly);
+
+        /// \brief Runs one phase for every module and waits for all of them to finish.
+        /// Rethrows the first exception thrown by a module once the phase is done.
+        /// Must be called from the main thread of the job system, which helps running jobs while it waits.
+        /// \param jobSystem Job system to run modules on, or nullptr to run serially.
+        NGIN_API void RunPhase(TickPhase phase, F64 deltaTime, Async::JobSystem* jobSystem);
+
+        [[nodiscard]] NGIN_API Size GetModuleCount() const noexcept;
+
+        /// \brief Times every module phase into a profiler, nullptr to stop profiling.
+        /// \param profiler Profiler with the same modules added in the same order.
+        NGIN_API void SetProfiler(TickProfiler* profiler) noexcept;
+
+    private:
+        struct Node
+        {
+            Module* module = nullptr;
+            /// \brief Registration indices of the modules depending on this one.
+            std::vector<UInt32> dependents;
+            UInt32 dependencyCount = 0;
+            Bool mainThreadOnly = false;
+        };
+
+        std::vector<Node> nodes;
+
+        /// \brief Unfinished dependencies of each node in the running phase.
+        Scope<std::atomic<UInt32>[]> remainingDependencies;
+
+        /// \brief State of the running phase, kept here so node jobs only capture their index.
+        TickPhase currentPhase = TickPhase::PreTick;
+        F64 currentDeltaTime = 0.0;
+        Async::JobSystem* currentJobSystem = nullptr;
+        Async::JobCounter phaseCounter;
+
+        std::mutex exceptionMutex;
+        std::exception_ptr firstException;
+
+        TickProfiler* profiler = nullptr;
+
+        static void RunModule(Module* module, TickPhase phase, F64 deltaTime);
+
+        /// \brief Runs a module phase, timing it if profiling.
+        void RunProfiled(UInt32 index, TickPhase phase, F64 deltaTime);
+
+        /// \brief Runs a node and schedules the dependents it unblocks.
+        void RunNode(UInt32 index);
+
+        void Schedule(UInt32 index);
+    };
+}
@@ -20,6 +20,9 @@ namespace NGIN::Core
 
         using Dependencies = Meta::TypeWrapper<WindowModule>;
 
+        /// The graphics context presents to the window, which belongs to the main thread.
+        static constexpr Bool MainThreadOnly = true;
+
     protected:
         NGIN_API void OnInit(Engine* engine) override;
 
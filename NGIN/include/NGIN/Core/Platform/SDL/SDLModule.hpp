@@ -12,6 +12,9 @@ namespace NGIN::Core
     class SDLModule : public Module
     {
     public:
+        /// SDL events must be pumped on the thread that initialized the video subsystem.
+        static constexpr Bool MainThreadOnly = true;
+
     protected:
         NGIN_API void OnInit(Engine* engine) override;
 
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Core/ECS/Entity.hpp>
+
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace NGIN::Core
+{
+    /// \brief Component giving an entity with a transform a bounding sphere in the spatial index.
+    ///
+    /// The radius is scaled by the largest axis scale of the entity's world matrix. Entities with a
+    /// transform but without this component are indexed as points.
+    struct SpatialBounds
+    {
+        F32 radius = 0.0f;
+    };
+
+    enum class SpatialIndexKind
+    {
+        /// \brief Unbounded uniform grid of hashed cells, best for evenly sized objects spread over a large area.
+        HashGrid,
+        /// \brief Loose octree over a fixed region, best for objects of very different sizes.
+        LooseOctree,
+    };
+
+    struct SpatialIndexSettings
+    {
+        SpatialIndexKind kind = SpatialIndexKind::HashGrid;
+        /// \brief Edge length of a hash grid cell, ideally around the typical query radius.
+        F32 cellSize = 8.0f;
+        /// \brief Center and half edge length of the octree root, entries outside it live in the root.
+        glm::vec3 octreeCenter = glm::vec3(0.0f);
+        F32 octreeHalfSize = 1024.0f;
+        /// \brief Depth of the smallest octree nodes.
+        UInt32 octreeMaxDepth = 10;
+    };
+
+    struct SpatialSphere
+    {
+        glm::vec3 center;
+        F32 radius;
+    };
+
+    struct SpatialBox
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    /// \brief Results of a batch of queries, the entities found by query i are Get(i).
+    struct SpatialQueryResults
+    {
+        std::vector<ECS::Entity> entities;
+        /// \brief Start of the results of each query in entities, plus the total count.
+        std::vector<UInt32> offsets;
+
+        [[nodiscard]] Size GetQueryCount() const noexcept
+        { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+        [[nodiscard]] std::span<const ECS::Entity> Get(Size query) const noexcept
+        { return std::span<const ECS::Entity>(entities).subspan(offsets[query], offsets[query + 1] - offsets[query]); }
+
+        void Clear() noexcept
+        {
+            entities.clear();
+            offsets.assign(1, 0);
+        }
+    };
+
+    /// \class SpatialIndex
+    /// \brief Bounding spheres of entities, indexed for radius, box overlap and nearest neighbour queries.
+    ///
+    /// Queries are batched: every query of a batch runs against the index in one call and appends to one
+    /// result buffer, so callers with many queries per frame avoid per-query dispatch and allocations.
+    /// Running queries concurrently is safe, modifying the index while querying is not.
+    class SpatialIndex
+    {
+    public:
+        virtual ~SpatialIndex() = default;
+
+        /// \brief Adds an entity or moves it if it is already indexed.
+        virtual void Set(ECS::Entity entity, glm::vec3 center, F32 radius) = 0;
+
+        /// \return False if the entity was not indexed.
+        virtual Bool Remove(ECS::Entity entity) = 0;
+
+        [[nodiscard]] virtual Bool Contains(ECS::Entity entity) const noexcept = 0;
+
+        [[nodiscard]] virtual Size GetCount() const noexcept = 0;
+
+        /// \brief Finds the entities whose sphere intersects each query sphere, replacing the results.
+        virtual void QueryRadius(std::span<const SpatialSphere> queries, SpatialQueryResults& results) const = 0;
+
+        /// \brief Finds the entities whose sphere intersects each query box, replacing the results.
+        virtual void QueryBox(std::span<const SpatialBox> queries, SpatialQueryResults& results) const = 0;
+
+        /// \brief Finds the entity whose center is closest to each point, an invalid entity if none is
+        /// within maxDistance.
+        /// \param nearest Receives one entity per point, must be as large as points.
+        virtual void FindNearest(std::span<const glm::vec3> points, F32 maxDistance, std::span<ECS::Entity> nearest) const = 0;
+
+        /// \brief Single query convenience over QueryRadius, appends to out.
+        NGIN_API void QueryRadius(glm::vec3 center, F32 radius, std::vector<ECS::Entity>& out) const;
+
+        /// \brief Single query convenience over QueryBox, appends to out.
+        NGIN_API void QueryBox(glm::vec3 min, glm::vec3 max, std::vector<ECS::Entity>& out) const;
+
+        /// \brief Single query convenience over FindNearest.
+        [[nodiscard]] NGIN_API ECS::Entity FindNearest(glm::vec3 point, F32 maxDistance = std::numeric_limits<F32>::infinity()) const;
+    };
+
+    /// \brief Creates the spatial index of the kind the settings select.
+    /// \throws std::invalid_argument if the cell size or octree size is not positive.
+    [[nodiscard]] NGIN_API Scope<SpatialIndex> CreateSpatialIndex(const SpatialIndexSettings& settings = {});
+}
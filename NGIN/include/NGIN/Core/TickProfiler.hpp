@@ -0,0 +1,82 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include "ModuleScheduler.hpp"
+
+#include <vector>
+
+namespace NGIN::Core
+{
+    /// \brief Timing statistics over the recent samples of one module phase, in seconds.
+    struct TickStats
+    {
+        F64 p50 = 0.0;
+        F64 p99 = 0.0;
+        F64 max = 0.0;
+        F64 mean = 0.0;
+        UInt32 sampleCount = 0;
+    };
+
+    /// \class TickProfiler
+    /// \brief Records how long every module spends in each tick phase.
+    ///
+    /// Each module phase keeps a rolling window of its most recent samples, statistics are computed from
+    /// the window on request, so recording stays a single store. A module phase is only ever run by one
+    /// thread at a time, so recording needs no synchronization even when modules tick in parallel. Reading
+    /// statistics must not overlap a running phase, the engine reads them between frames.
+    class TickProfiler
+    {
+    public:
+        static constexpr UInt32 PHASE_COUNT = static_cast<UInt32>(TickPhase::PostTick) + 1;
+
+        /// \param windowSize Number of most recent samples statistics are computed from.
+        NGIN_API explicit TickProfiler(UInt32 windowSize = 256);
+
+        /// \brief Adds a module, modules are identified by their registration index.
+        NGIN_API void AddModule(StringView name);
+
+        /// \brief Records one run of a module phase.
+        NGIN_API void Record(UInt32 moduleIndex, TickPhase phase, F64 seconds) noexcept;
+
+        /// \brief Records the time spent in one frame, pacing excluded.
+        NGIN_API void RecordFrame(F64 seconds) noexcept;
+
+        [[nodiscard]] NGIN_API TickStats GetStats(UInt32 moduleIndex, TickPhase phase) const;
+
+        [[nodiscard]] NGIN_API TickStats GetFrameStats() const;
+
+        [[nodiscard]] NGIN_API Size GetModuleCount() const noexcept;
+
+        [[nodiscard]] NGIN_API const String& GetModuleName(UInt32 moduleIndex) const;
+
+        /// \brief Discards every sample.
+        NGIN_API void Clear() noexcept;
+
+        /// \brief Human readable table of the statistics, one line per module phase, in milliseconds.
+        [[nodiscard]] NGIN_API String ToString() const;
+
+        /// \brief The statistics as a JSON object, in milliseconds.
+        [[nodiscard]] NGIN_API String ToJSON() const;
+
+        [[nodiscard]] NGIN_API static StringView GetPhaseName(TickPhase phase) noexcept;
+
+    private:
+        /// \brief Ring buffer of the most recent samples in nanoseconds.
+        struct Window
+        {
+            std::vector<UInt64> samples;
+            UInt32 next = 0;
+            UInt32 count = 0;
+
+            void Add(UInt64 nanoseconds) noexcept;
+
+            [[nodiscard]] TickStats ComputeStats() const;
+        };
+
+        UInt32 windowSize;
+        std::vector<String> moduleNames;
+        /// \brief PHASE_COUNT windows per module.
+        std::vector<Window> windows;
+        Window frameWindow;
+    };
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Core/ECS/Entity.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace NGIN::Core
+{
+    /// \brief Position, rotation and scale relative to the parent, applied as translate * rotate * scale.
+    struct Transform
+    {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec3 scale = glm::vec3(1.0f);
+    };
+
+    /// \class TransformHierarchy
+    /// \brief Parent/child transforms of entities, stored breadth-first by depth.
+    ///
+    /// Nodes live in contiguous arrays ordered level by level: the roots first, then their children,
+    /// then the grandchildren, with the children of a node adjacent. Update walks the levels in order,
+    /// so a parent's world matrix is always final before its children read it, and every level is a
+    /// flat batch of 4x4 multiplies run with SIMD.
+    ///
+    /// Only dirty subtrees are propagated: changing a local transform or a parent marks the node, and
+    /// Update recomputes the marked nodes and everything below them. Each level only scans the span of
+    /// its marked nodes joined with the children of the nodes updated in the level above, so moving a
+    /// leaf costs one multiply per level rather than a pass over the hierarchy. Levels inheriting nothing
+    /// skip clean runs of flags a word at a time, for few scattered nodes moving. Structural changes are
+    /// applied lazily, the breadth-first order is rebuilt once by the next Update.
+    ///
+    /// The hierarchy is not thread-safe.
+    class TransformHierarchy
+    {
+    public:
+        /// \brief Adds a node for an entity, as a root or below a parent.
+        /// \throws std::invalid_argument if the entity is invalid or already has a node, or the parent has none.
+        NGIN_API void Add(ECS::Entity entity, const Transform& local = {}, ECS::Entity parent = {});
+
+        /// \brief Removes an entity's node, its children become roots keeping their local transforms.
+        /// \return False if the entity has no node.
+        NGIN_API Bool Remove(ECS::Entity entity);
+
+        [[nodiscard]] NGIN_API Bool Contains(ECS::Entity entity) const noexcept;
+
+        /// \brief Moves a node below another, or makes it a root if parent is invalid.
+        /// \throws std::invalid_argument if either has no node, or the parent is the node or one of its descendants.
+        NGIN_API void SetParent(ECS::Entity entity, ECS::Entity parent);
+
+        /// \brief Parent of a node, an invalid entity for roots.
+        /// \throws std::invalid_argument if the entity has no node.
+        [[nodiscard]] NGIN_API ECS::Entity GetParent(ECS::Entity entity) const;
+
+        /// \throws std::invalid_argument if the entity has no node.
+        NGIN_API void SetLocal(ECS::Entity entity, const Transform& local);
+
+        /// \throws std::invalid_argument if the entity has no node.
+        [[nodiscard]] NGIN_API const Transform& GetLocal(ECS::Entity entity) const;
+
+        /// \brief World matrix of a node as of the last Update.
+        /// \throws std::invalid_argument if the entity has no node.
+        [[nodiscard]] NGIN_API const glm::mat4& GetWorldMatrix(ECS::Entity entity) const;
+
+        /// \brief Restores the breadth-first order if the structure changed, then recomputes the world
+        /// matrices of the dirty subtrees.
+        NGIN_API void Update();
+
+        [[nodiscard]] Size GetCount() const noexcept
+        { return entities.size(); }
+
+        /// \brief Entities with a node, in node order.
+        [[nodiscard]] std::span<const ECS::Entity> GetEntities() const noexcept
+        { return entities; }
+
+        /// \brief Number of depth levels as of the last Update.
+        [[nodiscard]] Size GetDepthCount() const noexcept
+        { return levelStarts.empty() ? 0 : levelStarts.size() - 1; }
+
+        /// \brief Number of nodes whose world matrix was recomputed by the last Update.
+        [[nodiscard]] Size GetUpdatedCount() const noexcept
+        { return updatedEntities.size(); }
+
+        /// \brief Entities whose world matrix was recomputed by the last Update, parents before children.
+        [[nodiscard]] std::span<const ECS::Entity> GetUpdatedEntities() const noexcept
+        { return updatedEntities; }
+
+        /// \brief Entities whose node was removed between the last two Updates.
+        [[nodiscard]] std::span<const ECS::Entity> GetRemovedEntities() const noexcept
+        { return removedEntities; }
+
+    private:
+        static constexpr UInt32 NO_NODE = std::numeric_limits<UInt32>::max();
+
+        /// \brief Node indices [begin, end) of one level holding its dirty nodes, empty if begin >= end.
+        struct NodeRange
+        {
+            UInt32 begin = NO_NODE;
+            UInt32 end = 0;
+        };
+
+        // Node arrays, in breadth-first order while ordered is set
+        std::vector<ECS::Entity> entities;
+        /// \brief Parent entity of each node, kept as a handle so reordering needs no remapping.
+        std::vector<ECS::Entity> parents;
+        std::vector<Transform> locals;
+        std::vector<glm::mat4> localMatrices;
+        std::vector<glm::mat4> worldMatrices;
+        /// \brief 1 if the node's own transform or parent changed, 2 if only an ancestor did.
+        std::vector<UInt8> dirty;
+        /// \brief Number of children per node, so removing a leaf skips the search for children.
+        std::vector<UInt32> childCounts;
+
+        /// \brief Node index of each entity slot, NO_NODE if the slot has none.
+        std::vector<UInt32> nodeIndices;
+
+        // Derived by Rebuild, valid while ordered is set
+        std::vector<UInt32> parentIndices;
+        std::vector<UInt32> depths;
+        /// \brief Node index the children of each node start at, increasing with the node index.
+        std::vector<UInt32> firstChildren;
+        /// \brief Node index each level starts at, plus the node count.
+        std::vector<UInt32> levelStarts;
+        /// \brief Span of the nodes marked dirty per level.
+        std::vector<NodeRange> dirtyRanges;
+
+        /// \brief Shallowest level holding a dirty node, the level count if none.
+        UInt32 firstDirtyLevel = 0;
+        Bool ordered = true;
+
+        std::vector<ECS::Entity> updatedEntities;
+        std::vector<ECS::Entity> removedEntities;
+        /// \brief Removals since the last Update, published as removedEntities by the next one.
+        std::vector<ECS::Entity> pendingRemovals;
+
+        // Scratch of Rebuild and Update, kept to reuse its memory
+        std::vector<UInt32> order;
+        std::vector<UInt32> childStarts;
+        std::vector<UInt32> children;
+        std::vector<UInt32> batch;
+
+        /// \brief Node index of an entity, NO_NODE if it has no node.
+        [[nodiscard]] UInt32 FindNode(ECS::Entity entity) const noexcept;
+
+        /// \brief Node index of an entity.
+        /// \throws std::invalid_argument if the entity has no node.
+        [[nodiscard]] UInt32 GetNode(ECS::Entity entity) const;
+
+        void MarkDirty(UInt32 node) noexcept;
+
+        /// \brief Sorts the nodes breadth-first and derives parent indices, depths and levels.
+        void Rebuild();
+
+        template<typename T>
+        void Permute(std::vector<T>& values);
+    };
+}
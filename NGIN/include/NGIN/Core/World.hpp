@@ -1,20 +1,427 @@
 #pragma once
 
 #include <NGIN/Defines.hpp>
+#include <NGIN/Core/ECS/Archetype.hpp>
+#include <NGIN/Core/ECS/Chunk.hpp>
+#include <NGIN/Core/ECS/CommandBuffer.hpp>
+#include <NGIN/Core/ECS/Component.hpp>
+#include <NGIN/Core/ECS/Entity.hpp>
+#include <NGIN/Core/ECS/Query.hpp>
+#include <NGIN/Core/ECS/SparseSet.hpp>
+#include <NGIN/Core/ECS/System.hpp>
+#include <NGIN/Core/ECS/SystemScheduler.hpp>
+#include <NGIN/Core/SpatialIndex.hpp>
+#include <NGIN/Core/TransformHierarchy.hpp>
+#include <NGIN/Meta/TypeMap.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace NGIN::Core
 {
-    //Contains all the data for the game world, including ECS, WorldData, scenegraph, etc.
+    class WorldSnapshot;
+
+    /// \class World
+    /// \brief Archetype based entity component storage.
+    ///
+    /// Every entity lives in the archetype matching its exact set of component types, so iterating the
+    /// entities having some components walks contiguous component columns chunk by chunk. Adding or
+    /// removing a component moves the entity to another archetype.
+    ///
+    /// Components declared with ECS::ComponentStorage::SparseSet are kept out of the archetypes in one
+    /// ECS::SparseSet per type instead, so adding and removing them is O(1) without moving the entity.
+    /// Queries join them with the matched chunks per entity, and they are not change tracked.
+    ///
+    /// Structural changes (creating or destroying entities, adding or removing components) invalidate
+    /// component references and must not happen while iterating with Each.
+    ///
+    /// Changes are detected per chunk and component column with a monotonic change tick: mutable access
+    /// through queries, GetComponent, AddComponent and entity creation stamp the touched chunk columns,
+    /// and queries with Changed<T> or Added<T> filters skip the chunks not stamped after a given tick.
+    ///
+    /// The parent/child transforms of entities live in a TransformHierarchy owned by the world, destroying
+    /// an entity removes its transform. Every entity with a transform is kept in the world's SpatialIndex at
+    /// its world position, with the radius of its SpatialBounds component if it has one.
+    ///
+    /// A world is saved and restored as a whole with WorldSnapshot.
     class World
     {
     public:
-        World();
+        /// \param spatialIndexSettings Kind and dimensions of the world's spatial index.
+        /// \throws std::invalid_argument if the spatial index settings are invalid.
+        NGIN_API explicit World(const SpatialIndexSettings& spatialIndexSettings = {});
+
+        NGIN_API ~World();
+
+        World(const World&) = delete;
+
+        World& operator=(const World&) = delete;
+
+        /// \brief Creates an entity without components.
+        NGIN_API ECS::Entity CreateEntity();
+
+        /// \brief Creates an entity with the given components.
+        template<ECS::IsComponent... Ts>
+        requires (sizeof...(Ts) > 0)
+        ECS::Entity CreateEntity(Ts... components)
+        {
+            static_assert(ECS::AreDistinctComponents<Ts...>(), "CreateEntity requires distinct component types.");
+
+            constexpr Size TABLE_COUNT = ((IS_TABLE<Ts> ? 1 : 0) + ...);
+            std::array<const ECS::ComponentInfo*, TABLE_COUNT> infos = {};
+            Size i = 0;
+            ((IS_TABLE<Ts> ? (void) (infos[i++] = &ECS::GetComponentInfo<Ts>()) : (void) 0), ...);
+            std::sort(infos.begin(), infos.end(), IS_ORDERED_BY_ID);
+
+            const UInt32 archetypeIndex = GetOrCreateArchetype(infos);
+            ECS::Archetype& archetype = *archetypes[archetypeIndex];
+            const ECS::Entity entity = AllocateEntity(archetypeIndex);
+            const ECS::Archetype::Location location = records[entity.GetIndex()].location;
+
+            ([&]
+             {
+                 if constexpr (IS_TABLE<Ts>)
+                     ::new(archetype.GetComponent(archetype.FindColumn(ECS::ComponentID<Ts>()), location)) Ts(std::move(components));
+             }(), ...);
+            if constexpr (TABLE_COUNT != sizeof...(Ts))
+            {
+                try
+                {
+                    ([&]
+                     {
+                         if constexpr (!IS_TABLE<Ts>)
+                             ::new(GetOrCreateSparseSet(ECS::GetComponentInfo<Ts>()).Emplace(entity)) Ts(std::move(components));
+                     }(), ...);
+                } catch (...)
+                {
+                    DestroyEntity(entity);
+                    throw;
+                }
+            }
+            return entity;
+        }
+
+        /// \brief Destroys an entity and all its components, does nothing if it is not alive.
+        ///
+        /// The entity's slot is recycled for a later entity with a bumped generation, so the handle
+        /// of the destroyed entity stays invalid.
+        NGIN_API void DestroyEntity(ECS::Entity entity);
+
+        /// \brief True if the handle refers to an entity that has not been destroyed, O(1) without hashing.
+        [[nodiscard]] NGIN_API Bool IsAlive(ECS::Entity entity) const noexcept;
+
+        /// \brief Adds a component to an entity, replacing it if the entity already has one.
+        /// \return Reference to the added component, valid until the next structural change.
+        /// \throws std::invalid_argument if the entity is not alive.
+        template<ECS::IsComponent T, typename... Args>
+        T& AddComponent(ECS::Entity entity, Args&& ... args)
+        {
+            // Construct first so a throwing constructor leaves the entity untouched
+            T component(std::forward<Args>(args)...);
+
+            if (T* existing = TryGetComponent<T>(entity))
+            {
+                existing->~T();
+                return *::new(existing) T(std::move(component));
+            }
+            return *::new(AddComponentStorage(entity, ECS::GetComponentInfo<T>())) T(std::move(component));
+        }
+
+        /// \brief Removes a component from an entity.
+        /// \return False if the entity is not alive or does not have the component.
+        template<ECS::IsComponent T>
+        Bool RemoveComponent(ECS::Entity entity)
+        {
+            if constexpr (IS_TABLE<T>)
+                return RemoveComponent(entity, ECS::ComponentID<T>());
+            else
+                return RemoveSparseComponent(entity, ECS::ComponentID<T>());
+        }
+
+        /// \brief The component of an entity, or nullptr if the entity is not alive or lacks it.
+        /// Marks the component's chunk column as changed.
+        template<ECS::IsComponent T>
+        [[nodiscard]] T* TryGetComponent(ECS::Entity entity) noexcept
+        {
+            if constexpr (IS_TABLE<T>)
+                return reinterpret_cast<T*>(FindMutableComponent(entity, ECS::ComponentID<T>()));
+            else
+                return reinterpret_cast<T*>(FindSparseComponent(entity, ECS::ComponentID<T>()));
+        }
+
+        template<ECS::IsComponent T>
+        [[nodiscard]] const T* TryGetComponent(ECS::Entity entity) const noexcept
+        {
+            if constexpr (IS_TABLE<T>)
+                return reinterpret_cast<const T*>(FindComponent(entity, ECS::ComponentID<T>()));
+            else
+                return reinterpret_cast<const T*>(FindSparseComponent(entity, ECS::ComponentID<T>()));
+        }
+
+        /// \brief The component of an entity, marks the component's chunk column as changed.
+        /// \throws std::out_of_range if the entity is not alive or does not have the component.
+        template<ECS::IsComponent T>
+        [[nodiscard]] T& GetComponent(ECS::Entity entity)
+        {
+            T* component = TryGetComponent<T>(entity);
+            if (component == nullptr)
+                throw std::out_of_range("Entity does not have component " + String(ECS::GetComponentInfo<T>().name) + ".");
+            return *component;
+        }
+
+        template<ECS::IsComponent T>
+        [[nodiscard]] const T& GetComponent(ECS::Entity entity) const
+        {
+            const T* component = TryGetComponent<T>(entity);
+            if (component == nullptr)
+                throw std::out_of_range("Entity does not have component " + String(ECS::GetComponentInfo<T>().name) + ".");
+            return *component;
+        }
+
+        template<ECS::IsComponent T>
+        [[nodiscard]] Bool HasComponent(ECS::Entity entity) const noexcept
+        {
+            return TryGetComponent<T>(entity) != nullptr;
+        }
+
+        /// \brief A query over the chunks matching a component signature.
+        ///
+        /// The signature is computed at compile time from the terms. The matching archetypes are cached
+        /// per signature and extended with the archetypes created since the query was last obtained.
+        /// Obtaining a query is not thread-safe, iterating it concurrently is.
+        ///
+        /// Chunks yielded for writing are marked as changed at the current change tick.
+        /// \param sinceTick Chunks must have changed after this tick to pass ECS::Changed<T> and ECS::Added<T>
+        /// filters, usually a tick returned by AdvanceChangeTick.
+        /// \tparam Terms Components to fetch as T& or const T&, and filters like ECS::With<T>, ECS::Without<T>
+        /// and ECS::Changed<T>.
+        template<typename... Terms>
+        [[nodiscard]] ECS::Query<Terms...> Query(UInt64 sinceTick = 0)
+        {
+            using QueryType = ECS::Query<Terms...>;
+
+            typename QueryType::SparseSets sets = {};
+            for (Size i = 0; i < sets.size(); ++i)
+                sets[i] = FindSparseSet(QueryType::Traits::SPARSE_IDS[i]);
+            return QueryType(archetypes, GetQueryState<Terms...>(), sinceTick, changeTick, sets, records);
+        }
+
+        /// \brief Calls func for every entity having all the component types Ts.
+        ///
+        /// func is called as func(components...) or func(entity, components...), with a reference to each
+        /// component. Qualify a type with const to get a const reference.
+        template<typename... Ts, typename F>
+        requires (sizeof...(Ts) > 0 && (ECS::IsComponent<std::remove_cvref_t<Ts>> && ...))
+        void Each(F&& func)
+        {
+            Query<std::remove_reference_t<Ts>& ...>().ForEach(func);
+        }
+
+        /// \brief Adds a system called for every chunk matching a query, as func(chunk, deltaTime) or func(chunk).
+        ///
+        /// The system reads the components fetched as const T& and writes those fetched as T&. Systems
+        /// with disjoint writes run concurrently and chunks of one system are spread across threads, so
+        /// func must only touch the rows of the chunk it is given. It must not make structural changes.
+        /// \return Registration index of the system.
+        template<typename... Terms, typename F>
+        UInt32 AddSystem(String name, F&& func)
+        {
+            return systemScheduler.AddSystem(CreateScope<ECS::ChunkSystem<std::decay_t<F>, Terms...>>(
+                    std::move(name), GetQueryState<Terms...>(), std::forward<F>(func)));
+        }
+
+        /// \brief Adds a system that runs alone with full access to the world, as func(world, deltaTime).
+        ///
+        /// Every system added before it finishes before it starts, so it may make structural changes.
+        /// \return Registration index of the system.
+        template<typename F>
+        UInt32 AddExclusiveSystem(String name, F&& func)
+        {
+            auto run = [this, func = std::forward<F>(func)](F64 deltaTime) mutable { func(*this, deltaTime); };
+            return systemScheduler.AddSystem(CreateScope<ECS::ExclusiveSystem<decltype(run)>>(std::move(name), std::move(run)));
+        }
+
+        /// \brief The command buffer of the calling thread, for deferring structural changes to the next sync point.
+        ///
+        /// Every thread gets its own buffer the first time it asks, later calls are lock-free.
+        [[nodiscard]] NGIN_API ECS::CommandBuffer& GetCommandBuffer();
+
+        /// \brief Plays back the commands recorded in every command buffer and clears them.
+        ///
+        /// Commands are sorted by entity, then by buffer and recording order, so the changes to an entity
+        /// are applied together and it moves between archetypes at most once. Commands on entities that
+        /// are not alive are dropped, creations are applied last. Must not be called while systems run.
+        NGIN_API void FlushCommands();
+
+        /// \brief Runs every system once, flushing the command buffers after each stage, then calls UpdateTransforms.
+        /// \param jobSystem Job system to run systems concurrently on, nullptr to run them serially.
+        NGIN_API void RunSystems(F64 deltaTime, Async::JobSystem* jobSystem = nullptr);
+
+        /// \brief Updates the world matrices of the transform hierarchy, then the spatial index from what changed.
+        ///
+        /// Only the entities whose world matrix was recomputed, whose transform was removed or whose
+        /// SpatialBounds changed since the last call are reindexed. Removing SpatialBounds keeps the
+        /// indexed radius until the entity's transform changes.
+        NGIN_API void UpdateTransforms();
+
+        [[nodiscard]] NGIN_API const ECS::SystemScheduler& GetSystemScheduler() const noexcept;
+
+        [[nodiscard]] NGIN_API TransformHierarchy& GetTransforms() noexcept;
 
-        ~World();
+        [[nodiscard]] NGIN_API const TransformHierarchy& GetTransforms() const noexcept;
 
+        /// \brief Spatial index of the entities with a transform, as of the last UpdateTransforms.
+        [[nodiscard]] NGIN_API const SpatialIndex& GetSpatialIndex() const noexcept;
+
+        /// \brief The tick changes are currently stamped with.
+        [[nodiscard]] NGIN_API UInt64 GetChangeTick() const noexcept;
+
+        /// \brief Starts a new change tick.
+        ///
+        /// Every change made afterwards is newer than the returned tick, pass it to a later Query to
+        /// visit only the chunks changed in between.
+        /// \return The previous change tick.
+        NGIN_API UInt64 AdvanceChangeTick() noexcept;
+
+        /// \brief Number of alive entities.
+        [[nodiscard]] NGIN_API Size GetEntityCount() const noexcept;
+
+        /// \brief Number of archetypes created so far, including the archetype of entities without components.
+        [[nodiscard]] NGIN_API Size GetArchetypeCount() const noexcept;
+
+        [[nodiscard]] NGIN_API const ECS::Archetype& GetArchetype(Size index) const;
+
+        /// \brief The sparse set storing a component type, nullptr if the type is not stored in sparse sets
+        /// or no entity had it yet.
+        [[nodiscard]] NGIN_API const ECS::SparseSet* FindSparseSet(Meta::TypeIDType id) const noexcept;
+
+        [[nodiscard]] NGIN_API ECS::SparseSet* FindSparseSet(Meta::TypeIDType id) noexcept;
+
+        /// \brief Number of chunks allocated by all archetypes.
+        [[nodiscard]] NGIN_API Size GetChunkCount() const noexcept;
 
     private:
+        friend class WorldSnapshot;
+
+        using EntityRecord = ECS::EntityRecord;
+
+        static constexpr UInt32 NO_FREE_SLOT = std::numeric_limits<UInt32>::max();
+
+        static constexpr auto IS_ORDERED_BY_ID = [](const ECS::ComponentInfo* a, const ECS::ComponentInfo* b)
+        {
+            return a->id < b->id;
+        };
+
+        // Destroyed after the archetypes, which return their chunks on destruction
+        ECS::ChunkAllocator chunkAllocator;
+        std::vector<Scope<ECS::Archetype>> archetypes;
+        /// \brief Archetype indices by hash of their signature.
+        std::unordered_map<UInt64, std::vector<UInt32>> archetypeLookup;
+        /// \brief Storage of the sparse set components by component ID, created on first use.
+        Meta::TypeMap<Scope<ECS::SparseSet>> sparseSets;
+        /// \brief Dense entity table, free slots form a singly linked list starting at freeHead.
+        std::vector<EntityRecord> records;
+        /// \brief Query states by signature hash, signatures sharing a hash get separate states.
+        std::unordered_multimap<UInt64, Scope<ECS::QueryState>> queryStates;
+        ECS::SystemScheduler systemScheduler;
+        TransformHierarchy transforms;
+        Scope<SpatialIndex> spatialIndex;
+
+        /// \brief Distinguishes worlds in the per-thread command buffer caches, never reused.
+        const UInt64 worldID;
+        std::mutex commandBufferMutex;
+        std::vector<Scope<ECS::CommandBuffer>> commandBuffers;
+
+        struct PendingCommand
+        {
+            UInt32 entityIndex;
+            UInt32 buffer;
+            UInt32 command;
+        };
+
+        /// \brief Playback order of the recorded commands, kept to reuse its memory.
+        std::vector<PendingCommand> pendingCommands;
+        std::vector<const ECS::ComponentInfo*> createInfos;
+        UInt32 freeHead = NO_FREE_SLOT;
+        Size entityCount = 0;
+        /// \brief Stamped on the chunk columns touched by changes, advanced per system run and by AdvanceChangeTick.
+        UInt64 changeTick = 1;
+        /// \brief Change tick of the last UpdateTransforms, SpatialBounds changed after it are reindexed.
+        UInt64 spatialTick = 0;
+
+        template<typename T>
+        static constexpr Bool IS_TABLE = ECS::COMPONENT_STORAGE<T> == ECS::ComponentStorage::Table;
+
+        template<typename... Terms>
+        ECS::QueryState& GetQueryState()
+        {
+            using Traits = ECS::QueryTraits<Terms...>;
+
+            ECS::QueryState* state = nullptr;
+            auto [first, last] = queryStates.equal_range(Traits::SIGNATURE_HASH);
+            for (; first != last && state == nullptr; ++first)
+            {
+                if (first->second->HasSignature(Traits::FETCHED_IDS, Traits::REQUIRED_IDS, Traits::EXCLUDED_IDS,
+                                                Traits::CHANGED_IDS, Traits::ADDED_IDS))
+                    state = first->second.get();
+            }
+            if (state == nullptr)
+                state = queryStates.emplace(Traits::SIGNATURE_HASH,
+                                            CreateScope<ECS::QueryState>(Traits::FETCHED_IDS, Traits::REQUIRED_IDS,
+                                                                         Traits::EXCLUDED_IDS, Traits::CHANGED_IDS,
+                                                                         Traits::ADDED_IDS))->second.get();
+            state->Update(archetypes);
+            return *state;
+        }
+
+        /// \brief Takes a slot from the free list or appends one, and gives the entity a row in an archetype
+        /// with all its components marked as added.
+        NGIN_API ECS::Entity AllocateEntity(UInt32 archetypeIndex);
+
+        NGIN_API UInt32 GetOrCreateArchetype(std::span<const ECS::ComponentInfo* const> components);
+
+        /// \brief Applies the commands [begin, end) of pendingCommands, all for the same entity.
+        void PlayBack(const PendingCommand* begin, const PendingCommand* end);
+
+        void PlayBackCreate(ECS::CommandBuffer::Command& command);
+
+        /// \brief Moves an entity to another archetype, destroying the components the target lacks.
+        /// The components only the target has are marked as added, the moved ones keep their chunk's ticks.
+        /// \return The entity's row in the target archetype.
+        ECS::Archetype::Location MoveEntity(ECS::Entity entity, UInt32 targetIndex);
+
+        /// \brief The archetype reached from another by adding a component, itself if it already has it.
+        UInt32 GetAddTarget(UInt32 sourceIndex, const ECS::ComponentInfo& info);
+
+        /// \brief The archetype reached from another by removing a component, itself if it lacks it.
+        UInt32 GetRemoveTarget(UInt32 sourceIndex, Meta::TypeIDType id);
+
+        /// \brief Moves an entity to the archetype with one more component, or appends it to the component's
+        /// sparse set, and returns the uninitialized storage for it.
+        NGIN_API void* AddComponentStorage(ECS::Entity entity, const ECS::ComponentInfo& info);
+
+        /// \brief The sparse set of a component type stored in sparse sets, created on first use.
+        NGIN_API ECS::SparseSet& GetOrCreateSparseSet(const ECS::ComponentInfo& info);
+
+        NGIN_API Bool RemoveSparseComponent(ECS::Entity entity, Meta::TypeIDType id);
+
+        NGIN_API void* FindSparseComponent(ECS::Entity entity, Meta::TypeIDType id) noexcept;
+
+        NGIN_API const void* FindSparseComponent(ECS::Entity entity, Meta::TypeIDType id) const noexcept;
+
+        NGIN_API Bool RemoveComponent(ECS::Entity entity, Meta::TypeIDType id);
 
+        NGIN_API void* FindComponent(ECS::Entity entity, Meta::TypeIDType id) const noexcept;
 
+        /// \brief FindComponent for mutable access, marks the component's chunk column as changed.
+        NGIN_API void* FindMutableComponent(ECS::Entity entity, Meta::TypeIDType id) noexcept;
     };
-}
\ No newline at end of file
+}
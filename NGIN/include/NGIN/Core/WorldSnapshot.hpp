@@ -0,0 +1,64 @@
+#pragma once
+
+#include <NGIN/Defines.hpp>
+#include <NGIN/Core/World.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <span>
+
+namespace NGIN::Core
+{
+    /// \class WorldSnapshot
+    /// \brief Binary snapshots of whole worlds, for replays and moving worlds between processes.
+    ///
+    /// A snapshot holds the entity table, the archetypes, the sparse sets and the transform hierarchy.
+    /// Chunks are written as raw CHUNK_SIZE images aligned to CHUNK_SIZE in the file, so the columns of
+    /// trivially copyable components are restored by copying whole chunks, or by mapping them in place.
+    /// The other components must be reflected with Meta::Reflection::ClassRegistrar: they are written
+    /// field by field and restored by default constructing them and reading their reflected fields back.
+    /// Reflected fields may be trivially copyable, a String or another reflected class.
+    ///
+    /// Entity handles are kept, so components referring to entities stay valid. Systems, pending command
+    /// buffer commands and query caches are not part of a snapshot. Snapshots are only read back by the
+    /// same build on the same platform, every component type must have kept its layout.
+    class WorldSnapshot
+    {
+    public:
+        /// \brief Version of the format, snapshots of other versions are rejected.
+        static constexpr UInt32 VERSION = 1;
+
+        /// \brief Writes a snapshot of a world.
+        /// \throws std::invalid_argument if a component type is neither trivially copyable nor reflected,
+        /// or has a reflected field of another kind. Nothing is written then.
+        /// \throws std::runtime_error if writing to the stream fails.
+        NGIN_API static void Save(const World& world, std::ostream& out);
+
+        /// \brief Writes a snapshot of a world to a file, replacing it.
+        /// \throws std::runtime_error if the file cannot be written.
+        NGIN_API static void Save(const World& world, const String& path);
+
+        /// \brief Restores a snapshot held in memory into a new world, copying its chunks.
+        ///
+        /// The component types of the snapshot must be registered, see ECS::RegisterComponent. If restoring
+        /// throws, the world holds part of the snapshot and should be discarded.
+        /// \throws std::invalid_argument if the world already has entities or archetypes, the data is not
+        /// a valid snapshot, or one of its component types is unknown or changed.
+        NGIN_API static void Load(World& world, std::span<const std::byte> data);
+
+        /// \brief Restores a snapshot file into a new world without copying its chunks.
+        ///
+        /// The file is mapped copy-on-write and the world adopts the chunk images in place: pages are read
+        /// when their entities are first touched and copied when first written, restoring a large world
+        /// costs about as much as its entity table. The mapping is released with the world, the file must
+        /// not be modified until then.
+        /// \throws std::runtime_error if the file cannot be mapped.
+        /// \throws std::invalid_argument as Load does.
+        NGIN_API static void Map(World& world, const String& path);
+
+    private:
+        /// \brief Restores a snapshot, adopting the chunk images in place if mapping owns the data.
+        static void Restore(World& world, std::span<const std::byte> data, const std::shared_ptr<void>& mapping);
+    };
+}
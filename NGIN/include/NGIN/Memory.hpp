@@ -5,4 +5,5 @@
 #include <NGIN/Memory/FreeListAllocator.hpp>
 #include <NGIN/Memory/LinearAllocator.hpp>
 #include <NGIN/Memory/FallbackAllocator.hpp>
+#include <NGIN/Memory/PoolAllocator.hpp>
 #include <NGIN/Memory/Util.hpp>
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <concepts>
 #include <type_traits>
+#include <source_location>
 namespace NGIN::Memory
 {
     template <typename T>
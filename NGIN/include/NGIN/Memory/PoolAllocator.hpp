@@ -0,0 +1,76 @@
+#pragma once
+#include <NGIN/Defines.hpp>
+
+#include <memory>
+#include <cstddef>
+#include <source_location>
+
+namespace NGIN::Memory
+{
+    /**
+     * @class PoolAllocator
+     * @brief Allocator handing out fixed-size blocks from a preallocated pool.
+     *
+     * Free blocks form an intrusive singly linked list, so both allocation and deallocation are O(1)
+     * and never fragment. Requests larger than the block size, or more strictly aligned than the pool,
+     * fail and return nullptr, which makes the pool a good primary for a FallbackAllocator.
+     */
+    class PoolAllocator
+    {
+    public:
+        /**
+         * @brief Constructs a pool of blockCount blocks of blockSize bytes each.
+         *
+         * @param blockSize Size of each block, rounded up to hold a pointer and keep blocks aligned.
+         * @param blockCount Number of blocks in the pool.
+         * @param blockAlignment Alignment of every block, must be a power of two.
+         */
+        NGIN_API PoolAllocator(size_t blockSize, size_t blockCount, size_t blockAlignment = alignof(std::max_align_t));
+
+        NGIN_API PoolAllocator(PoolAllocator &&other) noexcept;
+
+        NGIN_API PoolAllocator &operator=(PoolAllocator &&other) noexcept;
+
+        /**
+         * @brief Allocates a single block.
+         *
+         * @return Pointer to the block, or nullptr if the pool is exhausted or the request does not fit a block.
+         */
+        NGIN_API void *Allocate(size_t size,
+                                size_t alignment = alignof(std::max_align_t),
+                                const std::source_location &location = std::source_location::current());
+
+        /**
+         * @brief Returns a block to the pool.
+         *
+         * @param ptr Pointer previously returned by Allocate, or nullptr.
+         */
+        NGIN_API void Deallocate(void *ptr);
+
+        /**
+         * @brief Returns every block to the pool at once.
+         */
+        NGIN_API void DeallocateAll();
+
+        NGIN_API bool Owns(void *ptr) const;
+
+        [[nodiscard]] NGIN_API size_t GetBlockSize() const noexcept;
+
+        [[nodiscard]] NGIN_API size_t GetFreeBlockCount() const noexcept;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        std::unique_ptr<std::byte[]> buffer;
+        std::byte *start = nullptr;
+        FreeBlock *freeList = nullptr;
+        size_t blockSize = 0;
+        size_t blockCount = 0;
+        size_t blockAlignment = 0;
+        size_t freeBlockCount = 0;
+    };
+
+} // namespace NGIN::Memory
@@ -4,6 +4,7 @@
 #include <type_traits>
 #include <typeinfo>
 #include "Registry.hpp"
+#include <NGIN/Meta/TypeID.hpp>
 #include <NGIN/Meta/TypeName.hpp>
 #include <cstdarg>
 #include <tuple>
@@ -76,6 +77,7 @@ namespace NGIN::Meta::Reflection
     ClassRegistrar<ClassType>::ClassRegistrar()
     {
         classData.name = TypeName<ClassType>::Class();
+        classData.typeID = TypeID<ClassType>();
         classData.ctor = &ClassRegistrar<ClassType>::DefaultCtor;
 
         classData.dtor = &ClassRegistrar<ClassType>::DefaultDtor;
@@ -85,6 +87,7 @@ namespace NGIN::Meta::Reflection
     ClassRegistrar<ClassType>::ClassRegistrar(const std::string& className)
     {
         classData.name = className;
+        classData.typeID = TypeID<ClassType>();
         classData.ctor = &ClassRegistrar<ClassType>::DefaultCtor;
 
         classData.dtor = &ClassRegistrar<ClassType>::DefaultDtor;
@@ -118,7 +121,10 @@ namespace NGIN::Meta::Reflection
         Types::Field fieldData {};
         fieldData.name = fieldName;
         fieldData.type = TypeName<FieldType>::Class();
+        fieldData.typeID = TypeID<FieldType>();
         fieldData.offset = reinterpret_cast<std::size_t>(&(reinterpret_cast<ClassType*>(0)->*fieldPtr));
+        fieldData.size = sizeof(FieldType);
+        fieldData.trivial = std::is_trivially_copyable_v<FieldType>;
 
         classData.fields.push_back(fieldData);
         return *this;
@@ -21,8 +21,14 @@ namespace NGIN::Meta::Reflection
 
         NGIN_API const Types::Enum& GetEnumFromString(const String& enumName);
 
+        /// \brief The class registered for a TypeID, nullptr if there is none. Unlike names, TypeIDs are not
+        /// shared by classes of different namespaces.
+        [[nodiscard]] NGIN_API const Types::Class* FindClass(TypeIDType typeID) const;
+
     private:
-        std::unordered_map<String, Types::Class> classMap;
+        std::unordered_map<TypeIDType, Types::Class> classMap;
+        /// \brief TypeID of the class last registered under each name.
+        std::unordered_map<String, TypeIDType> classNames;
         std::unordered_map<String, Types::Enum> enumMap;
     };
 }
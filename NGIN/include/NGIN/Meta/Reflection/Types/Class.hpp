@@ -1,6 +1,7 @@
 #pragma once
 // NGIN include(s)
 #include <NGIN/Defines.hpp>
+#include <NGIN/Meta/TypeID.hpp>
 #include "Field.hpp"
 #include "Function.hpp"
 // STL include(s)
@@ -14,6 +15,8 @@ namespace NGIN::Meta::Reflection::Types
     struct Class
     {
         String name;
+        /// \brief TypeID of the class, unlike the name it tells apart classes of different namespaces.
+        TypeIDType typeID;
         UInt64 size;
         UInt64 alignment;
         UInt64 version;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <NGIN/Meta/TypeID.hpp>
 #include <string>
 #include <cstddef>
 
@@ -10,7 +11,12 @@ namespace NGIN::Meta::Reflection::Types
     {
         std::string name;
         std::string type;
+        /// @brief TypeID of the field's type, to look its class up unambiguously
+        TypeIDType typeID;
         size_t offset;
+        size_t size;
+        /// @brief True if the field is trivially copyable, so its bytes are its value
+        bool trivial;
 
     };
 }
\ No newline at end of file
@@ -3,7 +3,11 @@
 #include <cstddef>
 #include <memory>
 #include <cstring>
+#include <new>
+#include <stdexcept>
+#include <source_location>
 #include "Concepts.hpp"
+#include <NGIN/Memory/Concepts.hpp>
 #include <assert.h>
 
 #define NGIN_HYBRID_STORAGE_ALIGNMENT 8
@@ -23,6 +27,13 @@ namespace NGIN::Meta::StoragePolicy
     /// The HybridStorage class is designed to handle storage for objects either on the stack or heap.
     /// If the object fits within the buffer size specified by Size, it is stored statically.
     /// Otherwise, it is stored dynamically on the heap.
+    ///
+    /// Besides the buffer, a storage holds a single pointer to a static per-type table of operations,
+    /// which also records whether the object lives on the heap. Moving a storage holding a trivially
+    /// relocatable object (or any heap-allocated object) is a plain memcpy of the storage.
+    ///
+    /// Objects that do not fit the buffer can be spilled into an NGIN allocator instead of the global heap,
+    /// e.g. a pool or a frame arena. The allocator must outlive the storage and every copy of it.
     template<std::size_t Size = 64>
     class NGIN_HYBRID_STORAGE_ALIGNMENT_ATTRIBUTE HybridStorage
     {
@@ -32,9 +43,11 @@ namespace NGIN::Meta::StoragePolicy
         HybridStorage() = default;
 
         /// \brief Copy constructor.
+        /// \throws std::invalid_argument If the stored object is not copy constructible.
         HybridStorage(const HybridStorage& other);
 
         /// \brief Copy assignment operator
+        /// \throws std::invalid_argument If the stored object is not copy constructible.
         HybridStorage& operator=(const HybridStorage& other);
 
         /// \brief Move constructor.
@@ -53,6 +66,17 @@ namespace NGIN::Meta::StoragePolicy
         HybridStorage(T&& obj)
         requires IsNotSame<HybridStorage<Size>, T>;
 
+        /// \brief Constructor spilling objects that do not fit the buffer into an allocator.
+        /// Objects that fit the buffer are stored inline and never touch the allocator.
+        /// \tparam T Type of the object to store.
+        /// \tparam AllocatorType Type of the spill allocator, deallocated through if it supports it.
+        /// \param obj The object to store.
+        /// \param alloc The allocator serving oversized objects.
+        /// \throws std::bad_alloc If the allocator fails to allocate.
+        template<IsStorageWrappable T, Memory::IsAllocator AllocatorType>
+        HybridStorage(T&& obj, AllocatorType& alloc)
+        requires IsNotSame<HybridStorage<Size>, T>;
+
         /// \brief Destructor.
         ~HybridStorage();
 
@@ -62,14 +86,61 @@ namespace NGIN::Meta::StoragePolicy
 
         [[nodiscard]] void* get() const;
 
+        /// \brief True if an object of type T is stored in the static buffer rather than on the heap.
+        template<typename T>
+        static constexpr bool IsStoredInline = sizeof(std::decay_t<T>) <= Size;
+
+        /// \brief Retrieve the stored data when its type is known, without checking where it lives.
+        /// \tparam T The type of the stored object.
+        /// \return A pointer to the stored object.
+        template<typename T>
+        T* get() noexcept
+        {
+            if constexpr (IsStoredInline<T>)
+                return reinterpret_cast<T*>(&data.buffer[0]);
+            else
+                return static_cast<T*>(data.heap.ptr);
+        }
+
+        /// \brief True if the stored object lives in a spill allocator rather than the buffer or global heap.
+        [[nodiscard]] bool IsSpilledToAllocator() const noexcept
+        { return operations->useHeap && data.heap.allocator != nullptr; }
+
+        /// \brief True if moving this storage is a plain memcpy.
+        [[nodiscard]] bool IsTriviallyRelocatable() const noexcept
+        { return operations->move == nullptr; }
+
+        /// \brief Relocates a range of storages into uninitialized memory.
+        ///
+        /// The whole range is copied with a single memcpy, only inline objects that are not trivially
+        /// relocatable are then fixed up through their move function. The source storages are left
+        /// destroyed and must not be used or destructed afterwards.
+        /// \param dst Uninitialized memory for count storages, must not overlap src.
+        /// \param src The storages to relocate.
+        /// \param count Number of storages.
+        static void Relocate(HybridStorage* dst, HybridStorage* src, std::size_t count) noexcept;
+
+        /// \brief Completes relocating a storage whose bytes were already copied from src to dst, by moving
+        /// an inline object that is not trivially relocatable. For types embedding a storage, which copy
+        /// themselves in bulk.
+        static void CompleteRelocation(HybridStorage& dst, HybridStorage& src) noexcept
+        {
+            if (src.operations->move)
+                src.operations->move(&dst.data.buffer[0], &src.data.buffer[0]);
+        }
 
     private:
         /// \union Data
         /// \brief Union for either holding a pointer to heap-allocated data or a static buffer.
         union Data
         {
-            /// \brief Pointer to heap-allocated data.
-            void* ptr = nullptr;
+            struct Heap
+            {
+                /// \brief Pointer to heap-allocated data.
+                void* ptr;
+                /// \brief Allocator the data was spilled into, null when on the global heap.
+                void* allocator;
+            } heap;
 
             /// \brief Static buffer for data.
             std::byte buffer[Size];
@@ -79,43 +150,136 @@ namespace NGIN::Meta::StoragePolicy
             {}
         } data {};
 
-        /// \brief Pointer to the function responsible for destructing the stored object.
-        void (* destructorFunc)(void*) = nullptr;
+        /// \struct Operations
+        /// \brief Type-erased operations of a stored type, one static instance per type and placement.
+        struct Operations
+        {
+            /// \brief Destructs the stored object and releases its memory, null if trivially destructible.
+            void (* destroy)(void* obj, void* alloc);
+
+            /// \brief Move constructs into dst and destroys src, null if the storage is trivially relocatable.
+            void (* move)(void* dst, void* src);
 
-        /// \brief Pointer to the function responsible for moving the stored object.
-        void (* moveFunc)(void* dst, void* src) = nullptr;
+            /// \brief Clones the stored object into an empty storage, null if not copy constructible.
+            void (* clone)(HybridStorage& dst, const HybridStorage& src);
 
-        /// \brief Pointer to the function responsible for cloning the stored object.
-        void (* cloneFunc)(void* dst, void* src) = nullptr;
+            /// \brief Whether the stored object is heap-allocated.
+            bool useHeap;
+        };
 
-        /// \brief Flag indicating whether the stored object is heap-allocated.
-        bool useHeap = false;
-    };
+        template<typename StoredType>
+        static void DestroyInline(void* obj, void*)
+        { static_cast<StoredType*>(obj)->~StoredType(); }
 
+        template<typename StoredType>
+        static void MoveInline(void* dst, void* src)
+        {
+            new(dst) StoredType(std::move(*static_cast<StoredType*>(src)));
+            static_cast<StoredType*>(src)->~StoredType();
+        }
 
-    template<std::size_t Size>
-    HybridStorage<Size>::HybridStorage(const HybridStorage& other)
-            : data {}
-    {
-        if (this == &other)
-            return;
+        template<typename StoredType>
+        static void CloneInline(HybridStorage& dst, const HybridStorage& src)
+        {
+            if constexpr (std::is_copy_constructible_v<StoredType>)
+                new(&dst.data.buffer[0]) StoredType(*static_cast<const StoredType*>(src.get()));
+        }
+
+        template<typename StoredType>
+        static void DeleteHeap(void* obj, void*)
+        { delete static_cast<StoredType*>(obj); }
 
-        destructorFunc = other.destructorFunc;
-        moveFunc = other.moveFunc;
-        cloneFunc = other.cloneFunc;
-        useHeap = other.useHeap;
+        template<typename StoredType>
+        static void CloneHeap(HybridStorage& dst, const HybridStorage& src)
+        {
+            if constexpr (std::is_copy_constructible_v<StoredType>)
+            {
+                dst.data.heap.ptr = new StoredType(*static_cast<const StoredType*>(src.get()));
+                dst.data.heap.allocator = nullptr;
+            }
+        }
 
-        if (useHeap)
+        template<typename StoredType, typename AllocatorType>
+        static void DestroySpilled(void* obj, void* alloc)
         {
-            data.ptr = new std::byte[Size];
-            std::memcpy(get(), const_cast<void*>(other.get()), Size);
-        } else if (cloneFunc)
+            static_cast<StoredType*>(obj)->~StoredType();
+            if constexpr (Memory::HasDeallocate<AllocatorType>)
+                static_cast<AllocatorType*>(alloc)->Deallocate(obj);
+        }
+
+        template<typename StoredType, typename AllocatorType>
+        static void CloneSpilled(HybridStorage& dst, const HybridStorage& src)
         {
-            cloneFunc(get(), other.get());
-        } else
+            if constexpr (std::is_copy_constructible_v<StoredType>)
+            {
+                auto& alloc = *static_cast<AllocatorType*>(src.data.heap.allocator);
+                void* memory = alloc.Allocate(sizeof(StoredType), alignof(StoredType), std::source_location::current());
+                if (memory == nullptr)
+                    throw std::bad_alloc();
+                dst.data.heap.ptr = new(memory) StoredType(*static_cast<const StoredType*>(src.get()));
+                dst.data.heap.allocator = &alloc;
+            }
+        }
+
+        /// \brief Returns clone if StoredType is copy constructible, otherwise null.
+        template<typename StoredType, auto Clone>
+        static constexpr auto CloneIfCopyable() -> void (*)(HybridStorage&, const HybridStorage&)
         {
-            std::memcpy(get(), const_cast<void*>(other.get()), Size);
+            if constexpr (std::is_copy_constructible_v<StoredType>)
+                return Clone;
+            else
+                return nullptr;
         }
+
+        /// \brief Operations of an empty storage.
+        static constexpr Operations EMPTY_OPERATIONS {nullptr, nullptr, nullptr, false};
+
+        /// \brief Operations of an object stored in the buffer.
+        template<typename StoredType>
+        static constexpr Operations INLINE_OPERATIONS {
+                std::is_trivially_destructible_v<StoredType> ? nullptr : &DestroyInline<StoredType>,
+                std::is_trivially_copyable_v<StoredType> ? nullptr : &MoveInline<StoredType>,
+                CloneIfCopyable<StoredType, &CloneInline<StoredType>>(),
+                false
+        };
+
+        /// \brief Operations of an object on the global heap. Only the pointer moves.
+        template<typename StoredType>
+        static constexpr Operations HEAP_OPERATIONS {
+                &DeleteHeap<StoredType>,
+                nullptr,
+                CloneIfCopyable<StoredType, &CloneHeap<StoredType>>(),
+                true
+        };
+
+        /// \brief Operations of an object spilled into an allocator. Only the pointer moves.
+        template<typename StoredType, typename AllocatorType>
+        static constexpr Operations SPILLED_OPERATIONS {
+                &DestroySpilled<StoredType, AllocatorType>,
+                nullptr,
+                CloneIfCopyable<StoredType, &CloneSpilled<StoredType, AllocatorType>>(),
+                true
+        };
+
+        /// \brief Operations of the stored object, never null.
+        const Operations* operations = &EMPTY_OPERATIONS;
+
+        /// \brief Destroys the stored object, leaving the storage empty.
+        void Reset() noexcept;
+
+        /// \brief Takes over the object of other, leaving other empty. This storage must be empty.
+        void MoveFrom(HybridStorage& other) noexcept;
+
+        /// \brief Clones the object of other into this storage. This storage must be empty.
+        void CopyFrom(const HybridStorage& other);
+    };
+
+
+    template<std::size_t Size>
+    HybridStorage<Size>::HybridStorage(const HybridStorage& other)
+            : data {}
+    {
+        CopyFrom(other);
     }
 
     template<std::size_t Size>
@@ -124,22 +288,8 @@ namespace NGIN::Meta::StoragePolicy
         if (this == &other)
             return *this;
 
-        destructorFunc = other.destructorFunc;
-        moveFunc = other.moveFunc;
-        cloneFunc = other.cloneFunc;
-        useHeap = other.useHeap;
-
-        if (useHeap)
-        {
-            data.ptr = new std::byte[Size];
-            std::memcpy(get(), const_cast<void*>(other.get()), Size);
-        } else if (cloneFunc)
-        {
-            cloneFunc(get(), other.get());
-        } else
-        {
-            std::memcpy(get(), const_cast<void*>(other.get()), Size);
-        }
+        Reset();
+        CopyFrom(other);
         return *this;
     }
 
@@ -147,30 +297,7 @@ namespace NGIN::Meta::StoragePolicy
     HybridStorage<Size>::HybridStorage(HybridStorage&& other) noexcept
             : data {}
     {
-        if (this == &other)
-            return;
-
-        destructorFunc = other.destructorFunc;
-        moveFunc = other.moveFunc;
-        cloneFunc = other.cloneFunc;
-        useHeap = other.useHeap;
-
-        if (useHeap)
-        {
-            data.ptr = other.data.ptr;
-            other.data.ptr = nullptr;
-        } else if (moveFunc)
-        {
-            moveFunc(get(), other.get());
-        } else
-        {
-            std::memcpy(get(), other.get(), Size);
-        }
-
-        other.data.ptr = nullptr;
-        other.destructorFunc = nullptr;
-        other.moveFunc = nullptr;
-        other.cloneFunc = nullptr;
+        MoveFrom(other);
     }
 
     template<std::size_t Size>
@@ -179,27 +306,8 @@ namespace NGIN::Meta::StoragePolicy
         if (this == &other)
             return *this;
 
-        destructorFunc = other.destructorFunc;
-        moveFunc = other.moveFunc;
-        cloneFunc = other.cloneFunc;
-        useHeap = other.useHeap;
-
-        if (useHeap)
-        {
-            data.ptr = other.data.ptr;
-            other.data.ptr = nullptr;
-        } else if (moveFunc)
-        {
-            moveFunc(get(), other.get());
-        } else
-        {
-            std::memcpy(get(), other.get(), Size);
-        }
-
-        other.data.ptr = nullptr;
-        other.destructorFunc = nullptr;
-        other.moveFunc = nullptr;
-        other.cloneFunc = nullptr;
+        Reset();
+        MoveFrom(other);
         return *this;
     }
 
@@ -209,63 +317,109 @@ namespace NGIN::Meta::StoragePolicy
     requires IsNotSame<HybridStorage<Size>, T>
     {
         using StoredType = std::decay_t<T>;
-        if constexpr (sizeof(StoredType) <= Size)
+        if constexpr (IsStoredInline<StoredType>)
         {
             // Using placement new here
             new(&data.buffer[0]) StoredType(std::move(obj));
-            if constexpr (std::is_destructible_v<StoredType>)
-            {
-                destructorFunc = [](void* obj) { static_cast<StoredType*>(obj)->~T(); };
-            }
-            useHeap = false;
+            operations = &INLINE_OPERATIONS<StoredType>;
         } else
         {
-            data.ptr = new StoredType(std::move(obj));
-            if constexpr (std::is_destructible_v<StoredType>)
-            {
-                destructorFunc = [](void* obj) { delete static_cast<StoredType*>(obj); };
-            }
-            useHeap = true;
+            data.heap.ptr = new StoredType(std::move(obj));
+            data.heap.allocator = nullptr;
+            operations = &HEAP_OPERATIONS<StoredType>;
         }
+    }
 
-        if constexpr (std::is_move_assignable_v<StoredType>)
+    template<std::size_t Size>
+    template<IsStorageWrappable T, Memory::IsAllocator AllocatorType>
+    HybridStorage<Size>::HybridStorage(T&& obj, AllocatorType& alloc)
+    requires IsNotSame<HybridStorage<Size>, T>
+    {
+        using StoredType = std::decay_t<T>;
+        if constexpr (IsStoredInline<StoredType>)
         {
-            moveFunc = [](void* dst, void* src)
-            {
-                *static_cast<StoredType*>(dst) = std::move(*static_cast<StoredType*>(src));
-            };
-        }
-
-        if constexpr (std::is_copy_assignable_v<StoredType>)
+            new(&data.buffer[0]) StoredType(std::move(obj));
+            operations = &INLINE_OPERATIONS<StoredType>;
+        } else
         {
-            cloneFunc = [](void* dst, void* src)
-            {
-                *static_cast<StoredType*>(dst) = *static_cast<StoredType*>(src);
-            };
+            void* memory = alloc.Allocate(sizeof(StoredType), alignof(StoredType), std::source_location::current());
+            if (memory == nullptr)
+                throw std::bad_alloc();
+
+            data.heap.ptr = new(memory) StoredType(std::move(obj));
+            data.heap.allocator = &alloc;
+            operations = &SPILLED_OPERATIONS<StoredType, AllocatorType>;
         }
     }
 
     template<std::size_t Size>
     HybridStorage<Size>::~HybridStorage()
     {
-
-        if (destructorFunc)
-        {
-            destructorFunc(get());
-        }
+        Reset();
     }
 
     template<std::size_t Size>
     void* HybridStorage<Size>::get()
     {
-        return useHeap ? data.ptr : &data.buffer[0];
+        return operations->useHeap ? data.heap.ptr : &data.buffer[0];
     }
 
     template<std::size_t Size>
     void* HybridStorage<Size>::get() const
     {
-        return const_cast<void*>(useHeap ? data.ptr : &data.buffer[0]);
+        return const_cast<void*>(operations->useHeap ? data.heap.ptr : &data.buffer[0]);
+    }
+
+    template<std::size_t Size>
+    void HybridStorage<Size>::Relocate(HybridStorage* dst, HybridStorage* src, std::size_t count) noexcept
+    {
+        if (count == 0)
+            return;
+
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(HybridStorage) * count);
+        for (std::size_t i = 0; i < count; ++i)
+            CompleteRelocation(dst[i], src[i]);
+    }
+
+    template<std::size_t Size>
+    void HybridStorage<Size>::Reset() noexcept
+    {
+        if (operations->destroy)
+            operations->destroy(get(), operations->useHeap ? data.heap.allocator : nullptr);
+
+        operations = &EMPTY_OPERATIONS;
     }
 
+    template<std::size_t Size>
+    void HybridStorage<Size>::MoveFrom(HybridStorage& other) noexcept
+    {
+        operations = other.operations;
+        if (operations->move)
+            operations->move(&data.buffer[0], &other.data.buffer[0]);
+        else
+            std::memcpy(&data, &other.data, sizeof(Data));
+
+        // The object now lives here, other must not destroy it
+        other.operations = &EMPTY_OPERATIONS;
+    }
+
+    template<std::size_t Size>
+    void HybridStorage<Size>::CopyFrom(const HybridStorage& other)
+    {
+        const Operations* otherOperations = other.operations;
+        if (otherOperations->destroy == nullptr && otherOperations->move == nullptr && !otherOperations->useHeap)
+        {
+            // Trivial inline object, or empty
+            std::memcpy(&data, &other.data, sizeof(Data));
+        } else if (otherOperations->clone)
+        {
+            otherOperations->clone(*this, other);
+        } else
+        {
+            throw std::invalid_argument("Stored object is not copy constructible.");
+        }
+
+        operations = otherOperations;
+    }
 
 }
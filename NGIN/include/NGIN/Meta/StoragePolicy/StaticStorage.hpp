@@ -2,6 +2,9 @@
 
 #include <cstddef>
 #include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "Concepts.hpp"
 
 #define NGIN_STATIC_STORAGE_ALIGNMENT 16
@@ -60,31 +63,59 @@ namespace NGIN::Meta::StoragePolicy
         /// @brief Internal buffer to hold object data.
         std::byte buffer[Size];
 
-        /// @brief Function pointer for object destruction.
-        void (* destructorFunc)(void*) = nullptr;
+        /// @brief Type-erased operations of a stored type, one static instance per type.
+        struct Operations
+        {
+            /// @brief Destructs the stored object, null if trivially destructible.
+            void (* destroy)(void* obj);
+
+            /// @brief Move constructs into dst and destroys src, null if the object can be moved with memcpy.
+            void (* move)(void* dst, void* src);
+        };
+
+        template<typename StoredType>
+        static void DestroyStored(void* obj)
+        { static_cast<StoredType*>(obj)->~StoredType(); }
+
+        template<typename StoredType>
+        static void MoveStored(void* dst, void* src)
+        {
+            new(dst) StoredType(std::move(*static_cast<StoredType*>(src)));
+            static_cast<StoredType*>(src)->~StoredType();
+        }
 
-        /// @brief Function pointer for moving object data.
-        void (* moveFunc)(void* dst, void* src) = nullptr;
+        /// @brief Operations of an empty storage.
+        static constexpr Operations EMPTY_OPERATIONS {nullptr, nullptr};
+
+        /// @brief Operations of a stored type.
+        template<typename StoredType>
+        static constexpr Operations STORED_OPERATIONS {
+                std::is_trivially_destructible_v<StoredType> ? nullptr : &DestroyStored<StoredType>,
+                std::is_trivially_copyable_v<StoredType> ? nullptr : &MoveStored<StoredType>
+        };
+
+        /// @brief Operations of the stored object, never null.
+        const Operations* operations = &EMPTY_OPERATIONS;
+
+        /// @brief Takes over the object of other, leaving other empty. This storage must be empty.
+        void MoveFrom(StaticStorage& other) noexcept;
     };
 
     template<std::size_t Size>
     StaticStorage<Size>::StaticStorage()
-            : destructorFunc(nullptr), buffer {}
+            : buffer {}
     {
     }
 
     template<std::size_t Size>
     StaticStorage<Size>& StaticStorage<Size>::operator=(StaticStorage&& other) noexcept
     {
-        destructorFunc = other.destructorFunc;
-        moveFunc = other.moveFunc;
-        if (moveFunc)
-            moveFunc(get(), other.get());
-        else
-            std::memcpy(get(), other.get(), Size);
+        if (this == &other)
+            return *this;
 
-        other.destructorFunc = nullptr;
-        other.moveFunc = nullptr;
+        if (operations->destroy)
+            operations->destroy(&buffer[0]);
+        MoveFrom(other);
 
         return *this;
     }
@@ -93,15 +124,7 @@ namespace NGIN::Meta::StoragePolicy
     StaticStorage<Size>::StaticStorage(StaticStorage&& other) noexcept
             : buffer {}
     {
-        destructorFunc = other.destructorFunc;
-        moveFunc = other.moveFunc;
-        if (moveFunc)
-            moveFunc(get(), other.get());
-        else
-            std::memcpy(get(), other.get(), Size);
-
-        other.destructorFunc = nullptr;
-        other.moveFunc = nullptr;
+        MoveFrom(other);
     }
 
     template<std::size_t Size>
@@ -115,28 +138,27 @@ namespace NGIN::Meta::StoragePolicy
                       "Type alignment too large for StaticStorage.");
 
         new(&buffer[0]) StoredType(std::move(obj));
-        if constexpr (std::is_destructible_v<StoredType>)
-        {
-            destructorFunc = [](void* ptr)
-            {
-                static_cast<StoredType*>(ptr)->~StoredType();
-            };
-        }
-
-        if constexpr (std::is_move_assignable_v<StoredType>)
-        {
-            moveFunc = [](void* dst, void* src)
-            {
-                *static_cast<StoredType*>(dst) = std::move(*static_cast<StoredType*>(src));
-            };
-        }
+        operations = &STORED_OPERATIONS<StoredType>;
     }
 
     template<std::size_t Size>
     StaticStorage<Size>::~StaticStorage()
     {
-        if (destructorFunc)
-            destructorFunc(&buffer[0]);
+        if (operations->destroy)
+            operations->destroy(&buffer[0]);
+    }
+
+    template<std::size_t Size>
+    void StaticStorage<Size>::MoveFrom(StaticStorage& other) noexcept
+    {
+        operations = other.operations;
+        if (operations->move)
+            operations->move(&buffer[0], &other.buffer[0]);
+        else
+            std::memcpy(&buffer[0], &other.buffer[0], Size);
+
+        // The object now lives here, other must not destroy it
+        other.operations = &EMPTY_OPERATIONS;
     }
 
-}
\ No newline at end of file
+}
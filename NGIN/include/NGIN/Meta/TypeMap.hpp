@@ -0,0 +1,301 @@
+#pragma once
+#include <NGIN/Defines.hpp>
+#include <NGIN/Meta/TypeID.hpp>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace NGIN::Meta
+{
+    /// \class TypeMap
+    /// \brief A flat map from types to values, keyed by the compile-time TypeID of the type.
+    ///
+    /// Values live in a dense array. An open addressing table with linear probing maps the precomputed
+    /// 64-bit IDs to dense indices, using the ID itself as the hash since it already is an FNV-1a hash.
+    ///
+    /// Typed lookups additionally cache the dense index of the type per thread, so repeated lookups of
+    /// the same type in the same map are an array access. The cache is invalidated whenever a removal
+    /// could have moved values in the dense array.
+    /// \tparam V Type of the stored values.
+    template<typename V>
+    class TypeMap
+    {
+    public:
+        TypeMap() = default;
+
+        TypeMap(const TypeMap& other)
+                : values(other.values), keys(other.keys), table(other.table)
+        {}
+
+        TypeMap(TypeMap&& other) noexcept
+                : values(std::move(other.values)), keys(std::move(other.keys)), table(std::move(other.table))
+        {
+            other.Invalidate();
+        }
+
+        TypeMap& operator=(const TypeMap& other)
+        {
+            if (this == &other)
+                return *this;
+
+            values = other.values;
+            keys = other.keys;
+            table = other.table;
+            Invalidate();
+            return *this;
+        }
+
+        TypeMap& operator=(TypeMap&& other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            values = std::move(other.values);
+            keys = std::move(other.keys);
+            table = std::move(other.table);
+            Invalidate();
+            other.Invalidate();
+            return *this;
+        }
+
+        /// \brief Inserts a value for type T.
+        /// \return True if the value was inserted, false if T already had a value.
+        template<typename T>
+        bool Insert(V value)
+        {
+            return Insert(TypeID<T>(), std::move(value));
+        }
+
+        /// \brief Inserts a value for a type ID.
+        /// \return True if the value was inserted, false if the ID already had a value.
+        bool Insert(TypeIDType id, V value)
+        {
+            if (FindIndex(id) != INVALID_INDEX)
+                return false;
+
+            if ((values.size() + 1) * 2 > table.size())
+                Rehash(table.empty() ? MIN_CAPACITY : table.size() * 2);
+
+            const UInt32 denseIndex = static_cast<UInt32>(values.size());
+            values.push_back(std::move(value));
+            keys.push_back(id);
+
+            Size slot = id & (table.size() - 1);
+            while (table[slot].denseIndex != INVALID_INDEX)
+                slot = (slot + 1) & (table.size() - 1);
+            table[slot] = {id, denseIndex};
+            return true;
+        }
+
+        /// \brief Finds the value of type T.
+        /// \return Pointer to the value, or nullptr if T has no value.
+        template<typename T>
+        V* Find()
+        {
+            constexpr TypeIDType id = TypeID<T>();
+
+            thread_local Cache cache;
+            if (cache.mapID == mapID && cache.version == version)
+                return &values[cache.denseIndex];
+
+            const UInt32 denseIndex = FindIndex(id);
+            if (denseIndex == INVALID_INDEX)
+                return nullptr;
+
+            cache = {mapID, version, denseIndex};
+            return &values[denseIndex];
+        }
+
+        template<typename T>
+        const V* Find() const
+        {
+            return const_cast<TypeMap*>(this)->template Find<T>();
+        }
+
+        /// \brief Finds the value of a type ID.
+        /// \return Pointer to the value, or nullptr if the ID has no value.
+        V* Find(TypeIDType id)
+        {
+            const UInt32 denseIndex = FindIndex(id);
+            return denseIndex == INVALID_INDEX ? nullptr : &values[denseIndex];
+        }
+
+        const V* Find(TypeIDType id) const
+        {
+            const UInt32 denseIndex = FindIndex(id);
+            return denseIndex == INVALID_INDEX ? nullptr : &values[denseIndex];
+        }
+
+        template<typename T>
+        [[nodiscard]] bool Contains() const
+        {
+            return Find<T>() != nullptr;
+        }
+
+        [[nodiscard]] bool Contains(TypeIDType id) const
+        {
+            return FindIndex(id) != INVALID_INDEX;
+        }
+
+        /// \brief Removes the value of type T.
+        /// \return True if a value was removed.
+        template<typename T>
+        bool Remove()
+        {
+            return Remove(TypeID<T>());
+        }
+
+        /// \brief Removes the value of a type ID.
+        /// The last value is swapped into the freed position, so iteration order is not preserved.
+        /// \return True if a value was removed.
+        bool Remove(TypeIDType id)
+        {
+            if (table.empty())
+                return false;
+
+            const Size mask = table.size() - 1;
+            Size slot = id & mask;
+            while (table[slot].denseIndex != INVALID_INDEX && table[slot].id != id)
+                slot = (slot + 1) & mask;
+            if (table[slot].denseIndex == INVALID_INDEX)
+                return false;
+
+            const UInt32 denseIndex = table[slot].denseIndex;
+            const UInt32 last = static_cast<UInt32>(values.size() - 1);
+            if (denseIndex != last)
+            {
+                values[denseIndex] = std::move(values[last]);
+                keys[denseIndex] = keys[last];
+                SlotOf(keys[denseIndex]).denseIndex = denseIndex;
+            }
+            values.pop_back();
+            keys.pop_back();
+
+            // Backward shift deletion keeps probe sequences intact without tombstones
+            Size hole = slot;
+            Size next = (hole + 1) & mask;
+            while (table[next].denseIndex != INVALID_INDEX)
+            {
+                const Size home = table[next].id & mask;
+                if (((next - home) & mask) >= ((next - hole) & mask))
+                {
+                    table[hole] = table[next];
+                    hole = next;
+                }
+                next = (next + 1) & mask;
+            }
+            table[hole] = {};
+
+            ++version;
+            return true;
+        }
+
+        /// \brief Removes every value.
+        void Clear()
+        {
+            values.clear();
+            keys.clear();
+            table.clear();
+            ++version;
+        }
+
+        [[nodiscard]] Size GetSize() const noexcept
+        { return values.size(); }
+
+        [[nodiscard]] bool IsEmpty() const noexcept
+        { return values.empty(); }
+
+        /// \brief Type ID of the value at the same position in the dense array.
+        [[nodiscard]] TypeIDType GetKey(Size index) const
+        { return keys[index]; }
+
+        auto begin() noexcept
+        { return values.begin(); }
+
+        auto end() noexcept
+        { return values.end(); }
+
+        auto begin() const noexcept
+        { return values.begin(); }
+
+        auto end() const noexcept
+        { return values.end(); }
+
+    private:
+        static constexpr UInt32 INVALID_INDEX = std::numeric_limits<UInt32>::max();
+        static constexpr Size MIN_CAPACITY = 16;
+
+        struct Slot
+        {
+            TypeIDType id = 0;
+            UInt32 denseIndex = INVALID_INDEX;
+        };
+
+        struct Cache
+        {
+            UInt64 mapID = 0;
+            UInt64 version = 0;
+            UInt32 denseIndex = INVALID_INDEX;
+        };
+
+        std::vector<V> values;
+        std::vector<TypeIDType> keys;
+        std::vector<Slot> table;
+
+        /// \brief Identifies this map in the per-type caches, unique for the lifetime of the program.
+        UInt64 mapID = NextMapID();
+        /// \brief Incremented whenever cached dense indices may have become stale.
+        UInt64 version = 0;
+
+        static UInt64 NextMapID()
+        {
+            static std::atomic<UInt64> counter = 1;
+            return counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void Invalidate()
+        {
+            mapID = NextMapID();
+            version = 0;
+        }
+
+        [[nodiscard]] UInt32 FindIndex(TypeIDType id) const
+        {
+            if (table.empty())
+                return INVALID_INDEX;
+
+            const Size mask = table.size() - 1;
+            Size slot = id & mask;
+            while (table[slot].denseIndex != INVALID_INDEX)
+            {
+                if (table[slot].id == id)
+                    return table[slot].denseIndex;
+                slot = (slot + 1) & mask;
+            }
+            return INVALID_INDEX;
+        }
+
+        Slot& SlotOf(TypeIDType id)
+        {
+            const Size mask = table.size() - 1;
+            Size slot = id & mask;
+            while (table[slot].id != id || table[slot].denseIndex == INVALID_INDEX)
+                slot = (slot + 1) & mask;
+            return table[slot];
+        }
+
+        void Rehash(Size capacity)
+        {
+            table.assign(capacity, {});
+            const Size mask = capacity - 1;
+            for (UInt32 i = 0; i < keys.size(); ++i)
+            {
+                Size slot = keys[i] & mask;
+                while (table[slot].denseIndex != INVALID_INDEX)
+                    slot = (slot + 1) & mask;
+                table[slot] = {keys[i], i};
+            }
+        }
+    };
+}
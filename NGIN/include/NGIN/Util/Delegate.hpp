@@ -2,6 +2,9 @@
 
 #include "Delegate/StaticDelegate.hpp"
 #include "Delegate/DynamicDelegate.hpp"
+#include "Delegate/InplaceDelegate.hpp"
+#include "Delegate/MulticastDelegate.hpp"
+#include "Delegate/DelegateVector.hpp"
 
 namespace NGIN
 {
@@ -9,4 +12,13 @@ namespace NGIN
     using StaticDelegate = NGIN::Util::StaticDelegate<FuncType>;
 
     using DynamicDelegate = NGIN::Util::DynamicDelegate;
+
+    template <typename FuncType, Size Capacity = NGIN::Util::INPLACE_DELEGATE_DEFAULT_CAPACITY>
+    using InplaceDelegate = NGIN::Util::InplaceDelegate<FuncType, Capacity>;
+
+    template <typename FuncType, Size Capacity = NGIN::Util::INPLACE_DELEGATE_DEFAULT_CAPACITY>
+    using MoveOnlyInplaceDelegate = NGIN::Util::MoveOnlyInplaceDelegate<FuncType, Capacity>;
+
+    template <typename FuncType, Size StateSize = NGIN::Util::MULTICAST_DELEGATE_DEFAULT_STATE_SIZE>
+    using MulticastDelegate = NGIN::Util::MulticastDelegate<FuncType, StateSize>;
 }
\ No newline at end of file
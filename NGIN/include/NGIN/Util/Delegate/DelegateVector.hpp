@@ -0,0 +1,140 @@
+#pragma once
+#include <NGIN/Defines.hpp>
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace NGIN::Util
+{
+    /// \brief Types that relocate a range of themselves into uninitialized memory, e.g. StaticDelegate.
+    template <typename T>
+    concept IsBulkRelocatable = std::is_nothrow_move_constructible_v<T> && requires(T* dst, T* src, Size count)
+    {
+        { T::Relocate(dst, src, count) } noexcept;
+    };
+
+    /// \class DelegateVector
+    /// \brief A growable array of delegates that moves its elements with their bulk Relocate when it grows.
+    ///
+    /// std::vector moves every element through its move constructor on reallocation. Here the whole array
+    /// is relocated at once, which for delegates is one memcpy plus a fix-up of the few callables that
+    /// are not trivially relocatable.
+    template <IsBulkRelocatable T>
+    class DelegateVector
+    {
+    public:
+        DelegateVector() noexcept = default;
+
+        DelegateVector(const DelegateVector&) = delete;
+        DelegateVector& operator=(const DelegateVector&) = delete;
+
+        DelegateVector(DelegateVector&& other) noexcept
+            : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)),
+              capacity(std::exchange(other.capacity, 0))
+        {}
+
+        DelegateVector& operator=(DelegateVector&& other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            Clear();
+            Deallocate(data);
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+            capacity = std::exchange(other.capacity, 0);
+            return *this;
+        }
+
+        ~DelegateVector()
+        {
+            Clear();
+            Deallocate(data);
+        }
+
+        [[nodiscard]] Size GetSize() const noexcept
+        { return size; }
+
+        [[nodiscard]] bool IsEmpty() const noexcept
+        { return size == 0; }
+
+        [[nodiscard]] T& operator[](Size index) noexcept
+        { return data[index]; }
+
+        [[nodiscard]] const T& operator[](Size index) const noexcept
+        { return data[index]; }
+
+        void PushBack(T&& value)
+        {
+            if (size == capacity)
+                Grow(size, std::move(value));
+            else
+                ::new(data + size) T(std::move(value));
+            ++size;
+        }
+
+        /// \brief Inserts value before the element at position, moving the following elements up.
+        void Insert(Size position, T&& value)
+        {
+            if (position == size)
+            {
+                PushBack(std::move(value));
+                return;
+            }
+
+            if (size == capacity)
+            {
+                Grow(position, std::move(value));
+            } else
+            {
+                ::new(data + size) T(std::move(data[size - 1]));
+                for (Size i = size - 1; i > position; --i)
+                    data[i] = std::move(data[i - 1]);
+                data[position] = std::move(value);
+            }
+            ++size;
+        }
+
+        /// \brief Destroys the elements from count on.
+        void Truncate(Size count) noexcept
+        {
+            for (Size i = count; i < size; ++i)
+                data[i].~T();
+            if (count < size)
+                size = count;
+        }
+
+        void Clear() noexcept
+        { Truncate(0); }
+
+    private:
+        T* data = nullptr;
+        Size size = 0;
+        Size capacity = 0;
+
+        static void Deallocate(T* memory) noexcept
+        {
+            if (memory)
+                ::operator delete(memory, std::align_val_t(alignof(T)));
+        }
+
+        /// \brief Reallocates with room for one more element, constructing value at position in between
+        /// the relocated elements.
+        void Grow(Size position, T&& value)
+        {
+            const Size newCapacity = capacity == 0 ? 4 : capacity * 2;
+            T* newData = static_cast<T*>(::operator new(sizeof(T) * newCapacity, std::align_val_t(alignof(T))));
+            ::new(newData + position) T(std::move(value));
+            if (data)
+            {
+                T::Relocate(newData, data, position);
+                T::Relocate(newData + position + 1, data + position, size - position);
+                Deallocate(data);
+            }
+            data = newData;
+            capacity = newCapacity;
+        }
+    };
+}
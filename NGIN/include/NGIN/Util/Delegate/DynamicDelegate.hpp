@@ -5,6 +5,7 @@
 #include <NGIN/Meta/FunctionTraits.hpp>
 #include <type_traits>
 #include <NGIN/Meta/StoragePolicy.hpp>
+#include <NGIN/Memory/Concepts.hpp>
 #include <functional>
 
 namespace NGIN::Util
@@ -34,6 +35,12 @@ namespace NGIN::Util
         DynamicDelegate(F&& f) noexcept
         requires (!std::is_same_v<std::decay_t<F>, DynamicDelegate>);
 
+        /// \brief Constructs from a callable, spilling it into alloc if it does not fit the inline buffer.
+        /// The allocator must outlive the delegate and every copy of it.
+        template<typename F, Memory::IsAllocator AllocatorType>
+        DynamicDelegate(F&& f, AllocatorType& alloc)
+        requires (!std::is_same_v<std::decay_t<F>, DynamicDelegate>);
+
         /// \brief Constructs from function pointers.
         template<typename R, typename... Args>
         DynamicDelegate(R(* func)(Args...)) noexcept;
@@ -106,6 +113,19 @@ namespace NGIN::Util
         SetInvokerFromArgsTuple<CallableType, ArgumentTuple>(Traits::argsIndexSequence);
     }
 
+    template<typename F, Memory::IsAllocator AllocatorType>
+    inline DynamicDelegate::DynamicDelegate(F&& f, AllocatorType& alloc)
+    requires (!std::is_same_v<std::decay_t<F>, DynamicDelegate>)
+    {
+        using CallableType = std::decay_t<F>;
+        using Traits = Meta::FunctionTraits<CallableType>;
+        using ArgumentTuple = typename Traits::ArgsTupleType;
+
+        returnTypeID = Meta::TypeID<typename Traits::ReturnType>();
+        storage = StorageType(CallableType(std::forward<F>(f)), alloc);
+        SetInvokerFromArgsTuple<CallableType, ArgumentTuple>(Traits::argsIndexSequence);
+    }
+
     template<typename F>
     inline DynamicDelegate& DynamicDelegate::operator=(F&& f) noexcept
     requires (!std::is_same_v<std::decay_t<F>, DynamicDelegate>)
@@ -0,0 +1,235 @@
+#pragma once
+#include <NGIN/Defines.hpp>
+#include <type_traits>
+#include <concepts>
+#include <cstring>
+#include <stdexcept>
+#include <new>
+#include <tuple>
+
+namespace NGIN::Util
+{
+    /// \brief Default inline capacity of an InplaceDelegate, large enough for a bound member function.
+    inline constexpr Size INPLACE_DELEGATE_DEFAULT_CAPACITY = sizeof(void*) * 3;
+
+    template <typename FuncType, Size Capacity = INPLACE_DELEGATE_DEFAULT_CAPACITY, bool Copyable = true>
+    class InplaceDelegate;
+
+    /// \brief An InplaceDelegate that also stores move-only callables, and is itself move-only.
+    template <typename FuncType, Size Capacity = INPLACE_DELEGATE_DEFAULT_CAPACITY>
+    using MoveOnlyInplaceDelegate = InplaceDelegate<FuncType, Capacity, false>;
+
+    /// \class InplaceDelegate
+    /// \brief A delegate that stores its callable in a fixed inline buffer and never allocates.
+    ///
+    /// Callables that do not fit within Capacity are rejected at compile time instead of spilling to the heap.
+    /// Trivially copyable callables (function pointers, bound members, lambdas capturing pointers or PODs)
+    /// are relocated with a plain memcpy, other callables go through a per-type manager function.
+    /// \tparam Capacity The size of the inline buffer in bytes.
+    /// \tparam Copyable Whether the delegate is copyable. Copyable delegates only accept copy constructible
+    /// callables, see MoveOnlyInplaceDelegate for move-only ones.
+    template <typename ReturnType, typename... ArgTypes, Size Capacity, bool Copyable>
+    class InplaceDelegate<ReturnType(ArgTypes...), Capacity, Copyable>
+    {
+    public:
+        /// \brief Type of the function pointer.
+        using FunctionType = ReturnType(*)(ArgTypes...);
+
+        /// \brief Type of the return value.
+        using ResultType = ReturnType;
+
+        /// \brief Number of arguments.
+        static constexpr size_t NumArgs = sizeof...(ArgTypes);
+
+        /// \brief Tuple of argument types.
+        using ArgsTupleType = std::tuple<ArgTypes...>;
+
+        /// \brief Alignment of the inline buffer, callables must not require more.
+        static constexpr Size ALIGNMENT = alignof(void*);
+
+        /// \brief True if a callable of type F can be stored in this delegate.
+        template <typename F>
+        static constexpr bool Fits = sizeof(std::decay_t<F>) <= Capacity && alignof(std::decay_t<F>) <= ALIGNMENT;
+
+        /// \brief Constructs an empty delegate.
+        InplaceDelegate() noexcept = default;
+
+        InplaceDelegate(std::nullptr_t) noexcept {}
+
+        InplaceDelegate(const InplaceDelegate& other) requires Copyable
+            : invoker(other.invoker), manager(other.manager)
+        {
+            if (manager)
+                manager(Operation::Copy, buffer, const_cast<Byte*>(other.buffer));
+            else
+                std::memcpy(buffer, other.buffer, Capacity);
+        }
+
+        InplaceDelegate(InplaceDelegate&& other) noexcept
+            : invoker(other.invoker), manager(other.manager)
+        {
+            if (manager)
+                manager(Operation::Move, buffer, other.buffer);
+            else
+                std::memcpy(buffer, other.buffer, Capacity);
+            other.Reset();
+        }
+
+        InplaceDelegate& operator=(const InplaceDelegate& other) requires Copyable
+        {
+            if (this == &other)
+                return *this;
+
+            Reset();
+            if (other.manager)
+                other.manager(Operation::Copy, buffer, const_cast<Byte*>(other.buffer));
+            else
+                std::memcpy(buffer, other.buffer, Capacity);
+            invoker = other.invoker;
+            manager = other.manager;
+            return *this;
+        }
+
+        InplaceDelegate& operator=(InplaceDelegate&& other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            Reset();
+            if (other.manager)
+                other.manager(Operation::Move, buffer, other.buffer);
+            else
+                std::memcpy(buffer, other.buffer, Capacity);
+            invoker = other.invoker;
+            manager = other.manager;
+            other.Reset();
+            return *this;
+        }
+
+        template <typename F>
+            requires std::is_invocable_r_v<ReturnType, std::decay_t<F>&, ArgTypes...> && (!std::is_same_v<std::decay_t<F>, InplaceDelegate>)
+                     && (!std::is_pointer_v<std::decay_t<F>>)
+                     && (!Copyable || std::is_copy_constructible_v<std::decay_t<F>>)
+        InplaceDelegate(F&& f) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F>)
+        {
+            Emplace<std::decay_t<F>>(std::forward<F>(f));
+        }
+
+        InplaceDelegate(ReturnType(*func)(ArgTypes...))
+        {
+            if (func == nullptr)
+                throw std::invalid_argument("Function pointer cannot be null.");
+
+            Emplace<FunctionType>(func);
+        }
+
+        template <class T>
+        InplaceDelegate(ReturnType(T::* func)(ArgTypes...), T* obj) noexcept
+        {
+            Emplace<BoundMember<T, ReturnType(T::*)(ArgTypes...)>>(func, obj);
+        }
+
+        template <class T>
+        InplaceDelegate(ReturnType(T::* func)(ArgTypes...) const, const T* obj) noexcept
+        {
+            Emplace<BoundMember<const T, ReturnType(T::*)(ArgTypes...) const>>(func, obj);
+        }
+
+        ~InplaceDelegate()
+        {
+            if (manager)
+                manager(Operation::Destroy, buffer, nullptr);
+        }
+
+        auto operator()(ArgTypes... args) -> decltype(auto)
+        {
+            return invoker(buffer, std::forward<ArgTypes>(args)...);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return invoker != nullptr;
+        }
+
+        /// \brief True if the stored callable can be relocated with memcpy.
+        [[nodiscard]] bool IsTriviallyRelocatable() const noexcept
+        {
+            return manager == nullptr;
+        }
+
+        /// \brief Destroys the stored callable, leaving the delegate empty.
+        void Reset() noexcept
+        {
+            if (manager)
+                manager(Operation::Destroy, buffer, nullptr);
+            invoker = nullptr;
+            manager = nullptr;
+        }
+
+    private:
+        enum class Operation : UInt8
+        {
+            Copy,
+            Move,
+            Destroy
+        };
+
+        using InvokerFunc = ReturnType(*)(void*, ArgTypes &&...);
+        using ManagerFunc = void (*)(Operation, void* dst, void* src);
+
+        template <class T, typename MemberFunc>
+        struct BoundMember
+        {
+            MemberFunc func;
+            T* obj;
+
+            ReturnType operator()(ArgTypes... args) const
+            {
+                return (obj->*func)(std::forward<ArgTypes>(args)...);
+            }
+        };
+
+        alignas(ALIGNMENT) Byte buffer[Capacity] {};
+        InvokerFunc invoker = nullptr;
+        ManagerFunc manager = nullptr;
+
+        template <typename Callable, typename... CtorArgs>
+        void Emplace(CtorArgs&&... ctorArgs)
+        {
+            static_assert(sizeof(Callable) <= Capacity, "Callable does not fit the inline capacity of the InplaceDelegate.");
+            static_assert(alignof(Callable) <= ALIGNMENT, "Callable is over-aligned for the InplaceDelegate buffer.");
+
+            new(buffer) Callable(std::forward<CtorArgs>(ctorArgs)...);
+            invoker = InvokeCallable<Callable>;
+            if constexpr (!(std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>))
+                manager = ManageCallable<Callable>;
+        }
+
+        template <typename Callable>
+        inline static ReturnType InvokeCallable(void* storage, ArgTypes &&...args)
+        {
+            auto& callable = *std::launder(static_cast<Callable*>(storage));
+            return static_cast<ReturnType>(callable(std::forward<ArgTypes>(args)...));
+        }
+
+        template <typename Callable>
+        static void ManageCallable(Operation operation, void* dst, void* src)
+        {
+            switch (operation)
+            {
+                case Operation::Copy:
+                    // Only reached by copyable delegates, which only store copy constructible callables
+                    if constexpr (std::is_copy_constructible_v<Callable>)
+                        new(dst) Callable(*std::launder(static_cast<const Callable*>(src)));
+                    break;
+                case Operation::Move:
+                    new(dst) Callable(std::move(*std::launder(static_cast<Callable*>(src))));
+                    break;
+                case Operation::Destroy:
+                    std::launder(static_cast<Callable*>(dst))->~Callable();
+                    break;
+            }
+        }
+    };
+
+}
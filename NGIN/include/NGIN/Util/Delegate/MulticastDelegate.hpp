@@ -0,0 +1,344 @@
+#pragma once
+#include <NGIN/Defines.hpp>
+#include <type_traits>
+#include <concepts>
+#include <cstring>
+#include <stdexcept>
+#include <limits>
+#include <vector>
+#include <new>
+#include <algorithm>
+#include <functional>
+
+namespace NGIN::Util
+{
+    /// \brief Default size of the inline state of each MulticastDelegate callback, large enough for a bound member function.
+    inline constexpr Size MULTICAST_DELEGATE_DEFAULT_STATE_SIZE = sizeof(void*) * 3;
+
+    template <typename FuncType, Size StateSize = MULTICAST_DELEGATE_DEFAULT_STATE_SIZE>
+    class MulticastDelegate;
+
+    /// \class MulticastDelegate
+    /// \brief Broadcasts a call to a list of callbacks stored in structure-of-arrays form.
+    ///
+    /// The invocation list is two contiguous arrays, one of invoker pointers and one of inline callable states,
+    /// so broadcasting to N callbacks is a linear walk without per-callback indirection to the heap.
+    /// Callbacks must be trivially copyable and destructible (function pointers, bound members,
+    /// lambdas capturing pointers or PODs), which keeps both arrays relocatable with memcpy.
+    ///
+    /// Add returns a generation-checked token used to remove the callback in O(1). Removal swaps the last
+    /// callback into the freed position, so the broadcast order is not preserved across removals.
+    /// Callbacks added or removed during a broadcast take effect once the broadcast returns.
+    /// \tparam StateSize The size of the inline state of each callback in bytes.
+    template <typename... ArgTypes, Size StateSize>
+    class MulticastDelegate<void(ArgTypes...), StateSize>
+    {
+    public:
+        /// \brief Token identifying a callback added to the delegate.
+        struct Token
+        {
+            static constexpr UInt32 INVALID_INDEX = std::numeric_limits<UInt32>::max();
+
+            UInt32 index = INVALID_INDEX;
+            UInt32 generation = 0;
+
+            [[nodiscard]] bool IsValid() const noexcept
+            { return index != INVALID_INDEX; }
+        };
+
+        /// \brief True if a callable of type F can be added to this delegate.
+        template <typename F>
+        static constexpr bool Fits = sizeof(std::decay_t<F>) <= StateSize && alignof(std::decay_t<F>) <= alignof(void*)
+                                     && std::is_trivially_copyable_v<std::decay_t<F>> && std::is_trivially_destructible_v<std::decay_t<F>>;
+
+        MulticastDelegate() = default;
+
+        /// \brief Adds a callable to the invocation list.
+        /// \return Token that can be passed to Remove.
+        template <typename F>
+            requires std::is_invocable_v<std::decay_t<F>&, ArgTypes&...> && (!std::is_pointer_v<std::decay_t<F>>)
+        Token Add(F&& f)
+        {
+            return Emplace<std::decay_t<F>>(std::forward<F>(f));
+        }
+
+        /// \brief Adds a free function to the invocation list.
+        Token Add(void(*func)(ArgTypes...))
+        {
+            if (func == nullptr)
+                throw std::invalid_argument("Function pointer cannot be null.");
+
+            return Emplace<void(*)(ArgTypes...)>(func);
+        }
+
+        /// \brief Adds a member function bound to an instance to the invocation list.
+        template <class T>
+        Token Add(void(T::* func)(ArgTypes...), T* obj)
+        {
+            return Emplace<BoundMember<T, void(T::*)(ArgTypes...)>>(func, obj);
+        }
+
+        /// \brief Adds a const member function bound to an instance to the invocation list.
+        template <class T>
+        Token Add(void(T::* func)(ArgTypes...) const, const T* obj)
+        {
+            return Emplace<BoundMember<const T, void(T::*)(ArgTypes...) const>>(func, obj);
+        }
+
+        /// \brief Removes a callback from the invocation list.
+        /// \return True if the callback was removed, false if the token was stale or invalid.
+        bool Remove(const Token& token)
+        {
+            if (!Contains(token))
+                return false;
+
+            auto& slot = slots[token.index];
+            if (isBroadcasting)
+            {
+                // Silence the callback now, swap-remove it once the broadcast is done
+                if (slot.denseIndex & PENDING_BIT)
+                    pendingOwners[slot.denseIndex & ~PENDING_BIT] = Token::INVALID_INDEX;
+                else
+                {
+                    invokers[slot.denseIndex] = &InvokeNothing;
+                    deferredRemovals.push_back(slot.denseIndex);
+                }
+            } else
+            {
+                SwapRemove(slot.denseIndex);
+            }
+
+            slot.denseIndex = Token::INVALID_INDEX;
+            ++slot.generation;
+            freeSlots.push_back(token.index);
+            return true;
+        }
+
+        /// \brief Checks if a token still refers to a callback in the invocation list.
+        [[nodiscard]] bool Contains(const Token& token) const noexcept
+        {
+            return token.index < slots.size()
+                   && slots[token.index].generation == token.generation
+                   && slots[token.index].denseIndex != Token::INVALID_INDEX;
+        }
+
+        /// \brief Invokes every callback with the given arguments.
+        void operator()(ArgTypes... args)
+        {
+            Broadcast(args...);
+        }
+
+        /// \brief Invokes every callback with the given arguments.
+        /// Arguments are passed as lvalues to each callback.
+        void Broadcast(ArgTypes... args)
+        {
+            const bool outermost = !isBroadcasting;
+            {
+                const BroadcastScope scope(isBroadcasting);
+                const Size count = invokers.size();
+                const InvokerFunc* invoker = invokers.data();
+                State* state = states.data();
+                for (Size i = 0; i < count; ++i)
+                    invoker[i](&state[i], args...);
+            }
+
+            if (outermost)
+                ApplyDeferred();
+        }
+
+        /// \brief Number of callbacks in the invocation list.
+        [[nodiscard]] Size GetSize() const noexcept
+        {
+            return invokers.size() - deferredRemovals.size();
+        }
+
+        [[nodiscard]] bool IsEmpty() const noexcept
+        {
+            return GetSize() == 0;
+        }
+
+        /// \brief Removes every callback, invalidating all tokens.
+        void Clear()
+        {
+            for (UInt32 i = 0; i < slots.size(); ++i)
+            {
+                if (slots[i].denseIndex == Token::INVALID_INDEX)
+                    continue;
+                slots[i].denseIndex = Token::INVALID_INDEX;
+                ++slots[i].generation;
+                freeSlots.push_back(i);
+            }
+
+            if (isBroadcasting)
+            {
+                for (auto& invoker: invokers)
+                    invoker = &InvokeNothing;
+                deferredRemovals.clear();
+                for (UInt32 i = 0; i < invokers.size(); ++i)
+                    deferredRemovals.push_back(i);
+                for (auto& owner: pendingOwners)
+                    owner = Token::INVALID_INDEX;
+                return;
+            }
+
+            invokers.clear();
+            states.clear();
+            owners.clear();
+        }
+
+    private:
+        static constexpr UInt32 PENDING_BIT = 1u << 31;
+
+        using InvokerFunc = void (*)(void*, ArgTypes&...);
+
+        /// \brief Inline state of a single callback.
+        struct State
+        {
+            alignas(void*) Byte data[StateSize];
+        };
+
+        struct Slot
+        {
+            UInt32 denseIndex = Token::INVALID_INDEX;
+            UInt32 generation = 0;
+        };
+
+        template <class T, typename MemberFunc>
+        struct BoundMember
+        {
+            MemberFunc func;
+            T* obj;
+
+            void operator()(ArgTypes&... args) const
+            {
+                (obj->*func)(args...);
+            }
+        };
+
+        /// \brief Invoker pointers, walked in order on broadcast.
+        std::vector<InvokerFunc> invokers;
+        /// \brief Callable states, parallel to invokers.
+        std::vector<State> states;
+        /// \brief Slot index of each callback, parallel to invokers. Only touched on removal.
+        std::vector<UInt32> owners;
+
+        std::vector<Slot> slots;
+        std::vector<UInt32> freeSlots;
+
+        /// \brief Callbacks added during a broadcast.
+        std::vector<InvokerFunc> pendingInvokers;
+        std::vector<State> pendingStates;
+        std::vector<UInt32> pendingOwners;
+        /// \brief Dense indices removed during a broadcast.
+        std::vector<UInt32> deferredRemovals;
+
+        bool isBroadcasting = false;
+
+        /// \brief Marks a broadcast for its duration and restores the previous state on exit, also when a
+        /// callback throws, so later changes are not deferred forever.
+        struct BroadcastScope
+        {
+            explicit BroadcastScope(bool& flag) noexcept
+                    : flag(flag), previous(flag)
+            { flag = true; }
+
+            ~BroadcastScope()
+            { flag = previous; }
+
+            BroadcastScope(const BroadcastScope&) = delete;
+            BroadcastScope& operator=(const BroadcastScope&) = delete;
+
+            bool& flag;
+            bool previous;
+        };
+
+        template <typename Callable, typename... CtorArgs>
+        Token Emplace(CtorArgs&&... ctorArgs)
+        {
+            static_assert(sizeof(Callable) <= StateSize, "Callable does not fit the state size of the MulticastDelegate.");
+            static_assert(alignof(Callable) <= alignof(void*), "Callable is over-aligned for the MulticastDelegate state.");
+            static_assert(std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>,
+                          "MulticastDelegate callables must be trivially copyable and destructible.");
+
+            State state {};
+            new(state.data) Callable(std::forward<CtorArgs>(ctorArgs)...);
+
+            UInt32 slotIndex;
+            if (freeSlots.empty())
+            {
+                slotIndex = static_cast<UInt32>(slots.size());
+                slots.push_back({});
+            } else
+            {
+                slotIndex = freeSlots.back();
+                freeSlots.pop_back();
+            }
+
+            if (isBroadcasting)
+            {
+                slots[slotIndex].denseIndex = PENDING_BIT | static_cast<UInt32>(pendingInvokers.size());
+                pendingInvokers.push_back(&InvokeCallable<Callable>);
+                pendingStates.push_back(state);
+                pendingOwners.push_back(slotIndex);
+            } else
+            {
+                slots[slotIndex].denseIndex = static_cast<UInt32>(invokers.size());
+                invokers.push_back(&InvokeCallable<Callable>);
+                states.push_back(state);
+                owners.push_back(slotIndex);
+            }
+            return {slotIndex, slots[slotIndex].generation};
+        }
+
+        void SwapRemove(UInt32 denseIndex)
+        {
+            const UInt32 last = static_cast<UInt32>(invokers.size() - 1);
+            if (denseIndex != last)
+            {
+                invokers[denseIndex] = invokers[last];
+                states[denseIndex] = states[last];
+                owners[denseIndex] = owners[last];
+                slots[owners[denseIndex]].denseIndex = denseIndex;
+            }
+            invokers.pop_back();
+            states.pop_back();
+            owners.pop_back();
+        }
+
+        void ApplyDeferred()
+        {
+            if (!deferredRemovals.empty())
+            {
+                // Highest index first, so swapping in the last callback never moves a pending removal
+                std::sort(deferredRemovals.begin(), deferredRemovals.end(), std::greater<>());
+                for (const UInt32 denseIndex: deferredRemovals)
+                    SwapRemove(denseIndex);
+                deferredRemovals.clear();
+            }
+
+            for (Size i = 0; i < pendingInvokers.size(); ++i)
+            {
+                const UInt32 slotIndex = pendingOwners[i];
+                if (slotIndex == Token::INVALID_INDEX)
+                    continue;
+                slots[slotIndex].denseIndex = static_cast<UInt32>(invokers.size());
+                invokers.push_back(pendingInvokers[i]);
+                states.push_back(pendingStates[i]);
+                owners.push_back(slotIndex);
+            }
+            pendingInvokers.clear();
+            pendingStates.clear();
+            pendingOwners.clear();
+        }
+
+        template <typename Callable>
+        static void InvokeCallable(void* state, ArgTypes&... args)
+        {
+            (*std::launder(static_cast<Callable*>(state)))(args...);
+        }
+
+        static void InvokeNothing(void*, ArgTypes&...)
+        {}
+    };
+
+}
@@ -2,7 +2,9 @@
 #include <NGIN/Defines.hpp>
 #include <type_traits>
 #include <concepts>
+#include <cstring>
 #include <NGIN/Meta/StoragePolicy.hpp>
+#include <NGIN/Memory/Concepts.hpp>
 
 namespace NGIN::Util
 {
@@ -30,9 +32,8 @@ namespace NGIN::Util
 
         // Move constructor
         StaticDelegate(StaticDelegate&& other) noexcept
+            : storage(std::move(other.storage)), invoker(other.invoker)
         {
-            storage = std::move(other.storage);
-            invoker = other.invoker;
             other.invoker = nullptr;
         }
 
@@ -45,6 +46,7 @@ namespace NGIN::Util
             storage = std::move(other.storage);
             invoker = other.invoker;
             other.invoker = nullptr;
+            return *this;
         }
 
 
@@ -58,6 +60,14 @@ namespace NGIN::Util
             invoker = InvokeCallable<CallableType>;
         }
 
+        /// \brief Constructs from a callable, spilling it into alloc if it does not fit the inline buffer.
+        /// The allocator must outlive the delegate.
+        template <typename F, Memory::IsAllocator AllocatorType>
+            requires std::is_invocable_v<std::decay_t<F>, ArgTypes...> && (!std::is_same_v<std::decay_t<F>, StaticDelegate>)
+        StaticDelegate(F&& f, AllocatorType& alloc)
+            : storage(std::decay_t<F>(std::forward<F>(f)), alloc), invoker(InvokeCallable<std::decay_t<F>>)
+        {}
+
         StaticDelegate(ReturnType(*func)(ArgTypes...))
         {
 
@@ -102,7 +112,7 @@ namespace NGIN::Util
         auto operator()(ArgTypes... args) -> decltype(auto)
         {
 
-            return invoker(storage.get(), std::forward<ArgTypes>(args)...);
+            return invoker(storage, std::forward<ArgTypes>(args)...);
         }
 
 
@@ -112,21 +122,41 @@ namespace NGIN::Util
             return invoker != nullptr;
         }
 
+        /// \brief Relocates a range of delegates into uninitialized memory.
+        ///
+        /// The range is copied with a single memcpy, only callables that are stored inline and are not
+        /// trivially relocatable are then moved individually. The source delegates are left destroyed
+        /// and must not be used or destructed afterwards.
+        /// \param dst Uninitialized memory for count delegates, must not overlap src.
+        /// \param src The delegates to relocate.
+        /// \param count Number of delegates.
+        static void Relocate(StaticDelegate* dst, StaticDelegate* src, Size count) noexcept
+        {
+            if (count == 0)
+                return;
+
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(StaticDelegate) * count);
+            for (Size i = 0; i < count; ++i)
+                StorageType::CompleteRelocation(dst[i].storage, src[i].storage);
+        }
 
 
     private:
         static constexpr size_t BUFFER_SIZE = sizeof(void*) * 4;
 
-        using InvokerFunc = ReturnType(*)(void*, ArgTypes &&...);
         using StorageType = Meta::StoragePolicy::HybridStorage<BUFFER_SIZE>;
+        using InvokerFunc = ReturnType(*)(StorageType&, ArgTypes &&...);
 
         StorageType storage;
         InvokerFunc invoker = nullptr;
 
+        /// \brief Invokes a callable of a known type.
+        /// Whether the callable lives inline or on the heap is resolved at compile time,
+        /// so invocation is a single indirect call without a storage branch.
         template <typename Callable>
-        inline static auto InvokeCallable(void* storage, ArgTypes &&...args) -> decltype(auto)
+        inline static auto InvokeCallable(StorageType& storage, ArgTypes &&...args) -> decltype(auto)
         {
-            auto& callable = *static_cast<Callable*>(storage);
+            auto& callable = *storage.template get<Callable>();
             return callable(std::forward<ArgTypes>(args)...);
         }
     };
@@ -0,0 +1,103 @@
+#include <NGIN/Async/CoroutineScheduler.hpp>
+
+#include <algorithm>
+
+namespace NGIN::Async
+{
+    namespace
+    {
+        /// \brief Orders the timed resumes as a min-heap.
+        constexpr auto IS_LATER = [](const auto& a, const auto& b) { return a.time > b.time; };
+    }
+
+    CoroutineScheduler::~CoroutineScheduler()
+    {
+        // Destroying a root destroys the tasks it awaits through their Task objects
+        for (RootHandle root: roots)
+            root.destroy();
+    }
+
+    void CoroutineScheduler::Spawn(Task<void> task)
+    {
+        RootHandle root = task.Release();
+        if (!root)
+            return;
+
+        root.promise().scheduler = this;
+        root.promise().finishedCounter = &finishedRootCount;
+        roots.push_back(root);
+        root.resume();
+    }
+
+    void CoroutineScheduler::Update()
+    {
+        ++frame;
+
+        resuming.swap(nextFrame);
+        for (std::coroutine_handle<> handle: resuming)
+            handle.resume();
+        resuming.clear();
+
+        const F64 now = GetTime();
+        while (!timed.empty() && timed.front().time <= now)
+        {
+            std::pop_heap(timed.begin(), timed.end(), IS_LATER);
+            std::coroutine_handle<> handle = timed.back().handle;
+            timed.pop_back();
+            handle.resume();
+        }
+
+        if (finishedRootCount > 0)
+            DestroyFinishedRoots();
+    }
+
+    F64 CoroutineScheduler::GetTime() const
+    {
+        return timer.ElapsedSeconds();
+    }
+
+    UInt64 CoroutineScheduler::GetFrame() const noexcept
+    {
+        return frame;
+    }
+
+    Size CoroutineScheduler::GetTaskCount() const noexcept
+    {
+        return roots.size() - finishedRootCount;
+    }
+
+    void CoroutineScheduler::ResumeNextFrame(std::coroutine_handle<> handle)
+    {
+        nextFrame.push_back(handle);
+    }
+
+    void CoroutineScheduler::ResumeAt(F64 time, std::coroutine_handle<> handle)
+    {
+        timed.push_back({time, handle});
+        std::push_heap(timed.begin(), timed.end(), IS_LATER);
+    }
+
+    void CoroutineScheduler::DestroyFinishedRoots()
+    {
+        std::exception_ptr firstException;
+        for (Size i = 0; i < roots.size();)
+        {
+            RootHandle root = roots[i];
+            if (!root.done())
+            {
+                ++i;
+                continue;
+            }
+
+            if (root.promise().exception && !firstException)
+                firstException = root.promise().exception;
+            root.destroy();
+            roots[i] = roots.back();
+            roots.pop_back();
+        }
+        finishedRootCount = 0;
+
+        if (firstException)
+            std::rethrow_exception(firstException);
+    }
+}
@@ -0,0 +1,325 @@
+#include <NGIN/Async/JobSystem.hpp>
+
+namespace NGIN::Async
+{
+    namespace
+    {
+        /// \brief Jobs moved between a thread cache and the shared free list at once.
+        constexpr Size JOB_BATCH_SIZE = 64;
+        /// \brief Jobs allocated per block.
+        constexpr Size JOB_BLOCK_SIZE = 256;
+        /// \brief Failed attempts to find a job before a worker goes to sleep.
+        constexpr UInt32 SPIN_COUNT = 64;
+
+        std::atomic<UInt64> nextSystemID = 1;
+
+        /// \brief System and index of the calling thread, if it belongs to a system.
+        thread_local UInt64 currentSystemID = 0;
+        thread_local UInt32 currentThreadIndex = JobSystem::ANY_THREAD;
+
+        /// \brief Recycled jobs of the calling thread.
+        struct JobCache
+        {
+            UInt64 systemID = 0;
+            std::vector<Job*> jobs;
+        };
+
+        thread_local JobCache jobCache;
+    }
+
+    JobSystem::JobSystem(UInt32 workerCount)
+            : systemID(nextSystemID.fetch_add(1, std::memory_order_relaxed))
+    {
+        const UInt32 threadCount = workerCount + 1;
+        contexts.reserve(threadCount);
+        for (UInt32 i = 0; i < threadCount; ++i)
+            contexts.emplace_back(CreateScope<ThreadContext>());
+
+        currentSystemID = systemID;
+        currentThreadIndex = MAIN_THREAD;
+
+        workers.reserve(workerCount);
+        for (UInt32 i = 1; i < threadCount; ++i)
+            workers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+
+    JobSystem::~JobSystem()
+    {
+        // Finish what this thread owns before the workers stop stealing
+        while (Job* job = FindJob(GetCurrentThreadIndex()))
+            Execute(job);
+
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stop.store(true);
+        }
+        sleepCondition.notify_all();
+
+        for (auto& worker: workers)
+            worker.join();
+
+        while (Job* job = FindJob(GetCurrentThreadIndex()))
+            Execute(job);
+
+        if (currentSystemID == systemID)
+        {
+            currentSystemID = 0;
+            currentThreadIndex = ANY_THREAD;
+        }
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        const UInt32 threadIndex = GetCurrentThreadIndex();
+        while (!counter.IsDone())
+        {
+            if (Job* job = FindJob(threadIndex))
+                Execute(job);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    Bool JobSystem::TryRunOne()
+    {
+        Job* job = FindJob(GetCurrentThreadIndex());
+        if (job == nullptr)
+            return false;
+
+        Execute(job);
+        return true;
+    }
+
+    UInt32 JobSystem::GetThreadCount() const noexcept
+    {
+        return static_cast<UInt32>(contexts.size());
+    }
+
+    UInt32 JobSystem::GetCurrentThreadIndex() const noexcept
+    {
+        return currentSystemID == systemID ? currentThreadIndex : ANY_THREAD;
+    }
+
+    UInt32 JobSystem::DefaultWorkerCount() noexcept
+    {
+        const UInt32 hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    Job* JobSystem::AllocateJob()
+    {
+        if (jobCache.systemID != systemID)
+        {
+            jobCache.systemID = systemID;
+            jobCache.jobs.clear();
+        }
+
+        if (jobCache.jobs.empty())
+        {
+            std::lock_guard<std::mutex> lock(jobPoolMutex);
+            if (freeJobs.empty())
+            {
+                jobBlocks.emplace_back(std::make_unique<Job[]>(JOB_BLOCK_SIZE));
+                for (Size i = 0; i < JOB_BLOCK_SIZE; ++i)
+                    jobCache.jobs.push_back(&jobBlocks.back()[i]);
+            } else
+            {
+                const Size count = freeJobs.size() < JOB_BATCH_SIZE ? freeJobs.size() : JOB_BATCH_SIZE;
+                jobCache.jobs.insert(jobCache.jobs.end(), freeJobs.end() - count, freeJobs.end());
+                freeJobs.resize(freeJobs.size() - count);
+            }
+        }
+
+        Job* job = jobCache.jobs.back();
+        jobCache.jobs.pop_back();
+        return job;
+    }
+
+    void JobSystem::FreeJob(Job* job)
+    {
+        job->function.Reset();
+        job->counter = nullptr;
+        job->affinity = ANY_THREAD;
+
+        if (jobCache.systemID != systemID)
+        {
+            jobCache.systemID = systemID;
+            jobCache.jobs.clear();
+        }
+        jobCache.jobs.push_back(job);
+
+        // Hand surplus jobs back so threads that mostly spawn do not starve threads that mostly run
+        if (jobCache.jobs.size() > JOB_BATCH_SIZE * 2)
+        {
+            std::lock_guard<std::mutex> lock(jobPoolMutex);
+            freeJobs.insert(freeJobs.end(), jobCache.jobs.end() - JOB_BATCH_SIZE, jobCache.jobs.end());
+            jobCache.jobs.resize(jobCache.jobs.size() - JOB_BATCH_SIZE);
+        }
+    }
+
+    void JobSystem::Schedule(Job* job)
+    {
+        // The job may already run and be recycled once published, read it first
+        const UInt32 affinity = job->affinity;
+        if (affinity < contexts.size())
+        {
+            ThreadContext& context = *contexts[affinity];
+            {
+                std::lock_guard<std::mutex> lock(context.inboxMutex);
+                context.inbox.push_back(job);
+            }
+            context.inboxCount.fetch_add(1);
+
+            // Only a sleeping worker needs a wake up, the main thread polls its inbox while waiting
+            if (affinity != MAIN_THREAD)
+                WakeWorkers(true);
+            return;
+        }
+
+        stealableCount.fetch_add(1);
+
+        const UInt32 threadIndex = GetCurrentThreadIndex();
+        if (threadIndex == ANY_THREAD || !contexts[threadIndex]->queue.Push(job))
+        {
+            std::lock_guard<std::mutex> lock(injectionMutex);
+            injectionQueue.push_back(job);
+            injectionCount.fetch_add(1);
+        }
+
+        WakeWorkers(false);
+    }
+
+    Job* JobSystem::FindJob(UInt32 threadIndex)
+    {
+        const UInt32 threadCount = static_cast<UInt32>(contexts.size());
+        if (threadIndex < threadCount)
+        {
+            ThreadContext& context = *contexts[threadIndex];
+            if (context.inboxCount.load(std::memory_order_acquire) > 0)
+            {
+                std::lock_guard<std::mutex> lock(context.inboxMutex);
+                if (!context.inbox.empty())
+                {
+                    Job* job = context.inbox.front();
+                    context.inbox.pop_front();
+                    context.inboxCount.fetch_sub(1);
+                    return job;
+                }
+            }
+
+            if (Job* job = context.queue.Pop())
+            {
+                stealableCount.fetch_sub(1);
+                return job;
+            }
+        }
+
+        if (injectionCount.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(injectionMutex);
+            if (!injectionQueue.empty())
+            {
+                Job* job = injectionQueue.front();
+                injectionQueue.pop_front();
+                injectionCount.fetch_sub(1);
+                stealableCount.fetch_sub(1);
+                return job;
+            }
+        }
+
+        const UInt32 start = threadIndex < threadCount ? threadIndex + 1 : 0;
+        for (UInt32 offset = 0; offset < threadCount; ++offset)
+        {
+            const UInt32 victim = (start + offset) % threadCount;
+            if (victim == threadIndex)
+                continue;
+
+            if (Job* job = contexts[victim]->queue.Steal())
+            {
+                stealableCount.fetch_sub(1);
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void JobSystem::Execute(Job* job)
+    {
+        job->function();
+
+        JobCounter* counter = job->counter;
+        FreeJob(job);
+        if (counter)
+            Complete(*counter);
+    }
+
+    void JobSystem::Complete(JobCounter& counter)
+    {
+        counter.busy.fetch_add(1);
+        if (counter.value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::vector<Job*> continuations;
+            {
+                std::lock_guard<std::mutex> lock(counter.continuationMutex);
+                continuations.swap(counter.continuations);
+            }
+            for (Job* continuation: continuations)
+                Schedule(continuation);
+        }
+        counter.busy.fetch_sub(1, std::memory_order_release);
+    }
+
+    void JobSystem::WakeWorkers(Bool all)
+    {
+        if (sleepingCount.load() == 0)
+            return;
+
+        // Taking the lock orders the notification after a worker that is about to sleep has checked for work
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        if (all)
+            sleepCondition.notify_all();
+        else
+            sleepCondition.notify_one();
+    }
+
+    void JobSystem::WorkerLoop(UInt32 index)
+    {
+        currentSystemID = systemID;
+        currentThreadIndex = index;
+
+        ThreadContext& context = *contexts[index];
+        UInt32 failedAttempts = 0;
+        while (true)
+        {
+            if (Job* job = FindJob(index))
+            {
+                Execute(job);
+                failedAttempts = 0;
+                continue;
+            }
+
+            if (++failedAttempts < SPIN_COUNT)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            failedAttempts = 0;
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepingCount.fetch_add(1);
+            sleepCondition.wait(lock, [this, &context]()
+            {
+                return stealableCount.load() > 0 || context.inboxCount.load() > 0 || stop.load();
+            });
+            sleepingCount.fetch_sub(1);
+
+            if (stop.load() && stealableCount.load() <= 0 && context.inboxCount.load() <= 0)
+                break;
+        }
+
+        currentSystemID = 0;
+        currentThreadIndex = ANY_THREAD;
+    }
+}
@@ -0,0 +1,95 @@
+#include <NGIN/Async/Task.hpp>
+#include <NGIN/Memory/FallbackAllocator.hpp>
+#include <NGIN/Memory/Mallocator.hpp>
+#include <NGIN/Memory/PoolAllocator.hpp>
+
+#include <mutex>
+#include <new>
+
+namespace NGIN::Async::Internal
+{
+    namespace
+    {
+        /// \brief Frame sizes served by pools, larger frames go to the fallback allocator directly.
+        constexpr Size FRAME_SIZE_CLASSES[] = {128, 256, 512, 1024, 2048};
+        constexpr Size SIZE_CLASS_COUNT = std::size(FRAME_SIZE_CLASSES);
+        /// \brief Frames preallocated per size class, further frames spill to the fallback allocator.
+        constexpr Size FRAMES_PER_POOL = 128;
+
+        struct FramePool
+        {
+            explicit FramePool(Size frameSize)
+                    : allocator(Memory::PoolAllocator(frameSize, FRAMES_PER_POOL), Memory::Mallocator())
+            {}
+
+            // Frames may be created and destroyed on any thread, e.g. from jobs
+            std::mutex mutex;
+            Memory::FallbackAllocator<Memory::PoolAllocator, Memory::Mallocator> allocator;
+        };
+
+        struct FramePools
+        {
+            FramePool pools[SIZE_CLASS_COUNT] = {
+                    FramePool(FRAME_SIZE_CLASSES[0]), FramePool(FRAME_SIZE_CLASSES[1]), FramePool(FRAME_SIZE_CLASSES[2]),
+                    FramePool(FRAME_SIZE_CLASSES[3]), FramePool(FRAME_SIZE_CLASSES[4])};
+            std::mutex oversizedMutex;
+            Memory::Mallocator oversized;
+        };
+
+        FramePools& GetFramePools()
+        {
+            // Never destroyed, frames of static tasks may outlive any other static
+            static FramePools* pools = new FramePools();
+            return *pools;
+        }
+
+        Size GetSizeClass(Size size) noexcept
+        {
+            for (Size i = 0; i < SIZE_CLASS_COUNT; ++i)
+            {
+                if (size <= FRAME_SIZE_CLASSES[i])
+                    return i;
+            }
+            return SIZE_CLASS_COUNT;
+        }
+    }
+
+    void* AllocateCoroutineFrame(Size size)
+    {
+        FramePools& pools = GetFramePools();
+        const Size sizeClass = GetSizeClass(size);
+
+        void* frame = nullptr;
+        if (sizeClass < SIZE_CLASS_COUNT)
+        {
+            FramePool& pool = pools.pools[sizeClass];
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            frame = pool.allocator.Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        } else
+        {
+            std::lock_guard<std::mutex> lock(pools.oversizedMutex);
+            frame = pools.oversized.Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        }
+
+        if (frame == nullptr)
+            throw std::bad_alloc();
+        return frame;
+    }
+
+    void DeallocateCoroutineFrame(void* ptr, Size size) noexcept
+    {
+        FramePools& pools = GetFramePools();
+        const Size sizeClass = GetSizeClass(size);
+
+        if (sizeClass < SIZE_CLASS_COUNT)
+        {
+            FramePool& pool = pools.pools[sizeClass];
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            pool.allocator.Deallocate(ptr);
+        } else
+        {
+            std::lock_guard<std::mutex> lock(pools.oversizedMutex);
+            pools.oversized.Deallocate(ptr);
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#include <NGIN/Core/ECS/Archetype.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace NGIN::Core::ECS
+{
+    namespace
+    {
+        constexpr Size AlignUp(Size value, Size alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        /// \brief Size of the chunk header, a changed and an added tick per column.
+        Size GetHeaderSize(Size columnCount) noexcept
+        {
+            return 2 * sizeof(UInt64) * columnCount;
+        }
+
+        /// \brief Lays out the columns for a capacity after the header and entity column, returns the bytes used.
+        Size LayoutColumns(std::vector<Archetype::Column>& columns, UInt32 capacity) noexcept
+        {
+            Size offset = GetHeaderSize(columns.size()) + sizeof(Entity) * capacity;
+            for (Archetype::Column& column: columns)
+            {
+                offset = AlignUp(offset, column.info->alignment);
+                column.offset = offset;
+                offset += column.info->size * capacity;
+            }
+            return offset;
+        }
+    }
+
+    Archetype::Archetype(std::vector<const ComponentInfo*> components, ChunkAllocator& allocator)
+            : allocator(&allocator)
+    {
+        signature.reserve(components.size());
+        columns.reserve(components.size());
+
+        Size rowSize = sizeof(Entity);
+        entitiesOffset = GetHeaderSize(components.size());
+        for (const ComponentInfo* info: components)
+        {
+            if (info->alignment > CHUNK_ALIGNMENT)
+                throw std::invalid_argument("Component " + String(info->name) + " is aligned stricter than a chunk.");
+            signature.push_back(info->id);
+            columns.push_back({info, 0});
+            rowSize += info->size;
+        }
+
+        // Start from the capacity ignoring padding and shrink until the padded layout fits
+        UInt32 capacity = static_cast<UInt32>(entitiesOffset < CHUNK_SIZE ? (CHUNK_SIZE - entitiesOffset) / rowSize : 0);
+        while (capacity > 0 && LayoutColumns(columns, capacity) > CHUNK_SIZE)
+            --capacity;
+        if (capacity == 0)
+            throw std::length_error("Archetype row does not fit in a chunk.");
+        chunkCapacity = capacity;
+    }
+
+    Archetype::~Archetype()
+    {
+        for (Size i = 0; i < chunks.size(); ++i)
+        {
+            DestroyRows(i, 0, chunks[i].count);
+            allocator->Deallocate(chunks[i].memory);
+        }
+    }
+
+    UInt32 Archetype::FindColumn(Meta::TypeIDType id) const noexcept
+    {
+        const auto it = std::lower_bound(signature.begin(), signature.end(), id);
+        if (it == signature.end() || *it != id)
+            return INVALID_COLUMN;
+        return static_cast<UInt32>(it - signature.begin());
+    }
+
+    Size Archetype::GetEntityCount() const noexcept
+    {
+        if (chunks.empty())
+            return 0;
+        return (chunks.size() - 1) * chunkCapacity + chunks.back().count;
+    }
+
+    Archetype::Location Archetype::AllocateRow(Entity entity)
+    {
+        if (chunks.empty() || chunks.back().count == chunkCapacity)
+        {
+            chunks.push_back({allocator->Allocate(), 0});
+            std::fill_n(GetChangedTicks(chunks.size() - 1), 2 * columns.size(), UInt64(0));
+        }
+
+        const UInt32 chunkIndex = static_cast<UInt32>(chunks.size() - 1);
+        Chunk& chunk = chunks.back();
+        const UInt32 row = chunk.count++;
+        GetEntities(chunkIndex)[row] = entity;
+        return {chunkIndex, row};
+    }
+
+    void Archetype::AdoptChunk(std::byte* memory, UInt32 count)
+    {
+        if (count == 0 || count > chunkCapacity)
+            throw std::invalid_argument("Adopted chunk row count is out of range.");
+        // Only the last chunk may be partially filled
+        if (!chunks.empty() && chunks.back().count != chunkCapacity)
+            throw std::invalid_argument("Cannot adopt a chunk after a partially filled one.");
+        chunks.push_back({memory, count});
+    }
+
+    Entity Archetype::RemoveRow(Location location, Bool destroyComponents)
+    {
+        if (destroyComponents)
+            DestroyRows(location.chunk, location.row, location.row + 1);
+
+        const Size lastChunkIndex = chunks.size() - 1;
+        Chunk& lastChunk = chunks.back();
+        const UInt32 lastRow = lastChunk.count - 1;
+
+        Entity moved;
+        if (location.chunk != lastChunkIndex || location.row != lastRow)
+        {
+            moved = GetEntities(lastChunkIndex)[lastRow];
+            GetEntities(location.chunk)[location.row] = moved;
+            for (UInt32 i = 0; i < columns.size(); ++i)
+            {
+                MergeTicks(i, location.chunk, GetChangedTicks(lastChunkIndex)[i], GetAddedTicks(lastChunkIndex)[i]);
+                RelocateComponents(*columns[i].info,
+                                   GetComponent(i, location),
+                                   GetComponent(i, {static_cast<UInt32>(lastChunkIndex), lastRow}),
+                                   1);
+            }
+        }
+
+        if (--lastChunk.count == 0)
+        {
+            allocator->Deallocate(lastChunk.memory);
+            chunks.pop_back();
+        }
+        return moved;
+    }
+
+    void Archetype::DestroyRows(Size chunkIndex, UInt32 begin, UInt32 end) noexcept
+    {
+        for (UInt32 i = 0; i < columns.size(); ++i)
+        {
+            const ComponentInfo& info = *columns[i].info;
+            if (info.trivial)
+                continue;
+            std::byte* data = GetColumnData(i, chunkIndex);
+            for (UInt32 row = begin; row < end; ++row)
+                info.destroy(data + row * info.size);
+        }
+    }
+}
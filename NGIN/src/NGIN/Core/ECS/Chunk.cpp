@@ -0,0 +1,85 @@
+#include <NGIN/Core/ECS/Chunk.hpp>
+
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+namespace NGIN::Core::ECS
+{
+    std::byte* ChunkAllocator::Allocate()
+    {
+        void* memory = nullptr;
+        if (currentPage < pages.size())
+            memory = pages[currentPage]->Allocate(CHUNK_SIZE, CHUNK_ALIGNMENT);
+
+        for (Size i = 0; memory == nullptr && i < pages.size(); ++i)
+        {
+            memory = pages[i]->Allocate(CHUNK_SIZE, CHUNK_ALIGNMENT);
+            if (memory)
+                currentPage = i;
+        }
+
+        for (Size i = 0; memory == nullptr && i < externalChunks.size(); ++i)
+        {
+            if (!externalChunks[i].freeChunks.empty())
+            {
+                memory = externalChunks[i].freeChunks.back();
+                externalChunks[i].freeChunks.pop_back();
+            }
+        }
+
+        if (memory == nullptr)
+        {
+            pages.emplace_back(CreateScope<Memory::PoolAllocator>(CHUNK_SIZE, CHUNKS_PER_PAGE, CHUNK_ALIGNMENT));
+            currentPage = pages.size() - 1;
+            memory = pages.back()->Allocate(CHUNK_SIZE, CHUNK_ALIGNMENT);
+            if (memory == nullptr)
+                throw std::bad_alloc();
+        }
+
+        ++allocatedCount;
+        return static_cast<std::byte*>(memory);
+    }
+
+    void ChunkAllocator::Deallocate(std::byte* memory)
+    {
+        if (memory == nullptr)
+            return;
+
+        for (Size i = 0; i < pages.size(); ++i)
+        {
+            if (pages[i]->Owns(memory))
+            {
+                pages[i]->Deallocate(memory);
+                --allocatedCount;
+                return;
+            }
+        }
+        for (ExternalChunks& external: externalChunks)
+        {
+            if (memory >= external.memory && memory < external.memory + external.count * CHUNK_SIZE)
+            {
+                external.freeChunks.push_back(memory);
+                --allocatedCount;
+                return;
+            }
+        }
+    }
+
+    void ChunkAllocator::AdoptChunks(std::byte* memory, Size count, std::shared_ptr<void> owner)
+    {
+        if (reinterpret_cast<std::uintptr_t>(memory) % CHUNK_ALIGNMENT != 0)
+            throw std::invalid_argument("Adopted chunks must be aligned to CHUNK_ALIGNMENT.");
+        if (count == 0)
+            return;
+
+        externalChunks.push_back({memory, count, std::move(owner), {}});
+        externalChunks.back().freeChunks.reserve(count);
+        allocatedCount += count;
+    }
+
+    Size ChunkAllocator::GetAllocatedCount() const noexcept
+    {
+        return allocatedCount;
+    }
+}
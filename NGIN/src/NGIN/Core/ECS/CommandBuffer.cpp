@@ -0,0 +1,52 @@
+#include <NGIN/Core/ECS/CommandBuffer.hpp>
+
+namespace NGIN::Core::ECS
+{
+    CommandBuffer::~CommandBuffer()
+    {
+        Clear();
+    }
+
+    void CommandBuffer::Clear()
+    {
+        for (Command& command: commands)
+        {
+            for (UInt32 i = 0; i < command.componentCount; ++i)
+            {
+                ComponentValue& component = command.components[i];
+                if (component.value)
+                    component.info->destroy(component.value);
+                component.value = nullptr;
+            }
+        }
+        commands.clear();
+
+        for (Memory::LinearAllocator& block: blocks)
+            block.DeallocateAll();
+        currentBlock = 0;
+    }
+
+    void CommandBuffer::DropLastCommand() noexcept
+    {
+        Command& command = commands.back();
+        for (UInt32 i = 0; i < command.componentCount; ++i)
+            command.components[i].info->destroy(command.components[i].value);
+        commands.pop_back();
+    }
+
+    void* CommandBuffer::Allocate(Size size, Size alignment)
+    {
+        for (; currentBlock < blocks.size(); ++currentBlock)
+        {
+            if (void* memory = blocks[currentBlock].Allocate(size, alignment))
+                return memory;
+        }
+
+        blocks.emplace_back(std::max(BLOCK_SIZE, size + alignment));
+        currentBlock = blocks.size() - 1;
+        void* memory = blocks.back().Allocate(size, alignment);
+        if (memory == nullptr)
+            throw std::bad_alloc();
+        return memory;
+    }
+}
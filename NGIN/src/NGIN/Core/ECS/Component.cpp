@@ -0,0 +1,37 @@
+#include <NGIN/Core/ECS/Component.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace NGIN::Core::ECS
+{
+    namespace
+    {
+        struct ComponentRegistry
+        {
+            std::mutex mutex;
+            std::unordered_map<Meta::TypeIDType, const ComponentInfo*> infos;
+        };
+
+        ComponentRegistry& GetRegistry()
+        {
+            static ComponentRegistry registry;
+            return registry;
+        }
+    }
+
+    void RegisterComponent(const ComponentInfo& info)
+    {
+        ComponentRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.infos.emplace(info.id, &info);
+    }
+
+    const ComponentInfo* FindComponentInfo(Meta::TypeIDType id)
+    {
+        ComponentRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const auto it = registry.infos.find(id);
+        return it != registry.infos.end() ? it->second : nullptr;
+    }
+}
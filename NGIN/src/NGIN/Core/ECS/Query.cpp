@@ -0,0 +1,55 @@
+#include <NGIN/Core/ECS/Query.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+
+namespace NGIN::Core::ECS
+{
+    QueryState::QueryState(std::span<const Meta::TypeIDType> fetched,
+                           std::span<const Meta::TypeIDType> required,
+                           std::span<const Meta::TypeIDType> excluded,
+                           std::span<const Meta::TypeIDType> changed,
+                           std::span<const Meta::TypeIDType> added)
+            : fetched(fetched.begin(), fetched.end()),
+              required(required.begin(), required.end()),
+              excluded(excluded.begin(), excluded.end()),
+              changed(changed.begin(), changed.end()),
+              added(added.begin(), added.end())
+    {}
+
+    Bool QueryState::HasSignature(std::span<const Meta::TypeIDType> fetched,
+                                  std::span<const Meta::TypeIDType> required,
+                                  std::span<const Meta::TypeIDType> excluded,
+                                  std::span<const Meta::TypeIDType> changed,
+                                  std::span<const Meta::TypeIDType> added) const noexcept
+    {
+        return std::ranges::equal(this->fetched, fetched) && std::ranges::equal(this->required, required) &&
+               std::ranges::equal(this->excluded, excluded) && std::ranges::equal(this->changed, changed) &&
+               std::ranges::equal(this->added, added);
+    }
+
+    void QueryState::Update(std::span<const Scope<Archetype>> archetypes)
+    {
+        for (; checkedCount < archetypes.size(); ++checkedCount)
+        {
+            const Archetype& archetype = *archetypes[checkedCount];
+
+            Bool matchesSignature = true;
+            for (Meta::TypeIDType id: required)
+                matchesSignature = matchesSignature && archetype.Has(id);
+            for (Meta::TypeIDType id: excluded)
+                matchesSignature = matchesSignature && !archetype.Has(id);
+            if (!matchesSignature)
+            {
+                matchIndices.push_back(NO_MATCH);
+                continue;
+            }
+
+            matchIndices.push_back(static_cast<UInt32>(matches.size()));
+            matches.push_back(static_cast<UInt32>(checkedCount));
+            for (const std::vector<Meta::TypeIDType>* ids: {&fetched, &changed, &added})
+                for (Meta::TypeIDType id: *ids)
+                    columns.push_back(archetype.FindColumn(id));
+        }
+    }
+}
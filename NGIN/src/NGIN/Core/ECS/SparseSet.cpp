@@ -0,0 +1,92 @@
+#include <NGIN/Core/ECS/SparseSet.hpp>
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace NGIN::Core::ECS
+{
+    SparseSet::SparseSet(const ComponentInfo& info)
+            : info(&info)
+    {
+        if (info.storage != ComponentStorage::SparseSet)
+            throw std::invalid_argument("Component " + String(info.name) + " is not stored in sparse sets.");
+    }
+
+    SparseSet::~SparseSet()
+    {
+        if (!info->trivial)
+        {
+            for (UInt32 i = 0; i < entities.size(); ++i)
+                info->destroy(Get(i));
+        }
+        ::operator delete(data, std::align_val_t(info->alignment));
+    }
+
+    std::byte* SparseSet::Emplace(Entity entity)
+    {
+        UInt32& sparse = GetSparse(entity.GetIndex());
+        if (sparse != NO_INDEX)
+        {
+            if (entities[sparse] == entity)
+                throw std::invalid_argument("Entity already has component " + String(info->name) + ".");
+            // A stale handle of the slot was never removed, reuse its storage
+            if (!info->trivial)
+                info->destroy(Get(sparse));
+            entities[sparse] = entity;
+            return Get(sparse);
+        }
+
+        if (entities.size() == capacity)
+            Reallocate(std::max<Size>(capacity * 2, 16));
+        entities.push_back(entity);
+        sparse = static_cast<UInt32>(entities.size() - 1);
+        return Get(sparse);
+    }
+
+    Bool SparseSet::Remove(Entity entity) noexcept
+    {
+        const UInt32 dense = Find(entity);
+        if (dense == NO_INDEX)
+            return false;
+
+        const UInt32 last = static_cast<UInt32>(entities.size() - 1);
+        if (!info->trivial)
+            info->destroy(Get(dense));
+        if (dense != last)
+        {
+            RelocateComponents(*info, Get(dense), Get(last), 1);
+            entities[dense] = entities[last];
+            pages[entities[dense].GetIndex() / PAGE_SIZE][entities[dense].GetIndex() % PAGE_SIZE] = dense;
+        }
+        entities.pop_back();
+        pages[entity.GetIndex() / PAGE_SIZE][entity.GetIndex() % PAGE_SIZE] = NO_INDEX;
+        return true;
+    }
+
+    UInt32& SparseSet::GetSparse(UInt32 index)
+    {
+        const Size page = index / PAGE_SIZE;
+        if (page >= pages.size())
+            pages.resize(page + 1);
+        if (pages[page] == nullptr)
+        {
+            pages[page] = std::make_unique<UInt32[]>(PAGE_SIZE);
+            std::fill_n(pages[page].get(), PAGE_SIZE, NO_INDEX);
+        }
+        return pages[page][index % PAGE_SIZE];
+    }
+
+    void SparseSet::Reallocate(Size newCapacity)
+    {
+        std::byte* newData = static_cast<std::byte*>(::operator new(newCapacity * info->size, std::align_val_t(info->alignment)));
+        if (data != nullptr)
+        {
+            RelocateComponents(*info, newData, data, entities.size());
+            ::operator delete(data, std::align_val_t(info->alignment));
+        }
+        data = newData;
+        capacity = newCapacity;
+        entities.reserve(newCapacity);
+    }
+}
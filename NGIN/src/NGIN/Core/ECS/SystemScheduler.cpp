@@ -0,0 +1,169 @@
+#include <NGIN/Core/ECS/SystemScheduler.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace NGIN::Core::ECS
+{
+    namespace
+    {
+        /// \brief Batches per thread a system is split into, more than one so uneven chunks balance out.
+        constexpr Size BATCHES_PER_THREAD = 4;
+
+        Bool Intersects(const std::vector<Meta::TypeIDType>& a, const std::vector<Meta::TypeIDType>& b) noexcept
+        {
+            for (Meta::TypeIDType id: a)
+            {
+                if (std::find(b.begin(), b.end(), id) != b.end())
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    Bool SystemAccess::ConflictsWith(const SystemAccess& other) const noexcept
+    {
+        if (exclusive || other.exclusive)
+            return true;
+        return Intersects(writes, other.reads) || Intersects(writes, other.writes) || Intersects(reads, other.writes);
+    }
+
+    UInt32 SystemScheduler::AddSystem(Scope<System> system)
+    {
+        const UInt32 index = static_cast<UInt32>(nodes.size());
+        const Bool exclusive = system->GetAccess().exclusive;
+
+        Node node;
+        node.system = std::move(system);
+
+        // Exclusive systems get a stage of their own, as does the first system after one
+        if (exclusive || stages.empty() || nodes[stages.back().begin].system->GetAccess().exclusive)
+            stages.push_back({index, index});
+
+        for (UInt32 i = stages.back().begin; i < index; ++i)
+        {
+            if (nodes[i].system->GetAccess().ConflictsWith(node.system->GetAccess()))
+            {
+                nodes[i].dependents.push_back(index);
+                node.dependencies.push_back(i);
+            }
+        }
+        nodes.push_back(std::move(node));
+        stages.back().end = index + 1;
+
+        remainingDependencies = std::make_unique<std::atomic<UInt32>[]>(nodes.size());
+        remainingBatches = std::make_unique<std::atomic<UInt32>[]>(nodes.size());
+        return index;
+    }
+
+    Size SystemScheduler::GetSystemCount() const noexcept
+    {
+        return nodes.size();
+    }
+
+    const System& SystemScheduler::GetSystem(UInt32 index) const
+    {
+        if (index >= nodes.size())
+            throw std::out_of_range("System index out of range.");
+        return *nodes[index].system;
+    }
+
+    const std::vector<UInt32>& SystemScheduler::GetDependencies(UInt32 index) const
+    {
+        if (index >= nodes.size())
+            throw std::out_of_range("System index out of range.");
+        return nodes[index].dependencies;
+    }
+
+    Size SystemScheduler::GetStageCount() const noexcept
+    {
+        return stages.size();
+    }
+
+    void SystemScheduler::RunStage(UInt32 stageIndex, std::span<const Scope<Archetype>> archetypes, UInt64& changeTick,
+                                   F64 deltaTime, Async::JobSystem* jobSystem)
+    {
+        if (stageIndex >= stages.size())
+            throw std::out_of_range("Stage index out of range.");
+        const Stage stage = stages[stageIndex];
+        currentDeltaTime = deltaTime;
+
+        // Queries are resolved up front on this thread, matching updates shared caches
+        for (UInt32 i = stage.begin; i < stage.end; ++i)
+            nodes[i].itemCount = nodes[i].system->Prepare(archetypes, ++changeTick);
+
+        const Bool exclusive = nodes[stage.begin].system->GetAccess().exclusive;
+        if (jobSystem == nullptr || exclusive || jobSystem->GetThreadCount() < 2)
+        {
+            for (UInt32 i = stage.begin; i < stage.end; ++i)
+                nodes[i].system->Run(0, nodes[i].itemCount, currentDeltaTime);
+            return;
+        }
+
+        const Size batchesPerSystem = jobSystem->GetThreadCount() * BATCHES_PER_THREAD;
+        for (UInt32 i = stage.begin; i < stage.end; ++i)
+        {
+            Node& node = nodes[i];
+            node.batchSize = std::max<Size>(1, (node.itemCount + batchesPerSystem - 1) / batchesPerSystem);
+            remainingDependencies[i].store(static_cast<UInt32>(node.dependencies.size()), std::memory_order_relaxed);
+        }
+
+        currentJobSystem = jobSystem;
+        firstException = nullptr;
+        for (UInt32 i = stage.begin; i < stage.end; ++i)
+        {
+            if (nodes[i].dependencies.empty())
+                Schedule(i);
+        }
+        jobSystem->Wait(stageCounter);
+        currentJobSystem = nullptr;
+
+        if (firstException)
+            std::rethrow_exception(std::exchange(firstException, nullptr));
+    }
+
+    void SystemScheduler::Schedule(UInt32 index)
+    {
+        const Node& node = nodes[index];
+        if (node.itemCount == 0)
+        {
+            Finish(index);
+            return;
+        }
+
+        const Size batchCount = (node.itemCount + node.batchSize - 1) / node.batchSize;
+        remainingBatches[index].store(static_cast<UInt32>(batchCount), std::memory_order_relaxed);
+        for (Size begin = 0; begin < node.itemCount; begin += node.batchSize)
+        {
+            const Size end = std::min(begin + node.batchSize, node.itemCount);
+            currentJobSystem->Spawn([this, index, begin, end]() { RunBatch(index, begin, end); }, &stageCounter);
+        }
+    }
+
+    void SystemScheduler::RunBatch(UInt32 index, Size begin, Size end)
+    {
+        try
+        {
+            nodes[index].system->Run(begin, end, currentDeltaTime);
+        } catch (...)
+        {
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+            if (!firstException)
+                firstException = std::current_exception();
+        }
+
+        if (remainingBatches[index].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Finish(index);
+    }
+
+    void SystemScheduler::Finish(UInt32 index)
+    {
+        // Dependents still run after a failure so the stage always completes
+        for (const UInt32 dependent: nodes[index].dependents)
+        {
+            if (remainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Schedule(dependent);
+        }
+    }
+}
@@ -1,4 +1,6 @@
 #include <NGIN/Core/Engine.hpp>
+#include <NGIN/Logging.hpp>
+#include <fstream>
 #include <iostream>
 
 namespace NGIN::Core
@@ -8,22 +10,36 @@ namespace NGIN::Core
         eventBus.Subscribe<Events::Quit>(this, &Engine::Quit);
         isRunning = true;
         F64 delta = 0.0;
+        Async::JobSystem* tickJobSystem = parallelTick ? &GetJobSystem() : nullptr;
+        framePacer.Reset();
+        fixedTimestep.Reset();
+        profileReportTimer.Reset();
         while (!shouldQuit)
         {
-            timer.Reset();
-            for (auto& module: moduleVector)
-            {
-                module->OnPreTick(delta);
-            }
-            for (auto& module: moduleVector)
-            {
-                module->OnTick(delta);
-            }
-            for (auto& module: moduleVector)
+            const Time::Timer frameTimer;
+            coroutineScheduler.Update();
+
+            const UInt32 fixedSteps = fixedTimestep.Advance(delta);
+            for (UInt32 i = 0; i < fixedSteps; ++i)
+                moduleScheduler.RunPhase(TickPhase::FixedTick, fixedTimestep.GetStep(), tickJobSystem);
+
+            moduleScheduler.RunPhase(TickPhase::PreTick, delta, tickJobSystem);
+            moduleScheduler.RunPhase(TickPhase::Tick, delta, tickJobSystem);
+            world.RunSystems(delta, tickJobSystem);
+            moduleScheduler.RunPhase(TickPhase::PostTick, delta, tickJobSystem);
+            eventBus.FlushEvents();
+
+            if (profiling)
             {
-                module->OnPostTick(delta);
+                tickProfiler.RecordFrame(frameTimer.ElapsedSeconds());
+                if (profileReportInterval > 0.0 && profileReportTimer.ElapsedSeconds() >= profileReportInterval)
+                {
+                    ReportProfile();
+                    profileReportTimer.Reset();
+                }
             }
-            delta = timer.ElapsedSeconds();
+
+            delta = framePacer.WaitForNextFrame();
         }
         //Shutdown modules in reverse order
         for (auto it = moduleVector.rbegin(); it != moduleVector.rend(); ++it)
@@ -38,6 +54,87 @@ namespace NGIN::Core
         return eventBus;
     }
 
+    Async::JobSystem& Engine::GetJobSystem()
+    {
+        if (!jobSystem)
+            jobSystem = CreateScope<Async::JobSystem>();
+        return *jobSystem;
+    }
+
+    Async::CoroutineScheduler& Engine::GetCoroutineScheduler()
+    {
+        return coroutineScheduler;
+    }
+
+    World& Engine::GetWorld()
+    {
+        return world;
+    }
+
+    void Engine::SetParallelTick(Bool enabled)
+    {
+        parallelTick = enabled;
+    }
+
+    Bool Engine::IsParallelTick() const noexcept
+    {
+        return parallelTick;
+    }
+
+
+    void Engine::SetFramePacing(FramePacing pacing, F64 targetFrameRate)
+    {
+        framePacer.SetPacing(pacing, targetFrameRate);
+    }
+
+    void Engine::SetFixedTimestep(F64 step, UInt32 maxStepsPerFrame)
+    {
+        fixedTimestep = FixedTimestep(step, maxStepsPerFrame);
+    }
+
+    F64 Engine::GetInterpolationAlpha() const noexcept
+    {
+        return fixedTimestep.GetAlpha();
+    }
+
+
+    void Engine::SetProfiling(Bool enabled)
+    {
+        profiling = enabled;
+        moduleScheduler.SetProfiler(enabled ? &tickProfiler : nullptr);
+    }
+
+    Bool Engine::IsProfiling() const noexcept
+    {
+        return profiling;
+    }
+
+    const TickProfiler& Engine::GetTickProfiler() const noexcept
+    {
+        return tickProfiler;
+    }
+
+    void Engine::SetProfileReport(F64 intervalSeconds, const String& jsonPath)
+    {
+        profileReportInterval = intervalSeconds;
+        profileReportPath = jsonPath;
+        profileReportTimer.Reset();
+    }
+
+    void Engine::ReportProfile()
+    {
+        NGIN_INFO("Tick profile\n{}", tickProfiler.ToString());
+
+        if (!profileReportPath.empty())
+        {
+            std::ofstream file(profileReportPath, std::ios::trunc);
+            if (file)
+                file << tickProfiler.ToJSON();
+            else
+                NGIN_WARNING("Failed to write tick profile to {}", profileReportPath);
+        }
+    }
+
 
     void Engine::Quit()
     {
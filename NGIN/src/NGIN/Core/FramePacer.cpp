@@ -0,0 +1,66 @@
+#include <NGIN/Core/FramePacer.hpp>
+
+#include <thread>
+
+namespace NGIN::Core
+{
+    void FramePacer::SetPacing(FramePacing pacing, F64 targetFrameRate) noexcept
+    {
+        this->pacing = pacing;
+        if (targetFrameRate > 0.0)
+        {
+            this->targetFrameRate = targetFrameRate;
+            period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<F64>(1.0 / targetFrameRate));
+        }
+        deadline = frameStart + period;
+    }
+
+    void FramePacer::SetSpinThreshold(F64 seconds) noexcept
+    {
+        spinThreshold = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<F64>(seconds));
+    }
+
+    FramePacing FramePacer::GetPacing() const noexcept
+    {
+        return pacing;
+    }
+
+    F64 FramePacer::GetTargetFrameRate() const noexcept
+    {
+        return targetFrameRate;
+    }
+
+    void FramePacer::Reset()
+    {
+        frameStart = Clock::now();
+        deadline = frameStart + period;
+    }
+
+    F64 FramePacer::WaitForNextFrame()
+    {
+        if (pacing != FramePacing::Unlimited)
+        {
+            if (pacing == FramePacing::Precise)
+            {
+                // Sleeping overshoots by up to a scheduler quantum, so sleep short of the deadline and spin the rest
+                const Clock::time_point sleepUntil = deadline - spinThreshold;
+                if (Clock::now() < sleepUntil)
+                    std::this_thread::sleep_until(sleepUntil);
+                while (Clock::now() < deadline)
+                    std::this_thread::yield();
+            } else
+            {
+                std::this_thread::sleep_until(deadline);
+            }
+        }
+
+        const Clock::time_point now = Clock::now();
+        const F64 deltaTime = std::chrono::duration<F64>(now - frameStart).count();
+        frameStart = now;
+
+        deadline += period;
+        if (now > deadline)
+            deadline = now + period;
+        return deltaTime;
+    }
+}
@@ -0,0 +1,126 @@
+#include <NGIN/Core/ModuleScheduler.hpp>
+#include <NGIN/Core/TickProfiler.hpp>
+#include <NGIN/Time.hpp>
+
+#include <utility>
+
+namespace NGIN::Core
+{
+    void ModuleScheduler::AddModule(Module* module, const std::vector<UInt32>& dependencies, Bool mainThreadOnly)
+    {
+        const UInt32 index = static_cast<UInt32>(nodes.size());
+
+        Node node;
+        node.module = module;
+        node.mainThreadOnly = mainThreadOnly;
+        for (const UInt32 dependency: dependencies)
+        {
+            if (dependency >= index)
+                continue;
+
+            nodes[dependency].dependents.push_back(index);
+            ++node.dependencyCount;
+        }
+        nodes.push_back(std::move(node));
+
+        remainingDependencies = std::make_unique<std::atomic<UInt32>[]>(nodes.size());
+    }
+
+    void ModuleScheduler::RunPhase(TickPhase phase, F64 deltaTime, Async::JobSystem* jobSystem)
+    {
+        if (jobSystem == nullptr || nodes.size() < 2)
+        {
+            for (UInt32 i = 0; i < nodes.size(); ++i)
+                RunProfiled(i, phase, deltaTime);
+            return;
+        }
+
+        currentPhase = phase;
+        currentDeltaTime = deltaTime;
+        currentJobSystem = jobSystem;
+        firstException = nullptr;
+        for (UInt32 i = 0; i < nodes.size(); ++i)
+            remainingDependencies[i].store(nodes[i].dependencyCount, std::memory_order_relaxed);
+
+        for (UInt32 i = 0; i < nodes.size(); ++i)
+        {
+            if (nodes[i].dependencyCount == 0)
+                Schedule(i);
+        }
+
+        // Main thread only modules are picked up from the main thread inbox while waiting
+        jobSystem->Wait(phaseCounter);
+        currentJobSystem = nullptr;
+
+        if (firstException)
+            std::rethrow_exception(std::exchange(firstException, nullptr));
+    }
+
+    Size ModuleScheduler::GetModuleCount() const noexcept
+    {
+        return nodes.size();
+    }
+
+    void ModuleScheduler::SetProfiler(TickProfiler* profiler) noexcept
+    {
+        this->profiler = profiler;
+    }
+
+    void ModuleScheduler::RunModule(Module* module, TickPhase phase, F64 deltaTime)
+    {
+        switch (phase)
+        {
+            case TickPhase::FixedTick:
+                module->OnFixedTick(deltaTime);
+                break;
+            case TickPhase::PreTick:
+                module->OnPreTick(deltaTime);
+                break;
+            case TickPhase::Tick:
+                module->OnTick(deltaTime);
+                break;
+            case TickPhase::PostTick:
+                module->OnPostTick(deltaTime);
+                break;
+        }
+    }
+
+    void ModuleScheduler::RunProfiled(UInt32 index, TickPhase phase, F64 deltaTime)
+    {
+        if (profiler == nullptr)
+        {
+            RunModule(nodes[index].module, phase, deltaTime);
+            return;
+        }
+
+        const Time::Timer timer;
+        RunModule(nodes[index].module, phase, deltaTime);
+        profiler->Record(index, phase, std::chrono::duration<F64>(timer.Elapsed<Time::Nanoseconds>()).count());
+    }
+
+    void ModuleScheduler::RunNode(UInt32 index)
+    {
+        try
+        {
+            RunProfiled(index, currentPhase, currentDeltaTime);
+        } catch (...)
+        {
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+            if (!firstException)
+                firstException = std::current_exception();
+        }
+
+        // Dependents still run after a failure so the phase always completes
+        for (const UInt32 dependent: nodes[index].dependents)
+        {
+            if (remainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Schedule(dependent);
+        }
+    }
+
+    void ModuleScheduler::Schedule(UInt32 index)
+    {
+        const UInt32 affinity = nodes[index].mainThreadOnly ? Async::JobSystem::MAIN_THREAD : Async::JobSystem::ANY_THREAD;
+        currentJobSystem->Spawn([this, index]() { RunNode(index); }, &phaseCounter, affinity);
+    }
+}
@@ -12,6 +12,10 @@ namespace NGIN::Core
     {
         this->engine = engine;
         SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+
+        // Dragging a window produces a resize/move event per SDL event, listeners only need the final one per frame
+        engine->GetEventBus().SetCoalescePolicy<Events::WindowResizeEvent, CoalescePolicy::KeepLatest>();
+        engine->GetEventBus().SetCoalescePolicy<Events::WindowMoveEvent, CoalescePolicy::KeepLatest>();
     }
 
     void SDLModule::OnPreTick(F64 deltaTime)
@@ -58,7 +62,7 @@ namespace NGIN::Core
             {
                 //window->Resize(event.window.data1, event.window.data2);
                 Events::WindowResizeEvent resizeEvent(event.window.data1, event.window.data2);
-                engine->GetEventBus().Publish(resizeEvent);
+                engine->GetEventBus().Publish(resizeEvent, EventMode::Queued);
                 break;
             }
             case SDL_WINDOWEVENT_CLOSE:
@@ -70,7 +74,7 @@ namespace NGIN::Core
             case SDL_WINDOWEVENT_MOVED:
             {
                 Events::WindowMoveEvent moveEvent(event.window.data1, event.window.data2);
-                engine->GetEventBus().Publish(moveEvent);
+                engine->GetEventBus().Publish(moveEvent, EventMode::Queued);
                 break;
             }
             case SDL_WINDOWEVENT_MINIMIZED:
@@ -0,0 +1,581 @@
+#include <NGIN/Core/SpatialIndex.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace NGIN::Core
+{
+    namespace
+    {
+        constexpr UInt32 NO_BUCKET = std::numeric_limits<UInt32>::max();
+
+        F32 DistanceSquared(glm::vec3 a, glm::vec3 b) noexcept
+        {
+            const glm::vec3 d = a - b;
+            return d.x * d.x + d.y * d.y + d.z * d.z;
+        }
+
+        /// \brief Squared distance from a point to the closest point of a box, 0 inside it.
+        F32 DistanceSquaredToBox(glm::vec3 point, glm::vec3 min, glm::vec3 max) noexcept
+        {
+            const glm::vec3 closest(std::clamp(point.x, min.x, max.x),
+                                    std::clamp(point.y, min.y, max.y),
+                                    std::clamp(point.z, min.z, max.z));
+            return DistanceSquared(point, closest);
+        }
+
+        Bool BoxesOverlap(glm::vec3 minA, glm::vec3 maxA, glm::vec3 minB, glm::vec3 maxB) noexcept
+        {
+            return minA.x <= maxB.x && maxA.x >= minB.x &&
+                   minA.y <= maxB.y && maxA.y >= minB.y &&
+                   minA.z <= maxB.z && maxA.z >= minB.z;
+        }
+
+        struct Item
+        {
+            glm::vec3 center;
+            F32 radius;
+            ECS::Entity entity;
+        };
+
+        Bool Intersects(const Item& item, const SpatialSphere& sphere) noexcept
+        {
+            const F32 reach = item.radius + sphere.radius;
+            return DistanceSquared(item.center, sphere.center) <= reach * reach;
+        }
+
+        Bool Intersects(const Item& item, const SpatialBox& box) noexcept
+        {
+            return DistanceSquaredToBox(item.center, box.min, box.max) <= item.radius * item.radius;
+        }
+
+        /// \brief Keeps the nearest item seen so far, within a maximum distance.
+        struct NearestSearch
+        {
+            glm::vec3 point;
+            F32 bestDistanceSquared;
+            ECS::Entity best = {};
+
+            void Visit(const std::vector<Item>& items) noexcept
+            {
+                for (const Item& item: items)
+                {
+                    const F32 distanceSquared = DistanceSquared(item.center, point);
+                    if (distanceSquared < bestDistanceSquared || (!best.IsValid() && distanceSquared == bestDistanceSquared))
+                    {
+                        bestDistanceSquared = distanceSquared;
+                        best = item.entity;
+                    }
+                }
+            }
+        };
+
+        /// \brief Items grouped in buckets, a grid cell or an octree node, with the bucket of every entity.
+        struct BucketStore
+        {
+            struct Location
+            {
+                UInt32 bucket = NO_BUCKET;
+                UInt32 slot = 0;
+            };
+
+            std::vector<std::vector<Item>> buckets;
+            /// \brief Location of each entity slot, indexed by the entity index.
+            std::vector<Location> locations;
+            Size count = 0;
+
+            /// \brief Location of an indexed entity, nullptr if it is not indexed.
+            [[nodiscard]] const Location* Find(ECS::Entity entity) const noexcept
+            {
+                if (!entity.IsValid() || entity.GetIndex() >= locations.size())
+                    return nullptr;
+                const Location& location = locations[entity.GetIndex()];
+                if (location.bucket == NO_BUCKET || buckets[location.bucket][location.slot].entity != entity)
+                    return nullptr;
+                return &location;
+            }
+
+            /// \return Bucket of the stale handle of the same entity slot the item replaced, NO_BUCKET if none.
+            UInt32 Insert(UInt32 bucket, const Item& item)
+            {
+                const UInt32 index = item.entity.GetIndex();
+                if (index >= locations.size())
+                    locations.resize(index + 1);
+                // A stale handle of the same slot was never removed, it is replaced
+                const UInt32 stale = locations[index].bucket;
+                if (stale != NO_BUCKET)
+                    Erase(locations[index]);
+
+                locations[index] = {bucket, static_cast<UInt32>(buckets[bucket].size())};
+                buckets[bucket].push_back(item);
+                ++count;
+                return stale;
+            }
+
+            void Erase(Location location) noexcept
+            {
+                std::vector<Item>& items = buckets[location.bucket];
+                locations[items[location.slot].entity.GetIndex()] = {};
+                if (location.slot != items.size() - 1)
+                {
+                    items[location.slot] = items.back();
+                    locations[items[location.slot].entity.GetIndex()].slot = location.slot;
+                }
+                items.pop_back();
+                --count;
+            }
+        };
+
+        /// \brief Uniform grid of cubic cells, stored sparsely by hashing the cell coordinates.
+        ///
+        /// An item lives in the cell holding its center, so queries widen their cell range by the largest
+        /// radius ever indexed. The grid suits items of similar size, a few huge items make every query
+        /// scan many cells.
+        class HashGrid final : public SpatialIndex
+        {
+        public:
+            explicit HashGrid(F32 cellSize)
+                    : cellSize(cellSize), inverseCellSize(1.0f / cellSize)
+            {
+            }
+
+            void Set(ECS::Entity entity, glm::vec3 center, F32 radius) override
+            {
+                if (!entity.IsValid())
+                    throw std::invalid_argument("Cannot index an invalid entity.");
+                radius = std::max(radius, 0.0f);
+                maxRadius = std::max(maxRadius, radius);
+
+                const UInt64 key = GetKey(center);
+                if (const BucketStore::Location* location = store.Find(entity))
+                {
+                    // Moving within a cell only updates the item
+                    if (keys[location->bucket] == key)
+                    {
+                        store.buckets[location->bucket][location->slot] = {center, radius, entity};
+                        return;
+                    }
+                    store.Erase(*location);
+                }
+                store.Insert(GetOrCreateCell(key), {center, radius, entity});
+            }
+
+            Bool Remove(ECS::Entity entity) override
+            {
+                const BucketStore::Location* location = store.Find(entity);
+                if (location == nullptr)
+                    return false;
+                store.Erase(*location);
+                return true;
+            }
+
+            Bool Contains(ECS::Entity entity) const noexcept override
+            {
+                return store.Find(entity) != nullptr;
+            }
+
+            Size GetCount() const noexcept override
+            {
+                return store.count;
+            }
+
+            void QueryRadius(std::span<const SpatialSphere> queries, SpatialQueryResults& results) const override
+            {
+                results.Clear();
+                for (const SpatialSphere& sphere: queries)
+                {
+                    const glm::vec3 reach(sphere.radius + maxRadius);
+                    ForEachCell(sphere.center - reach, sphere.center + reach, [&](const std::vector<Item>& items)
+                    {
+                        for (const Item& item: items)
+                            if (Intersects(item, sphere))
+                                results.entities.push_back(item.entity);
+                        return true;
+                    });
+                    results.offsets.push_back(static_cast<UInt32>(results.entities.size()));
+                }
+            }
+
+            void QueryBox(std::span<const SpatialBox> queries, SpatialQueryResults& results) const override
+            {
+                results.Clear();
+                for (const SpatialBox& box: queries)
+                {
+                    const glm::vec3 reach(maxRadius);
+                    ForEachCell(box.min - reach, box.max + reach, [&](const std::vector<Item>& items)
+                    {
+                        for (const Item& item: items)
+                            if (Intersects(item, box))
+                                results.entities.push_back(item.entity);
+                        return true;
+                    });
+                    results.offsets.push_back(static_cast<UInt32>(results.entities.size()));
+                }
+            }
+
+            void FindNearest(std::span<const glm::vec3> points, F32 maxDistance, std::span<ECS::Entity> nearest) const override
+            {
+                if (nearest.size() < points.size())
+                    throw std::invalid_argument("Nearest output is smaller than the number of points.");
+
+                for (Size i = 0; i < points.size(); ++i)
+                {
+                    NearestSearch search {points[i], maxDistance * maxDistance};
+                    // Grow a cube around the point until it holds a center closer than its half size,
+                    // every center within that distance lies in the cells the cube covers
+                    for (F32 halfSize = cellSize; store.count > 0; halfSize *= 2.0f)
+                    {
+                        const F32 clamped = std::min(halfSize, maxDistance);
+                        const Bool complete = ForEachCell(points[i] - glm::vec3(clamped), points[i] + glm::vec3(clamped),
+                                                          [&](const std::vector<Item>& items)
+                                                          {
+                                                              search.Visit(items);
+                                                              return true;
+                                                          });
+                        if (complete || clamped == maxDistance ||
+                            (search.best.IsValid() && search.bestDistanceSquared <= clamped * clamped))
+                            break;
+                    }
+                    nearest[i] = search.best;
+                }
+            }
+
+        private:
+            static constexpr Int32 COORDINATE_BITS = 21;
+            static constexpr Int32 COORDINATE_LIMIT = 1 << (COORDINATE_BITS - 1);
+
+            F32 cellSize;
+            F32 inverseCellSize;
+            /// \brief Largest radius indexed so far, never shrinks.
+            F32 maxRadius = 0.0f;
+            BucketStore store;
+            /// \brief Cell index by key, cells are kept once created.
+            std::unordered_map<UInt64, UInt32> cells;
+            /// \brief Key of each cell.
+            std::vector<UInt64> keys;
+
+            [[nodiscard]] Int32 GetCoordinate(F32 value) const noexcept
+            {
+                const F32 cell = std::floor(value * inverseCellSize);
+                // Far away cells share the outermost coordinate, which stays correct but slower
+                return static_cast<Int32>(std::clamp(cell, F32(-COORDINATE_LIMIT), F32(COORDINATE_LIMIT - 1)));
+            }
+
+            [[nodiscard]] static UInt64 PackKey(Int32 x, Int32 y, Int32 z) noexcept
+            {
+                return UInt64(x + COORDINATE_LIMIT) << (2 * COORDINATE_BITS) |
+                       UInt64(y + COORDINATE_LIMIT) << COORDINATE_BITS |
+                       UInt64(z + COORDINATE_LIMIT);
+            }
+
+            [[nodiscard]] UInt64 GetKey(glm::vec3 point) const noexcept
+            {
+                return PackKey(GetCoordinate(point.x), GetCoordinate(point.y), GetCoordinate(point.z));
+            }
+
+            UInt32 GetOrCreateCell(UInt64 key)
+            {
+                const auto [it, inserted] = cells.try_emplace(key, static_cast<UInt32>(keys.size()));
+                if (inserted)
+                {
+                    keys.push_back(key);
+                    store.buckets.emplace_back();
+                }
+                return it->second;
+            }
+
+            /// \brief Calls visit with the items of every cell overlapping a box, until it returns false.
+            /// \return True if the cells were visited by scanning all of them, which visits every item.
+            template<typename F>
+            Bool ForEachCell(glm::vec3 min, glm::vec3 max, F&& visit) const
+            {
+                const Int32 minX = GetCoordinate(min.x), minY = GetCoordinate(min.y), minZ = GetCoordinate(min.z);
+                const Int32 maxX = GetCoordinate(max.x), maxY = GetCoordinate(max.y), maxZ = GetCoordinate(max.z);
+                const F64 cellCount = F64(maxX - minX + 1) * F64(maxY - minY + 1) * F64(maxZ - minZ + 1);
+
+                // A range larger than the grid is cheaper to answer by scanning every cell
+                if (cellCount >= F64(keys.size()))
+                {
+                    for (const std::vector<Item>& items: store.buckets)
+                        if (!items.empty() && !visit(items))
+                            break;
+                    return true;
+                }
+
+                for (Int32 x = minX; x <= maxX; ++x)
+                    for (Int32 y = minY; y <= maxY; ++y)
+                        for (Int32 z = minZ; z <= maxZ; ++z)
+                        {
+                            const auto it = cells.find(PackKey(x, y, z));
+                            if (it != cells.end() && !store.buckets[it->second].empty() && !visit(store.buckets[it->second]))
+                                return false;
+                        }
+                return false;
+            }
+        };
+
+        /// \brief Octree whose nodes hold the items at most as large as their half size, with bounds loosened to
+        /// twice the node size so items never straddle nodes.
+        ///
+        /// An item descends by its center to the deepest node it fits, so moving an item only changes its
+        /// node when it crosses a cell or changes size class. Items centered outside the root live in the
+        /// root, which every query visits.
+        class LooseOctree final : public SpatialIndex
+        {
+        public:
+            LooseOctree(glm::vec3 center, F32 halfSize, UInt32 maxDepth)
+                    : maxDepth(maxDepth)
+            {
+                nodes.push_back({center, halfSize});
+                store.buckets.emplace_back();
+            }
+
+            void Set(ECS::Entity entity, glm::vec3 center, F32 radius) override
+            {
+                if (!entity.IsValid())
+                    throw std::invalid_argument("Cannot index an invalid entity.");
+                radius = std::max(radius, 0.0f);
+
+                const UInt32 node = SelectNode(center, radius);
+                if (const BucketStore::Location* location = store.Find(entity))
+                {
+                    if (location->bucket == node)
+                    {
+                        store.buckets[node][location->slot] = {center, radius, entity};
+                        return;
+                    }
+                    Count(location->bucket, -1);
+                    store.Erase(*location);
+                }
+                if (const UInt32 stale = store.Insert(node, {center, radius, entity}); stale != NO_BUCKET)
+                    Count(stale, -1);
+                Count(node, 1);
+            }
+
+            Bool Remove(ECS::Entity entity) override
+            {
+                const BucketStore::Location* location = store.Find(entity);
+                if (location == nullptr)
+                    return false;
+                Count(location->bucket, -1);
+                store.Erase(*location);
+                return true;
+            }
+
+            Bool Contains(ECS::Entity entity) const noexcept override
+            {
+                return store.Find(entity) != nullptr;
+            }
+
+            Size GetCount() const noexcept override
+            {
+                return store.count;
+            }
+
+            void QueryRadius(std::span<const SpatialSphere> queries, SpatialQueryResults& results) const override
+            {
+                results.Clear();
+                std::vector<UInt32> stack;
+                for (const SpatialSphere& sphere: queries)
+                {
+                    const F32 radiusSquared = sphere.radius * sphere.radius;
+                    Traverse(stack, [&](const Node& node)
+                    {
+                        const glm::vec3 loose(2.0f * node.halfSize);
+                        return DistanceSquaredToBox(sphere.center, node.center - loose, node.center + loose) <= radiusSquared;
+                    }, [&](const std::vector<Item>& items)
+                    {
+                        for (const Item& item: items)
+                            if (Intersects(item, sphere))
+                                results.entities.push_back(item.entity);
+                    });
+                    results.offsets.push_back(static_cast<UInt32>(results.entities.size()));
+                }
+            }
+
+            void QueryBox(std::span<const SpatialBox> queries, SpatialQueryResults& results) const override
+            {
+                results.Clear();
+                std::vector<UInt32> stack;
+                for (const SpatialBox& box: queries)
+                {
+                    Traverse(stack, [&](const Node& node)
+                    {
+                        const glm::vec3 loose(2.0f * node.halfSize);
+                        return BoxesOverlap(node.center - loose, node.center + loose, box.min, box.max);
+                    }, [&](const std::vector<Item>& items)
+                    {
+                        for (const Item& item: items)
+                            if (Intersects(item, box))
+                                results.entities.push_back(item.entity);
+                    });
+                    results.offsets.push_back(static_cast<UInt32>(results.entities.size()));
+                }
+            }
+
+            void FindNearest(std::span<const glm::vec3> points, F32 maxDistance, std::span<ECS::Entity> nearest) const override
+            {
+                if (nearest.size() < points.size())
+                    throw std::invalid_argument("Nearest output is smaller than the number of points.");
+
+                struct Pending
+                {
+                    UInt32 node;
+                    F32 distanceSquared;
+                };
+                std::vector<Pending> stack;
+                for (Size i = 0; i < points.size(); ++i)
+                {
+                    NearestSearch search {points[i], maxDistance * maxDistance};
+                    // Centers lie inside the tight cell of their node, except those outside the root
+                    stack.assign(1, {0, 0.0f});
+                    while (!stack.empty())
+                    {
+                        const Pending pending = stack.back();
+                        stack.pop_back();
+                        if (pending.distanceSquared > search.bestDistanceSquared)
+                            continue;
+
+                        const Node& node = nodes[pending.node];
+                        search.Visit(store.buckets[pending.node]);
+                        if (node.firstChild == NO_BUCKET)
+                            continue;
+
+                        // Push the farthest child first so the nearest is searched first and prunes the rest
+                        const Size first = stack.size();
+                        for (UInt32 octant = 0; octant < 8; ++octant)
+                        {
+                            const UInt32 child = node.firstChild + octant;
+                            const Node& childNode = nodes[child];
+                            if (childNode.count == 0)
+                                continue;
+                            const glm::vec3 half(childNode.halfSize);
+                            const F32 distanceSquared = DistanceSquaredToBox(search.point, childNode.center - half, childNode.center + half);
+                            if (distanceSquared <= search.bestDistanceSquared)
+                                stack.push_back({child, distanceSquared});
+                        }
+                        std::sort(stack.begin() + first, stack.end(),
+                                  [](const Pending& a, const Pending& b) { return a.distanceSquared > b.distanceSquared; });
+                    }
+                    nearest[i] = search.best;
+                }
+            }
+
+        private:
+            struct Node
+            {
+                glm::vec3 center;
+                F32 halfSize;
+                /// \brief Index of the first of the eight children, allocated together, NO_BUCKET for leaves.
+                UInt32 firstChild = NO_BUCKET;
+                UInt32 parent = NO_BUCKET;
+                /// \brief Number of items in the node and its descendants, empty subtrees are skipped.
+                UInt32 count = 0;
+            };
+
+            /// \brief Nodes by index, the items of node i are bucket i of the store.
+            std::vector<Node> nodes;
+            BucketStore store;
+            UInt32 maxDepth;
+
+            /// \brief The deepest node whose cell holds the center and whose half size is at least the radius,
+            /// creating it if needed.
+            UInt32 SelectNode(glm::vec3 center, F32 radius)
+            {
+                const glm::vec3 offset = center - nodes[0].center;
+                const F32 rootHalfSize = nodes[0].halfSize;
+                if (std::abs(offset.x) > rootHalfSize || std::abs(offset.y) > rootHalfSize || std::abs(offset.z) > rootHalfSize)
+                    return 0;
+
+                UInt32 node = 0;
+                for (UInt32 depth = 0; depth < maxDepth && radius <= nodes[node].halfSize * 0.5f; ++depth)
+                {
+                    if (nodes[node].firstChild == NO_BUCKET)
+                        Split(node);
+                    const glm::vec3 nodeCenter = nodes[node].center;
+                    node = nodes[node].firstChild + (center.x >= nodeCenter.x ? 1u : 0u) +
+                           (center.y >= nodeCenter.y ? 2u : 0u) + (center.z >= nodeCenter.z ? 4u : 0u);
+                }
+                return node;
+            }
+
+            void Split(UInt32 node)
+            {
+                const UInt32 firstChild = static_cast<UInt32>(nodes.size());
+                const F32 childHalfSize = nodes[node].halfSize * 0.5f;
+                for (UInt32 octant = 0; octant < 8; ++octant)
+                {
+                    const glm::vec3 direction((octant & 1) ? 1.0f : -1.0f, (octant & 2) ? 1.0f : -1.0f, (octant & 4) ? 1.0f : -1.0f);
+                    nodes.push_back({nodes[node].center + direction * childHalfSize, childHalfSize, NO_BUCKET, node});
+                    store.buckets.emplace_back();
+                }
+                nodes[node].firstChild = firstChild;
+            }
+
+            void Count(UInt32 node, Int32 delta) noexcept
+            {
+                for (; node != NO_BUCKET; node = nodes[node].parent)
+                    nodes[node].count += delta;
+            }
+
+            /// \brief Visits the items of the root and of every non-empty node that overlaps, depth-first.
+            template<typename Overlaps, typename Visit>
+            void Traverse(std::vector<UInt32>& stack, Overlaps&& overlaps, Visit&& visit) const
+            {
+                stack.assign(1, 0);
+                while (!stack.empty())
+                {
+                    const Node& node = nodes[stack.back()];
+                    visit(store.buckets[stack.back()]);
+                    stack.pop_back();
+                    if (node.firstChild == NO_BUCKET)
+                        continue;
+                    for (UInt32 child = node.firstChild; child < node.firstChild + 8; ++child)
+                        if (nodes[child].count > 0 && overlaps(nodes[child]))
+                            stack.push_back(child);
+                }
+            }
+        };
+    }
+
+    void SpatialIndex::QueryRadius(glm::vec3 center, F32 radius, std::vector<ECS::Entity>& out) const
+    {
+        SpatialQueryResults results;
+        const SpatialSphere sphere {center, radius};
+        QueryRadius(std::span<const SpatialSphere>(&sphere, 1), results);
+        out.insert(out.end(), results.entities.begin(), results.entities.end());
+    }
+
+    void SpatialIndex::QueryBox(glm::vec3 min, glm::vec3 max, std::vector<ECS::Entity>& out) const
+    {
+        SpatialQueryResults results;
+        const SpatialBox box {min, max};
+        QueryBox(std::span<const SpatialBox>(&box, 1), results);
+        out.insert(out.end(), results.entities.begin(), results.entities.end());
+    }
+
+    ECS::Entity SpatialIndex::FindNearest(glm::vec3 point, F32 maxDistance) const
+    {
+        ECS::Entity nearest;
+        FindNearest(std::span<const glm::vec3>(&point, 1), maxDistance, std::span<ECS::Entity>(&nearest, 1));
+        return nearest;
+    }
+
+    Scope<SpatialIndex> CreateSpatialIndex(const SpatialIndexSettings& settings)
+    {
+        switch (settings.kind)
+        {
+            case SpatialIndexKind::HashGrid:
+                if (!(settings.cellSize > 0.0f))
+                    throw std::invalid_argument("Spatial hash grid cell size must be positive.");
+                return CreateScope<HashGrid>(settings.cellSize);
+            case SpatialIndexKind::LooseOctree:
+                if (!(settings.octreeHalfSize > 0.0f))
+                    throw std::invalid_argument("Loose octree half size must be positive.");
+                return CreateScope<LooseOctree>(settings.octreeCenter, settings.octreeHalfSize, settings.octreeMaxDepth);
+        }
+        throw std::invalid_argument("Unknown spatial index kind.");
+    }
+}
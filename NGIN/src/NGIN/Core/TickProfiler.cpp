@@ -0,0 +1,218 @@
+#include <NGIN/Core/TickProfiler.hpp>
+#include <NGIN/Util/Format.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace NGIN::Core
+{
+    namespace
+    {
+        constexpr F64 NANOSECONDS_PER_SECOND = 1e9;
+
+        // Nearest-rank percentile of sorted samples
+        UInt64 Percentile(const std::vector<UInt64>& sorted, F64 percentile)
+        {
+            const Size rank = static_cast<Size>(std::ceil(percentile * static_cast<F64>(sorted.size())));
+            return sorted[rank == 0 ? 0 : rank - 1];
+        }
+
+        String StatsToJSON(const TickStats& stats)
+        {
+            return Util::RuntimeFormat(R"({{"p50":{:.4f},"p99":{:.4f},"max":{:.4f},"mean":{:.4f},"samples":{}}})",
+                                       stats.p50 * 1e3, stats.p99 * 1e3, stats.max * 1e3, stats.mean * 1e3, stats.sampleCount);
+        }
+
+        String EscapeJSON(StringView text)
+        {
+            String escaped;
+            escaped.reserve(text.size());
+            for (const Char c: text)
+            {
+                switch (c)
+                {
+                    case '"':
+                        escaped += "\\\"";
+                        break;
+                    case '\\':
+                        escaped += "\\\\";
+                        break;
+                    case '\n':
+                        escaped += "\\n";
+                        break;
+                    case '\t':
+                        escaped += "\\t";
+                        break;
+                    case '\r':
+                        escaped += "\\r";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            // Other control characters are not allowed unescaped in JSON strings
+                            constexpr char HEX[] = "0123456789abcdef";
+                            escaped += "\\u00";
+                            escaped.push_back(HEX[static_cast<unsigned char>(c) >> 4]);
+                            escaped.push_back(HEX[static_cast<unsigned char>(c) & 0xF]);
+                        } else
+                        {
+                            escaped.push_back(c);
+                        }
+                        break;
+                }
+            }
+            return escaped;
+        }
+    }
+
+    void TickProfiler::Window::Add(UInt64 nanoseconds) noexcept
+    {
+        samples[next] = nanoseconds;
+        next = next + 1 == samples.size() ? 0 : next + 1;
+        if (count < samples.size())
+            ++count;
+    }
+
+    TickStats TickProfiler::Window::ComputeStats() const
+    {
+        TickStats stats;
+        if (count == 0)
+            return stats;
+
+        std::vector<UInt64> sorted(samples.begin(), samples.begin() + count);
+        std::sort(sorted.begin(), sorted.end());
+
+        UInt64 total = 0;
+        for (const UInt64 sample: sorted)
+            total += sample;
+
+        stats.p50 = static_cast<F64>(Percentile(sorted, 0.50)) / NANOSECONDS_PER_SECOND;
+        stats.p99 = static_cast<F64>(Percentile(sorted, 0.99)) / NANOSECONDS_PER_SECOND;
+        stats.max = static_cast<F64>(sorted.back()) / NANOSECONDS_PER_SECOND;
+        stats.mean = static_cast<F64>(total) / static_cast<F64>(count) / NANOSECONDS_PER_SECOND;
+        stats.sampleCount = count;
+        return stats;
+    }
+
+    TickProfiler::TickProfiler(UInt32 windowSize)
+            : windowSize(windowSize == 0 ? 1 : windowSize)
+    {
+        frameWindow.samples.resize(this->windowSize);
+    }
+
+    void TickProfiler::AddModule(StringView name)
+    {
+        moduleNames.emplace_back(name);
+        for (UInt32 i = 0; i < PHASE_COUNT; ++i)
+        {
+            windows.emplace_back();
+            windows.back().samples.resize(windowSize);
+        }
+    }
+
+    void TickProfiler::Record(UInt32 moduleIndex, TickPhase phase, F64 seconds) noexcept
+    {
+        windows[moduleIndex * PHASE_COUNT + static_cast<UInt32>(phase)].Add(static_cast<UInt64>(seconds * NANOSECONDS_PER_SECOND));
+    }
+
+    void TickProfiler::RecordFrame(F64 seconds) noexcept
+    {
+        frameWindow.Add(static_cast<UInt64>(seconds * NANOSECONDS_PER_SECOND));
+    }
+
+    TickStats TickProfiler::GetStats(UInt32 moduleIndex, TickPhase phase) const
+    {
+        if (moduleIndex >= moduleNames.size())
+            throw std::out_of_range("TickProfiler module index out of range.");
+        return windows[moduleIndex * PHASE_COUNT + static_cast<UInt32>(phase)].ComputeStats();
+    }
+
+    TickStats TickProfiler::GetFrameStats() const
+    {
+        return frameWindow.ComputeStats();
+    }
+
+    Size TickProfiler::GetModuleCount() const noexcept
+    {
+        return moduleNames.size();
+    }
+
+    const String& TickProfiler::GetModuleName(UInt32 moduleIndex) const
+    {
+        if (moduleIndex >= moduleNames.size())
+            throw std::out_of_range("TickProfiler module index out of range.");
+        return moduleNames[moduleIndex];
+    }
+
+    void TickProfiler::Clear() noexcept
+    {
+        for (Window& window: windows)
+        {
+            window.next = 0;
+            window.count = 0;
+        }
+        frameWindow.next = 0;
+        frameWindow.count = 0;
+    }
+
+    String TickProfiler::ToString() const
+    {
+        const TickStats frame = GetFrameStats();
+        String result = Util::RuntimeFormat("Frame: p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms over {} frames",
+                                            frame.p50 * 1e3, frame.p99 * 1e3, frame.max * 1e3, frame.sampleCount);
+
+        for (UInt32 module = 0; module < moduleNames.size(); ++module)
+        {
+            for (UInt32 phase = 0; phase < PHASE_COUNT; ++phase)
+            {
+                const TickStats stats = GetStats(module, static_cast<TickPhase>(phase));
+                if (stats.sampleCount == 0)
+                    continue;
+
+                result += Util::RuntimeFormat("\n  {} {}: p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+                                              moduleNames[module], GetPhaseName(static_cast<TickPhase>(phase)),
+                                              stats.p50 * 1e3, stats.p99 * 1e3, stats.max * 1e3);
+            }
+        }
+        return result;
+    }
+
+    String TickProfiler::ToJSON() const
+    {
+        String result = R"({"unit":"ms","frame":)" + StatsToJSON(GetFrameStats()) + R"(,"modules":{)";
+        for (UInt32 module = 0; module < moduleNames.size(); ++module)
+        {
+            if (module > 0)
+                result += ',';
+            result += '"' + EscapeJSON(moduleNames[module]) + "\":{";
+            for (UInt32 phase = 0; phase < PHASE_COUNT; ++phase)
+            {
+                if (phase > 0)
+                    result += ',';
+                result += '"';
+                result += GetPhaseName(static_cast<TickPhase>(phase));
+                result += "\":" + StatsToJSON(GetStats(module, static_cast<TickPhase>(phase)));
+            }
+            result += '}';
+        }
+        result += "}}";
+        return result;
+    }
+
+    StringView TickProfiler::GetPhaseName(TickPhase phase) noexcept
+    {
+        switch (phase)
+        {
+            case TickPhase::FixedTick:
+                return "FixedTick";
+            case TickPhase::PreTick:
+                return "PreTick";
+            case TickPhase::Tick:
+                return "Tick";
+            case TickPhase::PostTick:
+                return "PostTick";
+        }
+        return "Unknown";
+    }
+}
@@ -0,0 +1,403 @@
+#include <NGIN/Core/TransformHierarchy.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define NGIN_TRANSFORM_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace NGIN::Core
+{
+    namespace
+    {
+        glm::mat4 ComposeMatrix(const Transform& transform) noexcept
+        {
+            glm::mat4 matrix = glm::mat4_cast(transform.rotation);
+            matrix[0] *= transform.scale.x;
+            matrix[1] *= transform.scale.y;
+            matrix[2] *= transform.scale.z;
+            matrix[3] = glm::vec4(transform.position, 1.0f);
+            return matrix;
+        }
+
+        /// \brief First index in [begin, end) with a non-zero flag, end if none, skipping clean runs a word at a time.
+        UInt32 SkipClean(const UInt8* flags, UInt32 begin, UInt32 end) noexcept
+        {
+            for (; begin + sizeof(UInt64) <= end; begin += sizeof(UInt64))
+            {
+                UInt64 word;
+                std::memcpy(&word, flags + begin, sizeof(word));
+                if (word != 0)
+                    break;
+            }
+            while (begin < end && flags[begin] == 0)
+                ++begin;
+            return begin;
+        }
+
+        /// \brief worlds[node] = worlds[parent] * locals[node] for every node of a batch.
+        ///
+        /// Matrices are column-major, a result column is the parent's columns weighted by one local column.
+        /// Siblings are adjacent in a batch, so the parent's columns stay in registers across them.
+        void PropagateBatch(std::span<const UInt32> nodes, const UInt32* parentIndices,
+                            const glm::mat4* locals, glm::mat4* worlds) noexcept
+        {
+#if NGIN_TRANSFORM_SSE
+            UInt32 loadedParent = std::numeric_limits<UInt32>::max();
+            __m128 parent0 = _mm_setzero_ps(), parent1 = parent0, parent2 = parent0, parent3 = parent0;
+            for (UInt32 node: nodes)
+            {
+                const UInt32 parentIndex = parentIndices[node];
+                if (parentIndex != loadedParent)
+                {
+                    const float* parent = &worlds[parentIndex][0][0];
+                    parent0 = _mm_loadu_ps(parent);
+                    parent1 = _mm_loadu_ps(parent + 4);
+                    parent2 = _mm_loadu_ps(parent + 8);
+                    parent3 = _mm_loadu_ps(parent + 12);
+                    loadedParent = parentIndex;
+                }
+
+                const float* local = &locals[node][0][0];
+                float* world = &worlds[node][0][0];
+                for (Size column = 0; column < 4; ++column)
+                {
+                    const float* weights = local + column * 4;
+                    __m128 result = _mm_mul_ps(parent0, _mm_set1_ps(weights[0]));
+                    result = _mm_add_ps(result, _mm_mul_ps(parent1, _mm_set1_ps(weights[1])));
+                    result = _mm_add_ps(result, _mm_mul_ps(parent2, _mm_set1_ps(weights[2])));
+                    result = _mm_add_ps(result, _mm_mul_ps(parent3, _mm_set1_ps(weights[3])));
+                    _mm_storeu_ps(world + column * 4, result);
+                }
+            }
+#else
+            for (UInt32 node: nodes)
+                worlds[node] = worlds[parentIndices[node]] * locals[node];
+#endif
+        }
+    }
+
+    void TransformHierarchy::Add(ECS::Entity entity, const Transform& local, ECS::Entity parent)
+    {
+        if (!entity.IsValid())
+            throw std::invalid_argument("Cannot add an invalid entity to the transform hierarchy.");
+        if (FindNode(entity) != NO_NODE)
+            throw std::invalid_argument("Entity already has a transform.");
+        if (parent.IsValid())
+            ++childCounts[GetNode(parent)];
+
+        const UInt32 node = static_cast<UInt32>(entities.size());
+        entities.push_back(entity);
+        parents.push_back(parent);
+        locals.push_back(local);
+        localMatrices.emplace_back(1.0f);
+        worldMatrices.emplace_back(1.0f);
+        dirty.push_back(1);
+        childCounts.push_back(0);
+
+        if (entity.GetIndex() >= nodeIndices.size())
+            nodeIndices.resize(entity.GetIndex() + 1, NO_NODE);
+        nodeIndices[entity.GetIndex()] = node;
+        ordered = false;
+    }
+
+    Bool TransformHierarchy::Remove(ECS::Entity entity)
+    {
+        const UInt32 node = FindNode(entity);
+        if (node == NO_NODE)
+            return false;
+
+        if (childCounts[node] > 0)
+        {
+            for (UInt32 i = 0; i < parents.size(); ++i)
+            {
+                if (parents[i] == entity)
+                {
+                    parents[i] = {};
+                    dirty[i] = 1;
+                }
+            }
+        }
+        if (const UInt32 parent = FindNode(parents[node]); parent != NO_NODE)
+            --childCounts[parent];
+
+        // Swap-remove, the order is restored by the next Update
+        const UInt32 last = static_cast<UInt32>(entities.size() - 1);
+        if (node != last)
+        {
+            entities[node] = entities[last];
+            parents[node] = parents[last];
+            locals[node] = locals[last];
+            localMatrices[node] = localMatrices[last];
+            worldMatrices[node] = worldMatrices[last];
+            dirty[node] = dirty[last];
+            childCounts[node] = childCounts[last];
+            nodeIndices[entities[node].GetIndex()] = node;
+        }
+        entities.pop_back();
+        parents.pop_back();
+        locals.pop_back();
+        localMatrices.pop_back();
+        worldMatrices.pop_back();
+        dirty.pop_back();
+        childCounts.pop_back();
+
+        nodeIndices[entity.GetIndex()] = NO_NODE;
+        pendingRemovals.push_back(entity);
+        ordered = false;
+        return true;
+    }
+
+    Bool TransformHierarchy::Contains(ECS::Entity entity) const noexcept
+    {
+        return FindNode(entity) != NO_NODE;
+    }
+
+    void TransformHierarchy::SetParent(ECS::Entity entity, ECS::Entity parent)
+    {
+        const UInt32 node = GetNode(entity);
+        if (parents[node] == parent)
+            return;
+
+        if (parent.IsValid())
+        {
+            for (UInt32 ancestor = GetNode(parent); ancestor != NO_NODE; ancestor = FindNode(parents[ancestor]))
+            {
+                if (ancestor == node)
+                    throw std::invalid_argument("Cannot parent a transform to itself or one of its descendants.");
+            }
+            ++childCounts[FindNode(parent)];
+        }
+        if (const UInt32 oldParent = FindNode(parents[node]); oldParent != NO_NODE)
+            --childCounts[oldParent];
+
+        parents[node] = parent;
+        dirty[node] = 1;
+        ordered = false;
+    }
+
+    ECS::Entity TransformHierarchy::GetParent(ECS::Entity entity) const
+    {
+        return parents[GetNode(entity)];
+    }
+
+    void TransformHierarchy::SetLocal(ECS::Entity entity, const Transform& local)
+    {
+        const UInt32 node = GetNode(entity);
+        locals[node] = local;
+        MarkDirty(node);
+    }
+
+    const Transform& TransformHierarchy::GetLocal(ECS::Entity entity) const
+    {
+        return locals[GetNode(entity)];
+    }
+
+    const glm::mat4& TransformHierarchy::GetWorldMatrix(ECS::Entity entity) const
+    {
+        return worldMatrices[GetNode(entity)];
+    }
+
+    void TransformHierarchy::Update()
+    {
+        if (!ordered)
+            Rebuild();
+
+        updatedEntities.clear();
+        removedEntities.swap(pendingRemovals);
+        pendingRemovals.clear();
+        const UInt32 levelCount = static_cast<UInt32>(GetDepthCount());
+        if (firstDirtyLevel >= levelCount)
+            return;
+
+        // Children of the nodes updated in the level above, and the span scanned in it
+        NodeRange inherited;
+        NodeRange scanned;
+        for (UInt32 level = firstDirtyLevel; level < levelCount; ++level)
+        {
+            NodeRange range = std::exchange(dirtyRanges[level], {});
+            range.begin = std::min(range.begin, inherited.begin);
+            range.end = std::max(range.end, inherited.end);
+
+            // Parents are final, a node is dirty if it or its parent is. Roots have no parent, so a level
+            // without inherited nodes only visits the marked ones, which may be few in a wide level.
+            batch.clear();
+            const Bool marksOnly = inherited.begin >= inherited.end;
+            for (UInt32 node = range.begin; node < range.end; ++node)
+            {
+                if (marksOnly)
+                {
+                    node = SkipClean(dirty.data(), node, range.end);
+                    if (node == range.end)
+                        break;
+                }
+                if (dirty[node] == 0)
+                {
+                    if (level == 0 || dirty[parentIndices[node]] == 0)
+                        continue;
+                    dirty[node] = 2;
+                } else if (dirty[node] == 1)
+                    localMatrices[node] = ComposeMatrix(locals[node]);
+                batch.push_back(node);
+            }
+
+            if (level == 0)
+            {
+                for (UInt32 node: batch)
+                    worldMatrices[node] = localMatrices[node];
+            } else
+                PropagateBatch(batch, parentIndices.data(), localMatrices.data(), worldMatrices.data());
+            for (UInt32 node: batch)
+                updatedEntities.push_back(entities[node]);
+
+            // The level above is no longer read, its flags can be cleared
+            if (scanned.begin < scanned.end)
+                std::fill(dirty.begin() + scanned.begin, dirty.begin() + scanned.end, UInt8(0));
+            scanned = range;
+            inherited = batch.empty()
+                        ? NodeRange {}
+                        : NodeRange {firstChildren[batch.front()], firstChildren[batch.back()] + childCounts[batch.back()]};
+        }
+        if (scanned.begin < scanned.end)
+            std::fill(dirty.begin() + scanned.begin, dirty.begin() + scanned.end, UInt8(0));
+        firstDirtyLevel = levelCount;
+    }
+
+    UInt32 TransformHierarchy::FindNode(ECS::Entity entity) const noexcept
+    {
+        const UInt32 index = entity.GetIndex();
+        if (!entity.IsValid() || index >= nodeIndices.size())
+            return NO_NODE;
+        const UInt32 node = nodeIndices[index];
+        if (node == NO_NODE || entities[node] != entity)
+            return NO_NODE;
+        return node;
+    }
+
+    UInt32 TransformHierarchy::GetNode(ECS::Entity entity) const
+    {
+        const UInt32 node = FindNode(entity);
+        if (node == NO_NODE)
+            throw std::invalid_argument("Entity has no transform.");
+        return node;
+    }
+
+    void TransformHierarchy::MarkDirty(UInt32 node) noexcept
+    {
+        dirty[node] = 1;
+        // Without an order the depths are stale, Rebuild finds the dirty spans itself
+        if (ordered)
+        {
+            NodeRange& range = dirtyRanges[depths[node]];
+            range.begin = std::min(range.begin, node);
+            range.end = std::max(range.end, node + 1);
+            firstDirtyLevel = std::min(firstDirtyLevel, depths[node]);
+        }
+    }
+
+    void TransformHierarchy::Rebuild()
+    {
+        const UInt32 count = static_cast<UInt32>(entities.size());
+
+        // Group the children of every node with a counting sort on the parent, keeping their relative order
+        parentIndices.resize(count);
+        childStarts.assign(count + 1, 0);
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            parentIndices[i] = FindNode(parents[i]);
+            if (parentIndices[i] != NO_NODE)
+                ++childStarts[parentIndices[i] + 1];
+        }
+        for (UInt32 i = 0; i < count; ++i)
+            childStarts[i + 1] += childStarts[i];
+        children.resize(childStarts[count]);
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            if (parentIndices[i] != NO_NODE)
+                children[childStarts[parentIndices[i]]++] = i;
+        }
+        // The fill advanced every start to the next node's start, shift them back
+        for (UInt32 i = count; i > 0; --i)
+            childStarts[i] = childStarts[i - 1];
+        childStarts[0] = 0;
+        for (UInt32 i = 0; i < count; ++i)
+            childCounts[i] = childStarts[i + 1] - childStarts[i];
+
+        // Breadth-first walk from the roots, the queue itself is the new order
+        order.clear();
+        order.reserve(count);
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            if (parentIndices[i] == NO_NODE)
+                order.push_back(i);
+        }
+        for (Size head = 0; head < order.size(); ++head)
+        {
+            const UInt32 node = order[head];
+            order.insert(order.end(), children.begin() + childStarts[node], children.begin() + childStarts[node + 1]);
+        }
+
+        // order maps new to old indices, childStarts is reused for old to new
+        for (UInt32 i = 0; i < count; ++i)
+            childStarts[order[i]] = i;
+
+        std::vector<UInt32> permutedParents(count);
+        depths.resize(count);
+        levelStarts.assign(1, 0);
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            const UInt32 oldParent = parentIndices[order[i]];
+            permutedParents[i] = oldParent == NO_NODE ? NO_NODE : childStarts[oldParent];
+            depths[i] = oldParent == NO_NODE ? 0 : depths[permutedParents[i]] + 1;
+            if (depths[i] == levelStarts.size())
+                levelStarts.push_back(i);
+        }
+        levelStarts.push_back(count);
+        if (count == 0)
+            levelStarts.clear();
+        parentIndices.swap(permutedParents);
+
+        Permute(entities);
+        Permute(parents);
+        Permute(locals);
+        Permute(localMatrices);
+        Permute(worldMatrices);
+        Permute(dirty);
+        Permute(childCounts);
+        for (UInt32 i = 0; i < count; ++i)
+            nodeIndices[entities[i].GetIndex()] = i;
+
+        // Children were enqueued in node order right after the roots
+        firstChildren.resize(count);
+        UInt32 nextChild = levelStarts.size() > 1 ? levelStarts[1] : 0;
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            firstChildren[i] = nextChild;
+            nextChild += childCounts[i];
+        }
+
+        ordered = true;
+        firstDirtyLevel = static_cast<UInt32>(GetDepthCount());
+        dirtyRanges.assign(GetDepthCount(), {});
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            if (dirty[i] != 0)
+                MarkDirty(i);
+        }
+    }
+
+    template<typename T>
+    void TransformHierarchy::Permute(std::vector<T>& values)
+    {
+        std::vector<T> permuted;
+        permuted.reserve(values.size());
+        for (UInt32 index: order)
+            permuted.push_back(std::move(values[index]));
+        values.swap(permuted);
+    }
+}
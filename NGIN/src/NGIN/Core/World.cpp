@@ -0,0 +1,623 @@
+#include <NGIN/Core/World.hpp>
+
+#include <atomic>
+#include <tuple>
+
+namespace NGIN::Core
+{
+    namespace
+    {
+        std::atomic<UInt64> nextWorldID = 1;
+
+        struct CachedCommandBuffer
+        {
+            UInt64 worldID;
+            ECS::CommandBuffer* buffer;
+        };
+
+        /// \brief Command buffers of the calling thread, one per world it recorded into.
+        thread_local std::vector<CachedCommandBuffer> threadCommandBuffers;
+
+        UInt64 HashSignature(std::span<const ECS::ComponentInfo* const> components) noexcept
+        {
+            // Component IDs already are FNV-1a hashes, mix them in order
+            UInt64 hash = 14695981039346656037ull;
+            for (const ECS::ComponentInfo* info: components)
+                hash = (hash ^ info->id) * 1099511628211ull;
+            return hash;
+        }
+
+        Bool HasSignature(const ECS::Archetype& archetype, std::span<const ECS::ComponentInfo* const> components) noexcept
+        {
+            const auto signature = archetype.GetSignature();
+            if (signature.size() != components.size())
+                return false;
+            for (Size i = 0; i < signature.size(); ++i)
+                if (signature[i] != components[i]->id)
+                    return false;
+            return true;
+        }
+    }
+
+    World::World(const SpatialIndexSettings& spatialIndexSettings)
+            : spatialIndex(CreateSpatialIndex(spatialIndexSettings)),
+              worldID(nextWorldID.fetch_add(1, std::memory_order_relaxed))
+    {
+        // Index 0 is the archetype of entities without components
+        GetOrCreateArchetype({});
+    }
+
+    World::~World()
+    {
+        std::erase_if(threadCommandBuffers, [this](const CachedCommandBuffer& cached) { return cached.worldID == worldID; });
+        archetypes.clear();
+    }
+
+    ECS::Entity World::CreateEntity()
+    {
+        return AllocateEntity(0);
+    }
+
+    void World::DestroyEntity(ECS::Entity entity)
+    {
+        if (!IsAlive(entity))
+            return;
+
+        EntityRecord& record = records[entity.GetIndex()];
+        const ECS::Entity moved = archetypes[record.archetype]->RemoveRow(record.location, true);
+        if (moved.IsValid())
+            records[moved.GetIndex()].location = record.location;
+
+        for (const Scope<ECS::SparseSet>& set: sparseSets)
+            set->Remove(entity);
+
+        record.archetype = ECS::Archetype::INVALID_ARCHETYPE;
+        --entityCount;
+        transforms.Remove(entity);
+        spatialIndex->Remove(entity);
+
+        // A slot whose generation would wrap is retired, reusing it could revive stale handles
+        if (record.generation == std::numeric_limits<UInt32>::max())
+            return;
+        ++record.generation;
+        record.nextFree = freeHead;
+        freeHead = entity.GetIndex();
+    }
+
+    Bool World::IsAlive(ECS::Entity entity) const noexcept
+    {
+        const UInt32 index = entity.GetIndex();
+        return index < records.size()
+               && records[index].generation == entity.GetGeneration()
+               && records[index].archetype != ECS::Archetype::INVALID_ARCHETYPE;
+    }
+
+    ECS::CommandBuffer& World::GetCommandBuffer()
+    {
+        for (const CachedCommandBuffer& cached: threadCommandBuffers)
+        {
+            if (cached.worldID == worldID)
+                return *cached.buffer;
+        }
+
+        ECS::CommandBuffer* buffer;
+        {
+            std::lock_guard<std::mutex> lock(commandBufferMutex);
+            buffer = commandBuffers.emplace_back(CreateScope<ECS::CommandBuffer>()).get();
+        }
+        threadCommandBuffers.push_back({worldID, buffer});
+        return *buffer;
+    }
+
+    void World::FlushCommands()
+    {
+        pendingCommands.clear();
+        for (UInt32 b = 0; b < commandBuffers.size(); ++b)
+        {
+            const std::vector<ECS::CommandBuffer::Command>& commands = commandBuffers[b]->GetCommands();
+            for (UInt32 c = 0; c < commands.size(); ++c)
+            {
+                // Creations sort last, they have no entity yet
+                const UInt32 entityIndex = commands[c].type == ECS::CommandBuffer::CommandType::Create
+                                           ? ECS::Entity::INVALID_INDEX : commands[c].entity.GetIndex();
+                pendingCommands.push_back({entityIndex, b, c});
+            }
+        }
+
+        std::sort(pendingCommands.begin(), pendingCommands.end(), [](const PendingCommand& a, const PendingCommand& b)
+        {
+            return std::tie(a.entityIndex, a.buffer, a.command) < std::tie(b.entityIndex, b.buffer, b.command);
+        });
+
+        try
+        {
+            const PendingCommand* pending = pendingCommands.data();
+            const PendingCommand* end = pending + pendingCommands.size();
+            while (pending != end && pending->entityIndex != ECS::Entity::INVALID_INDEX)
+            {
+                const PendingCommand* groupEnd = pending;
+                while (groupEnd != end && groupEnd->entityIndex == pending->entityIndex)
+                    ++groupEnd;
+                PlayBack(pending, groupEnd);
+                pending = groupEnd;
+            }
+            for (; pending != end; ++pending)
+                PlayBackCreate(commandBuffers[pending->buffer]->GetCommands()[pending->command]);
+        } catch (...)
+        {
+            for (const Scope<ECS::CommandBuffer>& buffer: commandBuffers)
+                buffer->Clear();
+            throw;
+        }
+
+        // Values not moved into the world, e.g. of commands on dead entities, are destroyed here
+        for (const Scope<ECS::CommandBuffer>& buffer: commandBuffers)
+            buffer->Clear();
+    }
+
+    void World::RunSystems(F64 deltaTime, Async::JobSystem* jobSystem)
+    {
+        for (UInt32 stage = 0; stage < systemScheduler.GetStageCount(); ++stage)
+        {
+            systemScheduler.RunStage(stage, archetypes, changeTick, deltaTime, jobSystem);
+            // Played back and later changes must be newer than every system run of the stage
+            ++changeTick;
+            FlushCommands();
+        }
+        UpdateTransforms();
+    }
+
+    void World::UpdateTransforms()
+    {
+        transforms.Update();
+
+        for (ECS::Entity entity: transforms.GetRemovedEntities())
+            spatialIndex->Remove(entity);
+
+        const auto reindex = [this](ECS::Entity entity, const glm::mat4& world)
+        {
+            // Read through the const overload, which leaves the bounds column unmarked
+            const SpatialBounds* bounds = std::as_const(*this).TryGetComponent<SpatialBounds>(entity);
+            F32 radius = 0.0f;
+            if (bounds != nullptr)
+            {
+                // The bounding sphere grows with the largest axis scale of the world matrix
+                const F32 scaleSquared = std::max({glm::dot(glm::vec3(world[0]), glm::vec3(world[0])),
+                                                   glm::dot(glm::vec3(world[1]), glm::vec3(world[1])),
+                                                   glm::dot(glm::vec3(world[2]), glm::vec3(world[2]))});
+                radius = bounds->radius * std::sqrt(scaleSquared);
+            }
+            spatialIndex->Set(entity, glm::vec3(world[3]), radius);
+        };
+        for (ECS::Entity entity: transforms.GetUpdatedEntities())
+            reindex(entity, transforms.GetWorldMatrix(entity));
+
+        // Entities whose transform did not move but whose bounds changed, the moved ones are reindexed twice
+        Query<const SpatialBounds&, ECS::Changed<SpatialBounds>>(spatialTick).ForEach(
+                [&](ECS::Entity entity, const SpatialBounds&)
+                {
+                    if (transforms.Contains(entity))
+                        reindex(entity, transforms.GetWorldMatrix(entity));
+                });
+        spatialTick = AdvanceChangeTick();
+    }
+
+    const ECS::SystemScheduler& World::GetSystemScheduler() const noexcept
+    {
+        return systemScheduler;
+    }
+
+    TransformHierarchy& World::GetTransforms() noexcept
+    {
+        return transforms;
+    }
+
+    const TransformHierarchy& World::GetTransforms() const noexcept
+    {
+        return transforms;
+    }
+
+    const SpatialIndex& World::GetSpatialIndex() const noexcept
+    {
+        return *spatialIndex;
+    }
+
+    UInt64 World::GetChangeTick() const noexcept
+    {
+        return changeTick;
+    }
+
+    UInt64 World::AdvanceChangeTick() noexcept
+    {
+        return changeTick++;
+    }
+
+    Size World::GetEntityCount() const noexcept
+    {
+        return entityCount;
+    }
+
+    Size World::GetArchetypeCount() const noexcept
+    {
+        return archetypes.size();
+    }
+
+    const ECS::Archetype& World::GetArchetype(Size index) const
+    {
+        if (index >= archetypes.size())
+            throw std::out_of_range("Archetype index out of range.");
+        return *archetypes[index];
+    }
+
+    const ECS::SparseSet* World::FindSparseSet(Meta::TypeIDType id) const noexcept
+    {
+        const Scope<ECS::SparseSet>* set = sparseSets.Find(id);
+        return set != nullptr ? set->get() : nullptr;
+    }
+
+    ECS::SparseSet* World::FindSparseSet(Meta::TypeIDType id) noexcept
+    {
+        Scope<ECS::SparseSet>* set = sparseSets.Find(id);
+        return set != nullptr ? set->get() : nullptr;
+    }
+
+    Size World::GetChunkCount() const noexcept
+    {
+        return chunkAllocator.GetAllocatedCount();
+    }
+
+    ECS::Entity World::AllocateEntity(UInt32 archetypeIndex)
+    {
+        if (freeHead == NO_FREE_SLOT)
+        {
+            if (records.size() >= ECS::Entity::INVALID_INDEX)
+                throw std::length_error("World ran out of entity slots.");
+            records.emplace_back().nextFree = NO_FREE_SLOT;
+            freeHead = static_cast<UInt32>(records.size() - 1);
+        }
+
+        const UInt32 index = freeHead;
+        EntityRecord& record = records[index];
+        const ECS::Entity entity = ECS::Entity::FromParts(index, record.generation);
+        // Allocating the row may throw, only unlink the slot once it succeeded
+        const ECS::Archetype::Location location = archetypes[archetypeIndex]->AllocateRow(entity);
+        freeHead = record.nextFree;
+
+        record.archetype = archetypeIndex;
+        record.location = location;
+        ++entityCount;
+
+        const ECS::Archetype& archetype = *archetypes[archetypeIndex];
+        for (UInt32 i = 0; i < archetype.GetColumns().size(); ++i)
+            archetype.MarkAdded(i, location.chunk, changeTick);
+        return entity;
+    }
+
+    UInt32 World::GetOrCreateArchetype(std::span<const ECS::ComponentInfo* const> components)
+    {
+        const UInt64 hash = HashSignature(components);
+        std::vector<UInt32>& candidates = archetypeLookup[hash];
+        for (UInt32 index: candidates)
+        {
+            if (HasSignature(*archetypes[index], components))
+                return index;
+        }
+
+        // Known component types can be restored from snapshots
+        for (const ECS::ComponentInfo* info: components)
+            ECS::RegisterComponent(*info);
+
+        const UInt32 index = static_cast<UInt32>(archetypes.size());
+        archetypes.push_back(CreateScope<ECS::Archetype>(std::vector<const ECS::ComponentInfo*>(components.begin(), components.end()), chunkAllocator));
+        candidates.push_back(index);
+        return index;
+    }
+
+    void World::PlayBack(const PendingCommand* begin, const PendingCommand* end)
+    {
+        using CommandType = ECS::CommandBuffer::CommandType;
+        auto commandAt = [this](const PendingCommand* pending) -> ECS::CommandBuffer::Command&
+        {
+            return commandBuffers[pending->buffer]->GetCommands()[pending->command];
+        };
+
+        // All commands share the entity index, those with another generation target a dead entity
+        ECS::Entity entity;
+        for (const PendingCommand* pending = begin; pending != end && !entity.IsValid(); ++pending)
+        {
+            if (IsAlive(commandAt(pending).entity))
+                entity = commandAt(pending).entity;
+        }
+        if (!entity.IsValid())
+            return;
+
+        // Resolve the final archetype first so the entity moves at most once
+        const UInt32 sourceIndex = records[entity.GetIndex()].archetype;
+        UInt32 targetIndex = sourceIndex;
+        for (const PendingCommand* pending = begin; pending != end; ++pending)
+        {
+            const ECS::CommandBuffer::Command& command = commandAt(pending);
+            if (command.entity != entity)
+                continue;
+
+            switch (command.type)
+            {
+                case CommandType::Destroy:
+                    DestroyEntity(entity);
+                    return;
+                case CommandType::Add:
+                    // Sparse set components do not change the archetype
+                    if (command.components->info->storage == ECS::ComponentStorage::Table)
+                        targetIndex = GetAddTarget(targetIndex, *command.components->info);
+                    break;
+                case CommandType::Remove:
+                    targetIndex = GetRemoveTarget(targetIndex, command.id);
+                    break;
+                case CommandType::Create:
+                    break;
+            }
+        }
+
+        const ECS::Archetype::Location location = targetIndex != sourceIndex
+                                                  ? MoveEntity(entity, targetIndex) : records[entity.GetIndex()].location;
+        const ECS::Archetype& source = *archetypes[sourceIndex];
+        const ECS::Archetype& target = *archetypes[targetIndex];
+
+        // The last add of a component wins unless a later remove dropped it
+        for (const PendingCommand* pending = begin; pending != end; ++pending)
+        {
+            ECS::CommandBuffer::Command& command = commandAt(pending);
+            if (command.entity != entity)
+                continue;
+            // Sparse set removals apply in order, the archetype move already took care of the others
+            if (command.type == CommandType::Remove)
+            {
+                if (const Scope<ECS::SparseSet>* set = sparseSets.Find(command.id))
+                    (*set)->Remove(entity);
+                continue;
+            }
+            if (command.type != CommandType::Add)
+                continue;
+
+            Bool superseded = false;
+            for (const PendingCommand* later = pending + 1; later != end && !superseded; ++later)
+            {
+                const ECS::CommandBuffer::Command& laterCommand = commandAt(later);
+                superseded = laterCommand.entity == entity && laterCommand.id == command.id
+                             && (laterCommand.type == CommandType::Add || laterCommand.type == CommandType::Remove);
+            }
+            if (superseded)
+                continue;
+
+            ECS::CommandBuffer::ComponentValue& component = *command.components;
+            if (component.info->storage == ECS::ComponentStorage::SparseSet)
+            {
+                ECS::SparseSet& set = GetOrCreateSparseSet(*component.info);
+                std::byte* slot = set.TryGet(entity);
+                if (slot != nullptr)
+                    component.info->destroy(slot);
+                else
+                    slot = set.Emplace(entity);
+                ECS::RelocateComponents(*component.info, slot, static_cast<std::byte*>(component.value), 1);
+                component.value = nullptr;
+                continue;
+            }
+
+            std::byte* slot = target.GetComponent(target.FindColumn(command.id), location);
+            // The entity kept the value it had before, replace it
+            if (source.Has(command.id))
+            {
+                component.info->destroy(slot);
+                target.MarkChanged(target.FindColumn(command.id), location.chunk, changeTick);
+            }
+            ECS::RelocateComponents(*component.info, slot, static_cast<std::byte*>(component.value), 1);
+            component.value = nullptr;
+        }
+    }
+
+    void World::PlayBackCreate(ECS::CommandBuffer::Command& command)
+    {
+        std::span<ECS::CommandBuffer::ComponentValue> components(command.components, command.componentCount);
+        std::sort(components.begin(), components.end(), [](const auto& a, const auto& b) { return a.info->id < b.info->id; });
+
+        createInfos.clear();
+        for (const ECS::CommandBuffer::ComponentValue& component: components)
+        {
+            if (component.info->storage == ECS::ComponentStorage::Table)
+                createInfos.push_back(component.info);
+        }
+
+        const UInt32 archetypeIndex = GetOrCreateArchetype(createInfos);
+        const ECS::Entity entity = AllocateEntity(archetypeIndex);
+        const ECS::Archetype& archetype = *archetypes[archetypeIndex];
+        const ECS::Archetype::Location location = records[entity.GetIndex()].location;
+        UInt32 column = 0;
+        for (ECS::CommandBuffer::ComponentValue& component: components)
+        {
+            if (component.info->storage != ECS::ComponentStorage::Table)
+                continue;
+            ECS::RelocateComponents(*component.info, archetype.GetComponent(column++, location),
+                                    static_cast<std::byte*>(component.value), 1);
+            component.value = nullptr;
+        }
+
+        if (createInfos.size() == components.size())
+            return;
+        try
+        {
+            for (ECS::CommandBuffer::ComponentValue& component: components)
+            {
+                if (component.info->storage == ECS::ComponentStorage::Table)
+                    continue;
+                ECS::RelocateComponents(*component.info, GetOrCreateSparseSet(*component.info).Emplace(entity),
+                                        static_cast<std::byte*>(component.value), 1);
+                component.value = nullptr;
+            }
+        } catch (...)
+        {
+            DestroyEntity(entity);
+            throw;
+        }
+    }
+
+    ECS::Archetype::Location World::MoveEntity(ECS::Entity entity, UInt32 targetIndex)
+    {
+        EntityRecord& record = records[entity.GetIndex()];
+        ECS::Archetype& source = *archetypes[record.archetype];
+        ECS::Archetype& target = *archetypes[targetIndex];
+
+        const ECS::Archetype::Location from = record.location;
+        const ECS::Archetype::Location to = target.AllocateRow(entity);
+
+        // Both column lists are sorted by ID, merge them
+        const auto sourceColumns = source.GetColumns();
+        const auto targetColumns = target.GetColumns();
+        UInt32 t = 0;
+        for (UInt32 s = 0; s < sourceColumns.size(); ++s)
+        {
+            const ECS::ComponentInfo& info = *sourceColumns[s].info;
+            while (t < targetColumns.size() && targetColumns[t].info->id < info.id)
+                ++t;
+
+            if (t < targetColumns.size() && targetColumns[t].info->id == info.id)
+            {
+                ECS::RelocateComponents(info, target.GetComponent(t, to), source.GetComponent(s, from), 1);
+                // The row may carry changes its new chunk has not seen yet
+                target.MergeTicks(t, to.chunk, source.GetChangedTicks(from.chunk)[s], source.GetAddedTicks(from.chunk)[s]);
+            } else if (!info.trivial)
+                info.destroy(source.GetComponent(s, from));
+        }
+        for (UInt32 i = 0; i < targetColumns.size(); ++i)
+        {
+            if (!source.Has(targetColumns[i].info->id))
+                target.MarkAdded(i, to.chunk, changeTick);
+        }
+
+        const ECS::Entity moved = source.RemoveRow(from, false);
+        if (moved.IsValid())
+            records[moved.GetIndex()].location = from;
+
+        record.archetype = targetIndex;
+        record.location = to;
+        return to;
+    }
+
+    UInt32 World::GetAddTarget(UInt32 sourceIndex, const ECS::ComponentInfo& info)
+    {
+        if (archetypes[sourceIndex]->Has(info.id))
+            return sourceIndex;
+
+        UInt32 targetIndex = archetypes[sourceIndex]->GetAddEdge(info.id);
+        if (targetIndex == ECS::Archetype::INVALID_ARCHETYPE)
+        {
+            std::vector<const ECS::ComponentInfo*> components;
+            for (const ECS::Archetype::Column& column: archetypes[sourceIndex]->GetColumns())
+                components.push_back(column.info);
+            components.insert(std::upper_bound(components.begin(), components.end(), &info, IS_ORDERED_BY_ID), &info);
+
+            targetIndex = GetOrCreateArchetype(components);
+            archetypes[sourceIndex]->SetAddEdge(info.id, targetIndex);
+            archetypes[targetIndex]->SetRemoveEdge(info.id, sourceIndex);
+        }
+        return targetIndex;
+    }
+
+    UInt32 World::GetRemoveTarget(UInt32 sourceIndex, Meta::TypeIDType id)
+    {
+        if (!archetypes[sourceIndex]->Has(id))
+            return sourceIndex;
+
+        UInt32 targetIndex = archetypes[sourceIndex]->GetRemoveEdge(id);
+        if (targetIndex == ECS::Archetype::INVALID_ARCHETYPE)
+        {
+            std::vector<const ECS::ComponentInfo*> components;
+            for (const ECS::Archetype::Column& column: archetypes[sourceIndex]->GetColumns())
+            {
+                if (column.info->id != id)
+                    components.push_back(column.info);
+            }
+
+            targetIndex = GetOrCreateArchetype(components);
+            archetypes[sourceIndex]->SetRemoveEdge(id, targetIndex);
+            archetypes[targetIndex]->SetAddEdge(id, sourceIndex);
+        }
+        return targetIndex;
+    }
+
+    void* World::AddComponentStorage(ECS::Entity entity, const ECS::ComponentInfo& info)
+    {
+        if (!IsAlive(entity))
+            throw std::invalid_argument("Cannot add a component to an entity that is not alive.");
+        if (info.storage == ECS::ComponentStorage::SparseSet)
+            return GetOrCreateSparseSet(info).Emplace(entity);
+
+        const UInt32 targetIndex = GetAddTarget(records[entity.GetIndex()].archetype, info);
+        const ECS::Archetype::Location location = MoveEntity(entity, targetIndex);
+        ECS::Archetype& target = *archetypes[targetIndex];
+        return target.GetComponent(target.FindColumn(info.id), location);
+    }
+
+    ECS::SparseSet& World::GetOrCreateSparseSet(const ECS::ComponentInfo& info)
+    {
+        if (Scope<ECS::SparseSet>* set = sparseSets.Find(info.id))
+            return **set;
+        sparseSets.Insert(info.id, CreateScope<ECS::SparseSet>(info));
+        ECS::RegisterComponent(info);
+        return **sparseSets.Find(info.id);
+    }
+
+    Bool World::RemoveSparseComponent(ECS::Entity entity, Meta::TypeIDType id)
+    {
+        const Scope<ECS::SparseSet>* set = sparseSets.Find(id);
+        return set != nullptr && IsAlive(entity) && (*set)->Remove(entity);
+    }
+
+    void* World::FindSparseComponent(ECS::Entity entity, Meta::TypeIDType id) noexcept
+    {
+        ECS::SparseSet* set = FindSparseSet(id);
+        return set != nullptr && IsAlive(entity) ? set->TryGet(entity) : nullptr;
+    }
+
+    const void* World::FindSparseComponent(ECS::Entity entity, Meta::TypeIDType id) const noexcept
+    {
+        const ECS::SparseSet* set = FindSparseSet(id);
+        return set != nullptr && IsAlive(entity) ? set->TryGet(entity) : nullptr;
+    }
+
+    Bool World::RemoveComponent(ECS::Entity entity, Meta::TypeIDType id)
+    {
+        if (!IsAlive(entity) || !archetypes[records[entity.GetIndex()].archetype]->Has(id))
+            return false;
+
+        const UInt32 targetIndex = GetRemoveTarget(records[entity.GetIndex()].archetype, id);
+        MoveEntity(entity, targetIndex);
+        return true;
+    }
+
+    void* World::FindComponent(ECS::Entity entity, Meta::TypeIDType id) const noexcept
+    {
+        if (!IsAlive(entity))
+            return nullptr;
+
+        const EntityRecord& record = records[entity.GetIndex()];
+        const ECS::Archetype& archetype = *archetypes[record.archetype];
+        const UInt32 column = archetype.FindColumn(id);
+        if (column == ECS::Archetype::INVALID_COLUMN)
+            return nullptr;
+        return archetype.GetComponent(column, record.location);
+    }
+
+    void* World::FindMutableComponent(ECS::Entity entity, Meta::TypeIDType id) noexcept
+    {
+        if (!IsAlive(entity))
+            return nullptr;
+
+        const EntityRecord& record = records[entity.GetIndex()];
+        const ECS::Archetype& archetype = *archetypes[record.archetype];
+        const UInt32 column = archetype.FindColumn(id);
+        if (column == ECS::Archetype::INVALID_COLUMN)
+            return nullptr;
+        archetype.MarkChanged(column, record.location.chunk, changeTick);
+        return archetype.GetComponent(column, record.location);
+    }
+}
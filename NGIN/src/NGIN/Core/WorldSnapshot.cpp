@@ -0,0 +1,673 @@
+#include <NGIN/Core/WorldSnapshot.hpp>
+#include <NGIN/Meta/Reflection/Registry.hpp>
+#include <NGIN/Meta/TypeID.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NGIN::Core
+{
+    namespace
+    {
+        using Meta::Reflection::Types::Class;
+        using Meta::Reflection::Types::Field;
+
+        constexpr char MAGIC[8] = {'N', 'G', 'I', 'N', 'W', 'R', 'L', 'D'};
+        /// \brief Reads back differently on a platform of the other byte order.
+        constexpr UInt32 BYTE_ORDER_MARK = 0x01020304;
+
+        /// \brief Start of a snapshot. The metadata sections follow it in this order: components, archetypes,
+        /// entity records, transforms, sparse sets and the reflected values of the table columns. The chunk
+        /// images start at chunksOffset.
+        struct Header
+        {
+            char magic[8];
+            UInt32 version;
+            UInt32 byteOrderMark;
+            UInt32 chunkSize;
+            UInt32 componentCount;
+            UInt32 archetypeCount;
+            UInt32 sparseSetCount;
+            UInt32 freeHead;
+            UInt32 padding;
+            UInt64 entityCount;
+            UInt64 recordCount;
+            UInt64 transformCount;
+            UInt64 changeTick;
+            UInt64 chunkCount;
+            /// \brief Offset of the first chunk image, a multiple of CHUNK_SIZE.
+            UInt64 chunksOffset;
+        };
+
+        struct TransformEntry
+        {
+            ECS::Entity entity;
+            ECS::Entity parent;
+            Transform local;
+        };
+
+        static_assert(std::is_trivially_copyable_v<ECS::EntityRecord>);
+        static_assert(std::is_trivially_copyable_v<TransformEntry>);
+
+        constexpr Size AlignUp(Size value, Size alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        class Writer
+        {
+        public:
+            void WriteBytes(const void* data, Size size)
+            {
+                const auto* begin = static_cast<const std::byte*>(data);
+                bytes.insert(bytes.end(), begin, begin + size);
+            }
+
+            template<typename T>
+            void Write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                WriteBytes(&value, sizeof(T));
+            }
+
+            void WriteString(StringView value)
+            {
+                Write<UInt64>(value.size());
+                WriteBytes(value.data(), value.size());
+            }
+
+            std::vector<std::byte> bytes;
+        };
+
+        class Reader
+        {
+        public:
+            Reader(std::span<const std::byte> data, Size offset)
+                    : data(data), offset(offset)
+            {}
+
+            const std::byte* ReadBytes(Size size)
+            {
+                if (size > data.size() - offset)
+                    throw std::invalid_argument("World snapshot is truncated.");
+                const std::byte* bytes = data.data() + offset;
+                offset += size;
+                return bytes;
+            }
+
+            /// \brief Throws unless count elements of a size are left, guarding the multiplication. Checked
+            /// before sizing anything from a count read from the snapshot.
+            void ExpectArray(Size count, Size size) const
+            {
+                if (size != 0 && count > (data.size() - offset) / size)
+                    throw std::invalid_argument("World snapshot is truncated.");
+            }
+
+            /// \brief Reads count elements of a size.
+            const std::byte* ReadArray(Size count, Size size)
+            {
+                ExpectArray(count, size);
+                return ReadBytes(count * size);
+            }
+
+            template<typename T>
+            T Read()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value;
+                std::memcpy(&value, ReadBytes(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            String ReadString()
+            {
+                const UInt64 length = Read<UInt64>();
+                return String(reinterpret_cast<const char*>(ReadBytes(length)), length);
+            }
+
+        private:
+            std::span<const std::byte> data;
+            Size offset;
+        };
+
+        /// \brief The reflected class of a component, looked up by its TypeID as class names are not unique
+        /// across namespaces.
+        const Class* FindComponentClass(const ECS::ComponentInfo& info)
+        {
+            return Meta::Reflection::Registry::GetInstance().FindClass(info.id);
+        }
+
+        const Class& GetFieldClass(const Field& field)
+        {
+            const Class* type = Meta::Reflection::Registry::GetInstance().FindClass(field.typeID);
+            if (type == nullptr)
+                throw std::invalid_argument("Reflected field " + field.name + " of type " + field.type
+                                            + " is neither trivially copyable, a String nor a reflected class.");
+            return *type;
+        }
+
+        /// \brief Describes the reflected layout of a class, snapshots are only restored into the same layout.
+        void AppendLayout(const Class& type, String& layout)
+        {
+            for (const Field& field: type.fields)
+            {
+                layout += field.name + ':' + field.type + '@' + std::to_string(field.offset) + '/'
+                          + std::to_string(field.size);
+                if (!field.trivial && field.typeID != Meta::TypeID<String>())
+                {
+                    layout += '{';
+                    AppendLayout(GetFieldClass(field), layout);
+                    layout += '}';
+                }
+                layout += ';';
+            }
+        }
+
+        void WriteValue(const Class& type, const std::byte* value, Writer& out)
+        {
+            for (const Field& field: type.fields)
+            {
+                const std::byte* data = value + field.offset;
+                if (field.trivial)
+                    out.WriteBytes(data, field.size);
+                else if (field.typeID == Meta::TypeID<String>())
+                    out.WriteString(*reinterpret_cast<const String*>(data));
+                else
+                    WriteValue(GetFieldClass(field), data, out);
+            }
+        }
+
+        /// \brief Assigns the reflected fields of a constructed value.
+        void ReadValue(const Class& type, std::byte* value, Reader& in)
+        {
+            for (const Field& field: type.fields)
+            {
+                std::byte* data = value + field.offset;
+                if (field.trivial)
+                    std::memcpy(data, in.ReadBytes(field.size), field.size);
+                else if (field.typeID == Meta::TypeID<String>())
+                    *reinterpret_cast<String*>(data) = in.ReadString();
+                else
+                    ReadValue(GetFieldClass(field), data, in);
+            }
+        }
+
+        /// \brief A component type of a snapshot, with its reflected class if it is not trivially copyable.
+        struct SnapshotComponent
+        {
+            const ECS::ComponentInfo* info;
+            const Class* type;
+        };
+
+        struct SnapshotArchetype
+        {
+            std::vector<UInt32> components;
+            std::vector<UInt32> rowCounts;
+        };
+
+        void WriteFile(std::ostream& out, const void* data, Size size)
+        {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            if (!out)
+                throw std::runtime_error("Failed to write the world snapshot.");
+        }
+    }
+
+    void WorldSnapshot::Save(const World& world, std::ostream& out)
+    {
+        // Component table, collected from the archetypes and the sparse sets
+        std::vector<SnapshotComponent> components;
+        std::unordered_map<Meta::TypeIDType, UInt32> componentIndices;
+        const auto addComponent = [&](const ECS::ComponentInfo& info)
+        {
+            if (componentIndices.contains(info.id))
+                return;
+            const Class* type = nullptr;
+            if (!info.trivial)
+            {
+                type = FindComponentClass(info);
+                if (type == nullptr)
+                    throw std::invalid_argument("Component " + String(info.name)
+                                                + " is neither trivially copyable nor reflected.");
+            }
+            componentIndices.emplace(info.id, static_cast<UInt32>(components.size()));
+            components.push_back({&info, type});
+        };
+        for (const Scope<ECS::Archetype>& archetype: world.archetypes)
+            for (const ECS::Archetype::Column& column: archetype->GetColumns())
+                addComponent(*column.info);
+        for (const Scope<ECS::SparseSet>& set: world.sparseSets)
+            addComponent(set->GetInfo());
+
+        Writer writer;
+        writer.Write(Header {});
+        for (const SnapshotComponent& component: components)
+        {
+            const ECS::ComponentInfo& info = *component.info;
+            writer.Write<UInt64>(info.id);
+            writer.Write<UInt64>(info.size);
+            writer.Write<UInt64>(info.alignment);
+            writer.Write<UInt8>(info.trivial);
+            writer.Write<UInt8>(static_cast<UInt8>(info.storage));
+            writer.WriteString(info.name);
+            String layout;
+            if (component.type != nullptr)
+                AppendLayout(*component.type, layout);
+            writer.WriteString(layout);
+        }
+
+        UInt64 chunkCount = 0;
+        for (const Scope<ECS::Archetype>& archetype: world.archetypes)
+        {
+            writer.Write<UInt32>(static_cast<UInt32>(archetype->GetColumns().size()));
+            writer.Write<UInt32>(static_cast<UInt32>(archetype->GetChunkCount()));
+            for (const ECS::Archetype::Column& column: archetype->GetColumns())
+                writer.Write<UInt32>(componentIndices.at(column.info->id));
+            for (Size i = 0; i < archetype->GetChunkCount(); ++i)
+                writer.Write<UInt32>(archetype->GetChunk(i).count);
+            chunkCount += archetype->GetChunkCount();
+        }
+
+        writer.WriteBytes(world.records.data(), world.records.size() * sizeof(ECS::EntityRecord));
+
+        const TransformHierarchy& transforms = world.transforms;
+        for (const ECS::Entity entity: transforms.GetEntities())
+            writer.Write(TransformEntry {entity, transforms.GetParent(entity), transforms.GetLocal(entity)});
+
+        UInt32 sparseSetCount = 0;
+        for (const Scope<ECS::SparseSet>& set: world.sparseSets)
+        {
+            const ECS::ComponentInfo& info = set->GetInfo();
+            const Class* type = components[componentIndices.at(info.id)].type;
+            writer.Write<UInt32>(componentIndices.at(info.id));
+            writer.Write<UInt64>(set->GetCount());
+            writer.WriteBytes(set->GetEntities().data(), set->GetCount() * sizeof(ECS::Entity));
+            if (type == nullptr)
+                writer.WriteBytes(set->GetData(), set->GetCount() * info.size);
+            else
+                for (Size i = 0; i < set->GetCount(); ++i)
+                    WriteValue(*type, set->GetData() + i * info.size, writer);
+            ++sparseSetCount;
+        }
+
+        // Reflected values of the table columns, the chunk images hold zeroes in their place
+        for (const Scope<ECS::Archetype>& archetype: world.archetypes)
+        {
+            const std::span<const ECS::Archetype::Column> columns = archetype->GetColumns();
+            for (UInt32 c = 0; c < columns.size(); ++c)
+            {
+                const Class* type = components[componentIndices.at(columns[c].info->id)].type;
+                if (type == nullptr)
+                    continue;
+                for (Size i = 0; i < archetype->GetChunkCount(); ++i)
+                {
+                    const std::byte* data = archetype->GetColumnData(c, i);
+                    for (UInt32 row = 0; row < archetype->GetChunk(i).count; ++row)
+                        WriteValue(*type, data + row * columns[c].info->size, writer);
+                }
+            }
+        }
+
+        Header header {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.byteOrderMark = BYTE_ORDER_MARK;
+        header.chunkSize = static_cast<UInt32>(ECS::CHUNK_SIZE);
+        header.componentCount = static_cast<UInt32>(components.size());
+        header.archetypeCount = static_cast<UInt32>(world.archetypes.size());
+        header.sparseSetCount = sparseSetCount;
+        header.freeHead = world.freeHead;
+        header.entityCount = world.entityCount;
+        header.recordCount = world.records.size();
+        header.transformCount = transforms.GetCount();
+        header.changeTick = world.changeTick;
+        header.chunkCount = chunkCount;
+        header.chunksOffset = AlignUp(writer.bytes.size(), ECS::CHUNK_SIZE);
+        std::memcpy(writer.bytes.data(), &header, sizeof(Header));
+        writer.bytes.resize(header.chunksOffset);
+        WriteFile(out, writer.bytes.data(), writer.bytes.size());
+
+        // Only the tick header, the used entity rows and the used rows of the trivial columns are copied into
+        // the zeroed image. Unused rows, padding and the pointers inside non-trivial components stay out of the
+        // file, so equal worlds give equal snapshots.
+        std::vector<std::byte> scratch(ECS::CHUNK_SIZE);
+        for (const Scope<ECS::Archetype>& archetype: world.archetypes)
+        {
+            const std::span<const ECS::Archetype::Column> columns = archetype->GetColumns();
+            for (Size i = 0; i < archetype->GetChunkCount(); ++i)
+            {
+                const ECS::Chunk& chunk = archetype->GetChunk(i);
+                const auto* entities = reinterpret_cast<const std::byte*>(archetype->GetEntities(i));
+                std::fill(scratch.begin(), scratch.end(), std::byte {0});
+                std::memcpy(scratch.data(), chunk.memory, entities - chunk.memory + chunk.count * sizeof(ECS::Entity));
+                for (const ECS::Archetype::Column& column: columns)
+                {
+                    if (column.info->trivial)
+                        std::memcpy(scratch.data() + column.offset, chunk.memory + column.offset,
+                                    column.info->size * chunk.count);
+                }
+                WriteFile(out, scratch.data(), ECS::CHUNK_SIZE);
+            }
+        }
+    }
+
+    void WorldSnapshot::Save(const World& world, const String& path)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw std::runtime_error("Cannot open " + path + " to write the world snapshot.");
+        Save(world, file);
+        file.close();
+        if (!file)
+            throw std::runtime_error("Failed to write the world snapshot to " + path + ".");
+    }
+
+    void WorldSnapshot::Load(World& world, std::span<const std::byte> data)
+    {
+        Restore(world, data, nullptr);
+    }
+
+    void WorldSnapshot::Map(World& world, const String& path)
+    {
+#ifdef _WIN32
+        const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open the world snapshot " + path + ".");
+        LARGE_INTEGER fileSize {};
+        const HANDLE fileMapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+                                   ? CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr)
+                                   : nullptr;
+        void* memory = fileMapping != nullptr ? MapViewOfFile(fileMapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+        if (fileMapping != nullptr)
+            CloseHandle(fileMapping);
+        CloseHandle(file);
+        if (memory == nullptr)
+            throw std::runtime_error("Cannot map the world snapshot " + path + ".");
+        const Size size = static_cast<Size>(fileSize.QuadPart);
+        const std::shared_ptr<void> mapping(memory, [](void* view) { UnmapViewOfFile(view); });
+#else
+        const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+            throw std::runtime_error("Cannot open the world snapshot " + path + ".");
+        struct stat status {};
+        const Bool sized = ::fstat(file, &status) == 0 && status.st_size > 0;
+        const Size size = sized ? static_cast<Size>(status.st_size) : 0;
+        // Private and writable, the world writes to its chunks without touching the file
+        void* memory = sized ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0) : MAP_FAILED;
+        ::close(file);
+        if (memory == MAP_FAILED)
+            throw std::runtime_error("Cannot map the world snapshot " + path + ".");
+        const std::shared_ptr<void> mapping(memory, [size](void* address) { ::munmap(address, size); });
+#endif
+        Restore(world, {static_cast<const std::byte*>(memory), size}, mapping);
+    }
+
+    void WorldSnapshot::Restore(World& world, std::span<const std::byte> data, const std::shared_ptr<void>& mapping)
+    {
+        if (!world.records.empty() || world.archetypes.size() != 1 || world.transforms.GetCount() != 0
+            || !world.sparseSets.IsEmpty())
+            throw std::invalid_argument("World snapshots are restored into new worlds.");
+
+        Reader reader(data, 0);
+        const Header header = reader.Read<Header>();
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+            throw std::invalid_argument("Data is not a world snapshot.");
+        if (header.version != VERSION || header.byteOrderMark != BYTE_ORDER_MARK
+            || header.chunkSize != ECS::CHUNK_SIZE)
+            throw std::invalid_argument("World snapshot was written by an incompatible build.");
+        if (header.chunksOffset % ECS::CHUNK_SIZE != 0 || header.chunksOffset > data.size()
+            || header.chunkCount > (data.size() - header.chunksOffset) / ECS::CHUNK_SIZE)
+            throw std::invalid_argument("World snapshot is truncated.");
+        if (header.recordCount > ECS::Entity::INVALID_INDEX || header.entityCount > header.recordCount)
+            throw std::invalid_argument("World snapshot has an invalid entity count.");
+
+        std::vector<SnapshotComponent> components;
+        for (UInt32 i = 0; i < header.componentCount; ++i)
+        {
+            const auto id = static_cast<Meta::TypeIDType>(reader.Read<UInt64>());
+            const UInt64 size = reader.Read<UInt64>();
+            const UInt64 alignment = reader.Read<UInt64>();
+            const Bool trivial = reader.Read<UInt8>() != 0;
+            const auto storage = static_cast<ECS::ComponentStorage>(reader.Read<UInt8>());
+            const String name = reader.ReadString();
+            const String layout = reader.ReadString();
+
+            const ECS::ComponentInfo* info = ECS::FindComponentInfo(id);
+            if (info == nullptr)
+                throw std::invalid_argument("Component " + name + " of the world snapshot is not registered.");
+            if (info->size != size || info->alignment != alignment || info->trivial != trivial
+                || info->storage != storage)
+                throw std::invalid_argument("Component " + name + " changed since the world snapshot was written.");
+
+            const Class* type = nullptr;
+            if (!trivial)
+            {
+                type = FindComponentClass(*info);
+                String currentLayout;
+                if (type != nullptr)
+                    AppendLayout(*type, currentLayout);
+                if (type == nullptr || type->ctor == nullptr || currentLayout != layout)
+                    throw std::invalid_argument("Reflected fields of component " + name
+                                                + " changed since the world snapshot was written.");
+            }
+            components.push_back({info, type});
+        }
+
+        // Every archetype starts with its column and chunk counts
+        reader.ExpectArray(header.archetypeCount, 2 * sizeof(UInt32));
+        std::vector<SnapshotArchetype> snapshotArchetypes(header.archetypeCount);
+        UInt64 chunkCount = 0;
+        for (SnapshotArchetype& archetype: snapshotArchetypes)
+        {
+            const UInt32 columnCount = reader.Read<UInt32>();
+            const UInt32 archetypeChunkCount = reader.Read<UInt32>();
+            const std::byte* indices = reader.ReadArray(columnCount, sizeof(UInt32));
+            const std::byte* rowCounts = reader.ReadArray(archetypeChunkCount, sizeof(UInt32));
+            archetype.components.resize(columnCount);
+            archetype.rowCounts.resize(archetypeChunkCount);
+            std::memcpy(archetype.components.data(), indices, columnCount * sizeof(UInt32));
+            std::memcpy(archetype.rowCounts.data(), rowCounts, archetypeChunkCount * sizeof(UInt32));
+            chunkCount += archetypeChunkCount;
+        }
+        if (snapshotArchetypes.empty() || !snapshotArchetypes[0].components.empty() || chunkCount != header.chunkCount)
+            throw std::invalid_argument("World snapshot has an invalid archetype table.");
+
+        const std::byte* recordBytes = reader.ReadArray(header.recordCount, sizeof(ECS::EntityRecord));
+        std::vector<ECS::EntityRecord> records(header.recordCount);
+        std::memcpy(records.data(), recordBytes, records.size() * sizeof(ECS::EntityRecord));
+
+        const std::byte* transformBytes = reader.ReadArray(header.transformCount, sizeof(TransformEntry));
+        std::vector<TransformEntry> transformEntries(header.transformCount);
+        std::memcpy(transformEntries.data(), transformBytes, transformEntries.size() * sizeof(TransformEntry));
+
+        // Recreate the archetypes in their order, so the records keep pointing at the right ones
+        std::vector<const ECS::ComponentInfo*> infos;
+        for (UInt32 a = 1; a < snapshotArchetypes.size(); ++a)
+        {
+            infos.clear();
+            for (const UInt32 index: snapshotArchetypes[a].components)
+            {
+                if (index >= components.size() || components[index].info->storage != ECS::ComponentStorage::Table
+                    || (!infos.empty() && infos.back()->id >= components[index].info->id))
+                    throw std::invalid_argument("World snapshot has an invalid archetype table.");
+                infos.push_back(components[index].info);
+            }
+            if (world.GetOrCreateArchetype(infos) != a)
+                throw std::invalid_argument("World snapshot has an invalid archetype table.");
+        }
+
+        for (UInt32 a = 0; a < snapshotArchetypes.size(); ++a)
+        {
+            const std::vector<UInt32>& rowCounts = snapshotArchetypes[a].rowCounts;
+            const UInt32 capacity = world.archetypes[a]->GetChunkCapacity();
+            for (Size i = 0; i < rowCounts.size(); ++i)
+            {
+                // Only the last chunk may be partially filled
+                if (rowCounts[i] == 0 || rowCounts[i] > capacity
+                    || (i + 1 < rowCounts.size() && rowCounts[i] != capacity))
+                    throw std::invalid_argument("World snapshot has an invalid archetype table.");
+            }
+        }
+
+        // The chunk images become chunks of the world, adopted in place or copied
+        std::byte* images = const_cast<std::byte*>(data.data()) + header.chunksOffset;
+        if (mapping != nullptr && header.chunkCount > 0)
+            world.chunkAllocator.AdoptChunks(images, header.chunkCount, mapping);
+        for (UInt32 a = 0; a < snapshotArchetypes.size(); ++a)
+        {
+            ECS::Archetype& archetype = *world.archetypes[a];
+            for (const UInt32 count: snapshotArchetypes[a].rowCounts)
+            {
+                std::byte* memory = images;
+                if (mapping == nullptr)
+                {
+                    memory = world.chunkAllocator.Allocate();
+                    std::memcpy(memory, images, ECS::CHUNK_SIZE);
+                }
+                images += ECS::CHUNK_SIZE;
+                // Constructed now so that the chunk can always be destroyed, assigned from the metadata below
+                const std::span<const ECS::Archetype::Column> columns = archetype.GetColumns();
+                for (UInt32 c = 0; c < columns.size(); ++c)
+                {
+                    const Class* type = components[snapshotArchetypes[a].components[c]].type;
+                    if (type == nullptr)
+                        continue;
+                    for (UInt32 row = 0; row < count; ++row)
+                        type->ctor(memory + columns[c].offset + row * columns[c].info->size);
+                }
+                archetype.AdoptChunk(memory, count);
+            }
+        }
+
+        // Every row must be the entity its record locates there, and the free list must only hold free slots
+        Size aliveCount = 0;
+        for (const ECS::EntityRecord& record: records)
+        {
+            if (record.archetype == ECS::Archetype::INVALID_ARCHETYPE)
+                continue;
+            if (record.archetype >= snapshotArchetypes.size()
+                || record.location.chunk >= snapshotArchetypes[record.archetype].rowCounts.size()
+                || record.location.row >= snapshotArchetypes[record.archetype].rowCounts[record.location.chunk])
+                throw std::invalid_argument("World snapshot has an invalid entity record.");
+            ++aliveCount;
+        }
+        for (UInt32 a = 0; a < snapshotArchetypes.size(); ++a)
+        {
+            const ECS::Archetype& archetype = *world.archetypes[a];
+            for (UInt32 i = 0; i < archetype.GetChunkCount(); ++i)
+            {
+                const ECS::Entity* entities = archetype.GetEntities(i);
+                for (UInt32 row = 0; row < archetype.GetChunk(i).count; ++row)
+                {
+                    const UInt32 index = entities[row].GetIndex();
+                    if (index >= records.size() || records[index].archetype != a
+                        || records[index].generation != entities[row].GetGeneration()
+                        || records[index].location.chunk != i || records[index].location.row != row)
+                        throw std::invalid_argument("World snapshot has an invalid entity record.");
+                }
+            }
+        }
+        std::vector<Bool> isFree(records.size(), false);
+        Size freeCount = 0;
+        for (UInt32 slot = header.freeHead; slot != World::NO_FREE_SLOT; slot = records[slot].nextFree)
+        {
+            if (slot >= records.size() || records[slot].archetype != ECS::Archetype::INVALID_ARCHETYPE
+                || isFree[slot])
+                throw std::invalid_argument("World snapshot has an invalid entity record.");
+            isFree[slot] = true;
+            ++freeCount;
+        }
+        // The other dead slots must have been retired at the last generation, World::DestroyEntity keeps
+        // them out of the free list
+        Size retiredCount = 0;
+        for (Size i = 0; i < records.size(); ++i)
+        {
+            if (records[i].archetype == ECS::Archetype::INVALID_ARCHETYPE && !isFree[i]
+                && records[i].generation == std::numeric_limits<UInt32>::max())
+                ++retiredCount;
+        }
+        if (aliveCount != header.entityCount || freeCount + retiredCount != records.size() - aliveCount)
+            throw std::invalid_argument("World snapshot has an invalid entity record.");
+
+        world.records = std::move(records);
+        world.freeHead = header.freeHead;
+        world.entityCount = header.entityCount;
+        world.changeTick = std::max(world.changeTick, header.changeTick);
+
+        for (const TransformEntry& entry: transformEntries)
+        {
+            if (!world.IsAlive(entry.entity))
+                throw std::invalid_argument("World snapshot has a transform of a dead entity.");
+            world.transforms.Add(entry.entity, entry.local);
+        }
+        for (const TransformEntry& entry: transformEntries)
+            if (entry.parent.IsValid())
+                world.transforms.SetParent(entry.entity, entry.parent);
+
+        for (UInt32 s = 0; s < header.sparseSetCount; ++s)
+        {
+            const UInt32 index = reader.Read<UInt32>();
+            if (index >= components.size() || components[index].info->storage != ECS::ComponentStorage::SparseSet)
+                throw std::invalid_argument("World snapshot has an invalid sparse set.");
+            const SnapshotComponent& component = components[index];
+            const UInt64 count = reader.Read<UInt64>();
+            const std::byte* entities = reader.ReadArray(count, sizeof(ECS::Entity));
+            const std::byte* values = component.type == nullptr ? reader.ReadArray(count, component.info->size)
+                                                                : nullptr;
+
+            ECS::SparseSet& set = world.GetOrCreateSparseSet(*component.info);
+            for (UInt64 i = 0; i < count; ++i)
+            {
+                ECS::Entity entity;
+                std::memcpy(&entity, entities + i * sizeof(ECS::Entity), sizeof(ECS::Entity));
+                if (!world.IsAlive(entity) || set.Contains(entity))
+                    throw std::invalid_argument("World snapshot has an invalid sparse set.");
+                std::byte* value = set.Emplace(entity);
+                if (component.type == nullptr)
+                    std::memcpy(value, values + i * component.info->size, component.info->size);
+                else
+                    component.type->ctor(value);
+            }
+            if (component.type != nullptr)
+                for (UInt64 i = 0; i < count; ++i)
+                    ReadValue(*component.type, set.GetData() + i * component.info->size, reader);
+        }
+
+        for (UInt32 a = 0; a < snapshotArchetypes.size(); ++a)
+        {
+            const ECS::Archetype& archetype = *world.archetypes[a];
+            const std::span<const ECS::Archetype::Column> columns = archetype.GetColumns();
+            for (UInt32 c = 0; c < columns.size(); ++c)
+            {
+                const Class* type = components[snapshotArchetypes[a].components[c]].type;
+                if (type == nullptr)
+                    continue;
+                for (Size i = 0; i < archetype.GetChunkCount(); ++i)
+                {
+                    std::byte* columnData = archetype.GetColumnData(c, i);
+                    for (UInt32 row = 0; row < archetype.GetChunk(i).count; ++row)
+                        ReadValue(*type, columnData + row * columns[c].info->size, reader);
+                }
+            }
+        }
+
+        // Brings the world matrices and the spatial index up to date with the restored transforms
+        world.UpdateTransforms();
+    }
+}
@@ -0,0 +1,102 @@
+#include <NGIN/Memory/PoolAllocator.hpp>
+#include <NGIN/Memory/Internal/Alignment.hpp>
+
+#include <utility>
+
+namespace NGIN::Memory
+{
+
+    PoolAllocator::PoolAllocator(size_t blockSize, size_t blockCount, size_t blockAlignment)
+        : blockCount(blockCount), blockAlignment(blockAlignment < alignof(FreeBlock) ? alignof(FreeBlock) : blockAlignment)
+    {
+        // Every block must hold the free list link and keep the following block aligned
+        const size_t minimumSize = blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize;
+        this->blockSize = (minimumSize + this->blockAlignment - 1) & ~(this->blockAlignment - 1);
+
+        buffer = std::make_unique<std::byte[]>(this->blockSize * blockCount + this->blockAlignment - 1);
+        start = static_cast<std::byte *>(Internal::AlignPtr(buffer.get(), this->blockAlignment));
+        DeallocateAll();
+    }
+
+    PoolAllocator::PoolAllocator(PoolAllocator &&other) noexcept
+        : buffer(std::move(other.buffer)), start(other.start), freeList(other.freeList),
+          blockSize(other.blockSize), blockCount(other.blockCount), blockAlignment(other.blockAlignment),
+          freeBlockCount(other.freeBlockCount)
+    {
+        other.start = nullptr;
+        other.freeList = nullptr;
+        other.blockCount = 0;
+        other.freeBlockCount = 0;
+    }
+
+    PoolAllocator &PoolAllocator::operator=(PoolAllocator &&other) noexcept
+    {
+        if (this != &other)
+        {
+            buffer = std::move(other.buffer);
+            start = std::exchange(other.start, nullptr);
+            freeList = std::exchange(other.freeList, nullptr);
+            blockSize = other.blockSize;
+            blockCount = std::exchange(other.blockCount, 0);
+            blockAlignment = other.blockAlignment;
+            freeBlockCount = std::exchange(other.freeBlockCount, 0);
+        }
+        return *this;
+    }
+
+    void *PoolAllocator::Allocate(size_t size,
+                                  size_t alignment,
+                                  const std::source_location &location)
+    {
+        if (freeList == nullptr || size > blockSize || alignment > blockAlignment)
+            return nullptr;
+
+        FreeBlock *block = freeList;
+        freeList = block->next;
+        --freeBlockCount;
+        return block;
+    }
+
+    void PoolAllocator::Deallocate(void *ptr)
+    {
+        if (ptr == nullptr)
+            return;
+
+        FreeBlock *block = static_cast<FreeBlock *>(ptr);
+        block->next = freeList;
+        freeList = block;
+        ++freeBlockCount;
+    }
+
+    void PoolAllocator::DeallocateAll()
+    {
+        // Link the blocks in address order so fresh pools hand out memory front to back
+        freeList = nullptr;
+        for (size_t i = blockCount; i > 0; --i)
+        {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(start + (i - 1) * blockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+        freeBlockCount = blockCount;
+    }
+
+    bool PoolAllocator::Owns(void *ptr) const
+    {
+        uintptr_t startAddress = reinterpret_cast<uintptr_t>(start);
+        uintptr_t endAddress = startAddress + blockSize * blockCount;
+        uintptr_t targetAddress = reinterpret_cast<uintptr_t>(ptr);
+
+        return targetAddress >= startAddress && targetAddress < endAddress;
+    }
+
+    size_t PoolAllocator::GetBlockSize() const noexcept
+    {
+        return blockSize;
+    }
+
+    size_t PoolAllocator::GetFreeBlockCount() const noexcept
+    {
+        return freeBlockCount;
+    }
+} // namespace NGIN::Memory
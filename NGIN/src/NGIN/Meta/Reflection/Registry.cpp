@@ -11,7 +11,8 @@ namespace NGIN::Meta::Reflection
 
     void Registry::AddClass(const Types::Class& classData)
     {
-        classMap[classData.name] = classData;
+        classMap[classData.typeID] = classData;
+        classNames[classData.name] = classData.typeID;
         std::cout << "Class: " << classData.name << std::endl;
         std::cout << "Fields:" << classData.fields.size() << std::endl;
         for (const auto& field: classData.fields)
@@ -28,7 +29,15 @@ namespace NGIN::Meta::Reflection
 
     const Types::Class& Registry::GetClassFromString(const std::string& className)
     {
-        return classMap[className];
+        static const Types::Class EMPTY {};
+        const auto it = classNames.find(className);
+        return it != classNames.end() ? classMap.at(it->second) : EMPTY;
+    }
+
+    const Types::Class* Registry::FindClass(TypeIDType typeID) const
+    {
+        const auto it = classMap.find(typeID);
+        return it != classMap.end() ? &it->second : nullptr;
     }
 
     void Registry::AddEnum(const Types::Enum& enumData)
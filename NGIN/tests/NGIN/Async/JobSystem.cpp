@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <NGIN/Async/JobSystem.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace NGIN;
+
+TEST(JobSystemTests, WaitRunsAllSpawnedJobs)
+{
+    Async::JobSystem jobSystem(4);
+    std::atomic<int> counter = 0;
+
+    Async::JobCounter jobs;
+    for (int i = 0; i < 10000; ++i)
+        jobSystem.Spawn([&counter]() { counter.fetch_add(1); }, &jobs);
+    jobSystem.Wait(jobs);
+
+    EXPECT_EQ(counter.load(), 10000);
+    EXPECT_TRUE(jobs.IsDone());
+}
+
+TEST(JobSystemTests, JobsCanWaitOnJobsTheySpawned)
+{
+    Async::JobSystem jobSystem(2);
+    std::atomic<int> counter = 0;
+
+    Async::JobCounter outer;
+    for (int i = 0; i < 16; ++i)
+    {
+        jobSystem.Spawn([&jobSystem, &counter]()
+        {
+            Async::JobCounter inner;
+            for (int j = 0; j < 16; ++j)
+                jobSystem.Spawn([&counter]() { counter.fetch_add(1); }, &inner);
+            jobSystem.Wait(inner);
+        }, &outer);
+    }
+    jobSystem.Wait(outer);
+
+    EXPECT_EQ(counter.load(), 16 * 16);
+}
+
+TEST(JobSystemTests, ContinuationRunsAfterCounter)
+{
+    Async::JobSystem jobSystem(4);
+    std::atomic<int> counter = 0;
+    int seenByContinuation = -1;
+
+    Async::JobCounter first;
+    Async::JobCounter second;
+    for (int i = 0; i < 100; ++i)
+        jobSystem.Spawn([&counter]() { counter.fetch_add(1); }, &first);
+    jobSystem.ContinueWith(first, [&]() { seenByContinuation = counter.load(); }, &second);
+    jobSystem.Wait(second);
+
+    EXPECT_EQ(seenByContinuation, 100);
+}
+
+TEST(JobSystemTests, ContinuationOnFinishedCounterRunsImmediately)
+{
+    Async::JobSystem jobSystem(1);
+    Bool ran = false;
+
+    Async::JobCounter finished;
+    Async::JobCounter next;
+    jobSystem.ContinueWith(finished, [&ran]() { ran = true; }, &next);
+    jobSystem.Wait(next);
+
+    EXPECT_TRUE(ran);
+}
+
+TEST(JobSystemTests, AffinityPinsJobsToThread)
+{
+    Async::JobSystem jobSystem(3);
+    const auto mainThread = std::this_thread::get_id();
+    std::atomic<int> wrongThread = 0;
+
+    Async::JobCounter jobs;
+    for (int i = 0; i < 100; ++i)
+    {
+        jobSystem.Spawn([&]()
+        {
+            if (std::this_thread::get_id() != mainThread)
+                wrongThread.fetch_add(1);
+        }, &jobs, Async::JobSystem::MAIN_THREAD);
+    }
+    jobSystem.Wait(jobs);
+
+    EXPECT_EQ(wrongThread.load(), 0);
+
+    std::atomic<UInt32> workerIndex = Async::JobSystem::ANY_THREAD;
+    jobSystem.Spawn([&]() { workerIndex = jobSystem.GetCurrentThreadIndex(); }, &jobs, 2);
+    jobSystem.Wait(jobs);
+
+    EXPECT_EQ(workerIndex.load(), 2u);
+}
+
+TEST(JobSystemTests, ParallelForCoversRangeOnce)
+{
+    Async::JobSystem jobSystem(4);
+    std::vector<std::atomic<int>> hits(1000);
+
+    jobSystem.ParallelFor(hits.size(), 7, [&hits](Size begin, Size end)
+    {
+        for (Size i = begin; i < end; ++i)
+            hits[i].fetch_add(1);
+    });
+
+    for (const auto& hit: hits)
+        ASSERT_EQ(hit.load(), 1);
+}
+
+TEST(JobSystemTests, ThreadIndices)
+{
+    Async::JobSystem jobSystem(2);
+    EXPECT_EQ(jobSystem.GetThreadCount(), 3u);
+    EXPECT_EQ(jobSystem.GetCurrentThreadIndex(), Async::JobSystem::MAIN_THREAD);
+
+    UInt32 indexOutside = 0;
+    std::thread([&]() { indexOutside = jobSystem.GetCurrentThreadIndex(); }).join();
+    EXPECT_EQ(indexOutside, Async::JobSystem::ANY_THREAD);
+}
+
+TEST(JobSystemTests, SpawnFromOutsideThread)
+{
+    Async::JobSystem jobSystem(2);
+    std::atomic<int> counter = 0;
+
+    Async::JobCounter jobs;
+    std::thread([&]()
+    {
+        for (int i = 0; i < 100; ++i)
+            jobSystem.Spawn([&counter]() { counter.fetch_add(1); }, &jobs);
+    }).join();
+    jobSystem.Wait(jobs);
+
+    EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(JobSystemTests, DestructorRunsRemainingJobs)
+{
+    std::atomic<int> counter = 0;
+    {
+        Async::JobSystem jobSystem(2);
+        for (int i = 0; i < 1000; ++i)
+            jobSystem.Spawn([&counter]() { counter.fetch_add(1); });
+    }
+    EXPECT_EQ(counter.load(), 1000);
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <NGIN/Async/CoroutineScheduler.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NGIN;
+
+namespace
+{
+    Async::Task<int> Add(int a, int b)
+    {
+        co_return a + b;
+    }
+
+    Async::Task<std::string> Concatenate()
+    {
+        const int sum = co_await Add(1, 2);
+        co_return "sum " + std::to_string(sum);
+    }
+
+    Async::Task<int> Throw()
+    {
+        throw std::runtime_error("task failed");
+        co_return 0;
+    }
+
+    Async::Task<void> CountFrames(std::vector<UInt64>& frames, Async::CoroutineScheduler& scheduler, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            frames.push_back(scheduler.GetFrame());
+            co_await Async::NextFrame();
+        }
+    }
+
+    Async::Task<int> WaitThenReturn(int frames)
+    {
+        for (int i = 0; i < frames; ++i)
+            co_await Async::NextFrame();
+        co_return frames;
+    }
+
+    // Suspending coroutines take state as parameters, lambda captures die with the lambda temporary
+    Async::Task<void> StoreAfterFrames(int& result, int frames)
+    {
+        result = co_await WaitThenReturn(frames);
+    }
+
+    Async::Task<void> SetAfterSeconds(Bool& flag, F64 seconds)
+    {
+        co_await Async::Seconds(seconds);
+        flag = true;
+    }
+}
+
+TEST(TaskTests, TasksAreLazy)
+{
+    Bool started = false;
+    auto task = [&]() -> Async::Task<void>
+    {
+        started = true;
+        co_return;
+    }();
+
+    EXPECT_FALSE(started);
+    EXPECT_FALSE(task.IsDone());
+}
+
+TEST(TaskTests, AwaitingReturnsResult)
+{
+    Async::CoroutineScheduler scheduler;
+    std::string result;
+    scheduler.Spawn([&]() -> Async::Task<void> { result = co_await Concatenate(); }());
+
+    EXPECT_EQ(result, "sum 3");
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST(TaskTests, ExceptionsPropagateToAwaiter)
+{
+    Async::CoroutineScheduler scheduler;
+    Bool caught = false;
+    scheduler.Spawn([&]() -> Async::Task<void>
+    {
+        try
+        {
+            co_await Throw();
+        } catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+    }());
+
+    EXPECT_TRUE(caught);
+}
+
+TEST(TaskTests, UnhandledExceptionIsRethrownFromUpdate)
+{
+    Async::CoroutineScheduler scheduler;
+    scheduler.Spawn([]() -> Async::Task<void> { co_await Throw(); }());
+
+    EXPECT_THROW(scheduler.Update(), std::runtime_error);
+    EXPECT_NO_THROW(scheduler.Update());
+}
+
+TEST(CoroutineSchedulerTests, NextFrameResumesOncePerUpdate)
+{
+    Async::CoroutineScheduler scheduler;
+    std::vector<UInt64> frames;
+    scheduler.Spawn(CountFrames(frames, scheduler, 3));
+
+    EXPECT_EQ(frames, (std::vector<UInt64> {0}));
+    scheduler.Update();
+    scheduler.Update();
+    EXPECT_EQ(frames, (std::vector<UInt64> {0, 1, 2}));
+    EXPECT_EQ(scheduler.GetTaskCount(), 1u);
+
+    scheduler.Update();
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST(CoroutineSchedulerTests, NestedTasksWaitAcrossFrames)
+{
+    Async::CoroutineScheduler scheduler;
+    int result = 0;
+    scheduler.Spawn(StoreAfterFrames(result, 2));
+
+    scheduler.Update();
+    EXPECT_EQ(result, 0);
+    scheduler.Update();
+    EXPECT_EQ(result, 2);
+}
+
+TEST(CoroutineSchedulerTests, SecondsWaitsOnTimer)
+{
+    Async::CoroutineScheduler scheduler;
+    Bool resumed = false;
+    scheduler.Spawn(SetAfterSeconds(resumed, 0.02));
+
+    scheduler.Update();
+    EXPECT_FALSE(resumed);
+
+    const F64 start = scheduler.GetTime();
+    while (!resumed && scheduler.GetTime() - start < 1.0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        scheduler.Update();
+    }
+    EXPECT_TRUE(resumed);
+}
+
+TEST(CoroutineSchedulerTests, ZeroSecondsDoesNotSuspend)
+{
+    Async::CoroutineScheduler scheduler;
+    Bool resumed = false;
+    scheduler.Spawn([&]() -> Async::Task<void>
+    {
+        co_await Async::Seconds(0.0);
+        resumed = true;
+    }());
+
+    EXPECT_TRUE(resumed);
+}
+
+TEST(CoroutineSchedulerTests, DestroysUnfinishedTasks)
+{
+    struct Guard
+    {
+        int& destroyed;
+
+        ~Guard()
+        { ++destroyed; }
+    };
+
+    int destroyed = 0;
+    {
+        Async::CoroutineScheduler scheduler;
+        scheduler.Spawn([](int& destroyed) -> Async::Task<void>
+        {
+            Guard guard {destroyed};
+            co_await Async::Seconds(1000.0);
+        }(destroyed));
+        EXPECT_EQ(destroyed, 0);
+    }
+    EXPECT_EQ(destroyed, 1);
+}
+
+TEST(CoroutineSchedulerTests, ManyShortLivedTasks)
+{
+    Async::CoroutineScheduler scheduler;
+    int finished = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        scheduler.Spawn([](int& finished) -> Async::Task<void>
+        {
+            co_await Async::NextFrame();
+            ++finished;
+        }(finished));
+    }
+
+    scheduler.Update();
+    scheduler.Update();
+    EXPECT_EQ(finished, 1000);
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
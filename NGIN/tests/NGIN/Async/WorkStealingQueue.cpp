@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <NGIN/Async/WorkStealingQueue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace NGIN;
+
+TEST(WorkStealingQueueTests, PopIsLifoAndStealIsFifo)
+{
+    Async::WorkStealingQueue<int, 8> queue;
+    int values[3] = {0, 1, 2};
+    for (int& value: values)
+        EXPECT_TRUE(queue.Push(&value));
+
+    EXPECT_EQ(queue.GetSize(), 3u);
+    EXPECT_EQ(queue.Pop(), &values[2]);
+    EXPECT_EQ(queue.Steal(), &values[0]);
+    EXPECT_EQ(queue.Pop(), &values[1]);
+    EXPECT_EQ(queue.Pop(), nullptr);
+    EXPECT_EQ(queue.Steal(), nullptr);
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(WorkStealingQueueTests, PushFailsWhenFull)
+{
+    Async::WorkStealingQueue<int, 4> queue;
+    int value = 0;
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.Push(&value));
+    EXPECT_FALSE(queue.Push(&value));
+
+    queue.Steal();
+    EXPECT_TRUE(queue.Push(&value));
+}
+
+TEST(WorkStealingQueueTests, EveryElementIsTakenExactlyOnce)
+{
+    constexpr int COUNT = 100000;
+    Async::WorkStealingQueue<int, 1024> queue;
+    std::vector<int> values(COUNT);
+    std::vector<std::atomic<int>> taken(COUNT);
+    std::atomic<Bool> done = false;
+
+    auto take = [&](int* value)
+    {
+        if (value)
+            taken[value - values.data()].fetch_add(1);
+    };
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i)
+    {
+        thieves.emplace_back([&]()
+        {
+            while (!done.load() || !queue.IsEmpty())
+                take(queue.Steal());
+        });
+    }
+
+    for (int i = 0; i < COUNT; ++i)
+    {
+        while (!queue.Push(&values[i]))
+            take(queue.Pop());
+        if (i % 3 == 0)
+            take(queue.Pop());
+    }
+    while (!queue.IsEmpty())
+        take(queue.Pop());
+    done = true;
+
+    for (auto& thief: thieves)
+        thief.join();
+
+    for (const auto& count: taken)
+        ASSERT_EQ(count.load(), 1);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/World.hpp>
+
+#include <vector>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 1.0f;
+    };
+
+    struct Tag
+    {
+    };
+
+    template<typename... Terms>
+    Size CountChunks(Core::World& world, UInt64 sinceTick)
+    {
+        Size count = 0;
+        for (auto chunk: world.Query<Terms...>(sinceTick))
+        {
+            (void) chunk;
+            ++count;
+        }
+        return count;
+    }
+}
+
+TEST(ChangeDetectionTests, CreatedEntitiesCountAsAddedAndChanged)
+{
+    Core::World world;
+    world.CreateEntity(Position {}, Velocity {});
+
+    EXPECT_EQ((world.Query<const Position&, ECS::Added<Velocity>>().GetEntityCount()), 1u);
+    EXPECT_EQ((world.Query<const Position&, ECS::Changed<Position>>().GetEntityCount()), 1u);
+
+    const UInt64 since = world.AdvanceChangeTick();
+    EXPECT_EQ((world.Query<const Position&, ECS::Added<Velocity>>(since).GetEntityCount()), 0u);
+    EXPECT_EQ((world.Query<const Position&, ECS::Changed<Position>>(since).GetEntityCount()), 0u);
+}
+
+TEST(ChangeDetectionTests, OnlyMutableAccessMarksChanges)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity(Position {}, Velocity {});
+    const UInt64 since = world.AdvanceChangeTick();
+
+    const Core::World& constWorld = world;
+    (void) constWorld.GetComponent<Position>(entity);
+    for (auto chunk: world.Query<const Position&>())
+        (void) chunk;
+    EXPECT_EQ(CountChunks<ECS::Changed<Position>>(world, since), 0u);
+
+    world.GetComponent<Position>(entity).x = 1.0f;
+    EXPECT_EQ(CountChunks<ECS::Changed<Position>>(world, since), 1u);
+    EXPECT_EQ(CountChunks<ECS::Changed<Velocity>>(world, since), 0u);
+
+    for (auto chunk: world.Query<Velocity&>())
+        (void) chunk;
+    EXPECT_EQ(CountChunks<ECS::Changed<Velocity>>(world, since), 1u);
+    EXPECT_EQ(CountChunks<ECS::Added<Velocity>>(world, since), 0u);
+}
+
+TEST(ChangeDetectionTests, UntouchedChunksAreSkipped)
+{
+    Core::World world;
+    std::vector<ECS::Entity> entities;
+    for (int i = 0; i < 5000; ++i)
+        entities.push_back(world.CreateEntity(Position {float(i)}, Velocity {}));
+    ASSERT_GT(world.GetChunkCount(), 2u);
+
+    const UInt64 since = world.AdvanceChangeTick();
+    world.GetComponent<Position>(entities.back()).x = -1.0f;
+
+    Size visited = 0;
+    Bool found = false;
+    for (auto chunk: world.Query<const Position&, ECS::Changed<Position>>(since))
+    {
+        visited += chunk.GetCount();
+        for (const Position& position: chunk.Get<Position>())
+            found = found || position.x == -1.0f;
+    }
+    EXPECT_TRUE(found);
+    EXPECT_LT(visited, entities.size());
+    EXPECT_EQ(visited, (world.Query<const Position&, ECS::Changed<Position>>(since).GetEntityCount()));
+}
+
+TEST(ChangeDetectionTests, MovedRowsKeepTheirChanges)
+{
+    Core::World world;
+    std::vector<ECS::Entity> entities;
+    for (int i = 0; i < 5000; ++i)
+        entities.push_back(world.CreateEntity(Position {float(i)}, Velocity {}));
+
+    const UInt64 since = world.AdvanceChangeTick();
+    world.GetComponent<Position>(entities.back()).x = -1.0f;
+    // The changed last row moves into the first chunk, then to another archetype
+    world.DestroyEntity(entities.front());
+    world.AddComponent<Tag>(entities.back());
+
+    Bool found = false;
+    world.Query<const Position&, ECS::Changed<Position>, ECS::Without<Tag>>(since).ForEach([&](const Position& position)
+    {
+        found = found || position.x == -1.0f;
+    });
+    EXPECT_FALSE(found);
+
+    world.Query<const Position&, ECS::Changed<Position>, ECS::With<Tag>>(since).ForEach([&](const Position& position)
+    {
+        found = found || position.x == -1.0f;
+    });
+    EXPECT_TRUE(found);
+    EXPECT_EQ(CountChunks<ECS::Added<Tag>>(world, since), 1u);
+    EXPECT_EQ(CountChunks<ECS::Added<Position>>(world, since), 0u);
+}
+
+TEST(ChangeDetectionTests, FiltersAreReads)
+{
+    using Traits = ECS::QueryTraits<Position&, ECS::Changed<Velocity>, ECS::Added<Tag>>;
+    static_assert(Traits::FETCHED_IDS.size() == 1);
+    static_assert(Traits::REQUIRED_IDS.size() == 3);
+    static_assert(Traits::CHANGED_IDS.size() == 1 && Traits::CHANGED_IDS[0] == ECS::ComponentID<Velocity>());
+    static_assert(Traits::ADDED_IDS.size() == 1 && Traits::ADDED_IDS[0] == ECS::ComponentID<Tag>());
+    static_assert(Traits::READ_IDS.size() == 2);
+    static_assert(Traits::SIGNATURE_HASH != ECS::QueryTraits<Position&, ECS::With<Velocity>, ECS::With<Tag>>::SIGNATURE_HASH);
+    SUCCEED();
+}
+
+TEST(ChangeDetectionTests, SystemsSeeChangesSinceTheirLastRun)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity(Position {}, Velocity {});
+
+    Size seen = 0;
+    world.AddSystem<const Position&, ECS::Changed<Position>>("Observer", [&](const auto& chunk) { seen += chunk.GetCount(); });
+    // Only runs while Velocity changed, which it did once by creating the entity
+    world.AddSystem<Position&, ECS::Changed<Velocity>>("Writer", [](const auto& chunk) { chunk.template Get<Position>()[0].x += 1.0f; });
+
+    world.RunSystems(0.0);
+    EXPECT_EQ(seen, 1u);
+    // The writer ran after the observer, which sees its change in the next frame
+    world.RunSystems(0.0);
+    EXPECT_EQ(seen, 2u);
+    world.RunSystems(0.0);
+    EXPECT_EQ(seen, 2u);
+    EXPECT_EQ(world.GetComponent<Position>(entity).x, 1.0f);
+
+    // Changes made between frames are seen as well
+    world.GetComponent<Position>(entity).x = 5.0f;
+    world.RunSystems(0.0);
+    EXPECT_EQ(seen, 3u);
+}
+
+TEST(ChangeDetectionTests, SystemsSkipUnchangedChunks)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity(Position {}, Velocity {});
+
+    Size seen = 0;
+    world.AddSystem<Velocity&, ECS::Changed<Position>>("Observer", [&](const auto& chunk) { seen += chunk.GetCount(); });
+
+    world.RunSystems(0.0);
+    EXPECT_EQ(seen, 1u);
+    // The observer's own writes to Velocity do not count as Position changes
+    world.RunSystems(0.0);
+    EXPECT_EQ(seen, 1u);
+
+    world.GetComponent<Position>(entity).x = 1.0f;
+    world.RunSystems(0.0);
+    EXPECT_EQ(seen, 2u);
+    world.RunSystems(0.0);
+    EXPECT_EQ(seen, 2u);
+}
+
+TEST(ChangeDetectionTests, DeferredAddsAreSeenAfterTheSyncPoint)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity(Position {});
+
+    Size added = 0;
+    world.AddSystem<const Position&>("Tagger", [&](const auto& chunk)
+    {
+        for (ECS::Entity e: chunk.GetEntities())
+            world.GetCommandBuffer().AddComponent<Tag>(e);
+    });
+    world.AddExclusiveSystem("Sync", [](Core::World&, F64) {});
+    world.AddSystem<const Position&, ECS::Added<Tag>>("Observer", [&](const auto& chunk) { added += chunk.GetCount(); });
+
+    world.RunSystems(0.0);
+    EXPECT_TRUE(world.HasComponent<Tag>(entity));
+    EXPECT_EQ(added, 1u);
+    // Adding a component the entity already has replaces it, which is a change but no addition
+    world.RunSystems(0.0);
+    EXPECT_EQ(added, 1u);
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <NGIN/Async/JobSystem.hpp>
+#include <NGIN/Core/World.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 0.0f;
+    };
+
+    struct Name
+    {
+        std::string value;
+    };
+
+    struct alignas(32) Wide
+    {
+        float values[8] = {};
+    };
+
+    struct Counted
+    {
+        explicit Counted(std::shared_ptr<int> counter)
+                : counter(std::move(counter))
+        {}
+
+        std::shared_ptr<int> counter;
+    };
+
+    struct Throwing
+    {
+        explicit Throwing(int)
+        { throw std::runtime_error("construct"); }
+    };
+}
+
+TEST(CommandBufferTests, ChangesApplyOnFlush)
+{
+    Core::World world;
+    const ECS::Entity a = world.CreateEntity(Position {1.0f});
+    const ECS::Entity b = world.CreateEntity(Position {2.0f}, Velocity {});
+
+    ECS::CommandBuffer& commands = world.GetCommandBuffer();
+    EXPECT_EQ(&commands, &world.GetCommandBuffer());
+    commands.AddComponent<Name>(a, "a");
+    commands.RemoveComponent<Velocity>(b);
+    commands.CreateEntity(Position {3.0f}, Name {"c"});
+    commands.DestroyEntity(a);
+    EXPECT_EQ(commands.GetCommandCount(), 4u);
+
+    // Nothing changes until the sync point
+    EXPECT_FALSE(world.HasComponent<Name>(a));
+    EXPECT_TRUE(world.HasComponent<Velocity>(b));
+    EXPECT_EQ(world.GetEntityCount(), 2u);
+
+    world.FlushCommands();
+    EXPECT_TRUE(commands.IsEmpty());
+    EXPECT_FALSE(world.IsAlive(a));
+    EXPECT_FALSE(world.HasComponent<Velocity>(b));
+    EXPECT_EQ(world.GetEntityCount(), 2u);
+
+    int named = 0;
+    world.Query<const Position&, const Name&>().ForEach([&](const Position& position, const Name& name)
+                                                        {
+                                                            EXPECT_FLOAT_EQ(position.x, 3.0f);
+                                                            EXPECT_EQ(name.value, "c");
+                                                            ++named;
+                                                        });
+    EXPECT_EQ(named, 1);
+}
+
+TEST(CommandBufferTests, ChangesToOneEntityMoveItOnce)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity(Position {1.0f}, Name {"old"});
+
+    ECS::CommandBuffer& commands = world.GetCommandBuffer();
+    commands.AddComponent<Velocity>(entity, 1.0f);
+    commands.AddComponent<Velocity>(entity, 2.0f);
+    commands.AddComponent<Name>(entity, "new");
+    commands.RemoveComponent<Position>(entity);
+    commands.AddComponent<Position>(entity, 5.0f);
+    commands.AddComponent<Wide>(entity);
+    commands.RemoveComponent<Wide>(entity);
+    world.FlushCommands();
+
+    EXPECT_FLOAT_EQ(world.GetComponent<Velocity>(entity).x, 2.0f);
+    EXPECT_EQ(world.GetComponent<Name>(entity).value, "new");
+    EXPECT_FLOAT_EQ(world.GetComponent<Position>(entity).x, 5.0f);
+    EXPECT_FALSE(world.HasComponent<Wide>(entity));
+}
+
+TEST(CommandBufferTests, CommandsOnDeadEntitiesAreDropped)
+{
+    auto counter = std::make_shared<int>(0);
+    Core::World world;
+    const ECS::Entity stale = world.CreateEntity();
+    world.DestroyEntity(stale);
+    const ECS::Entity reused = world.CreateEntity();
+    ASSERT_EQ(stale.GetIndex(), reused.GetIndex());
+
+    ECS::CommandBuffer& commands = world.GetCommandBuffer();
+    commands.AddComponent<Counted>(stale, counter);
+    commands.AddComponent<Position>(reused, 1.0f);
+    commands.AddComponent<Counted>(reused, counter);
+    commands.DestroyEntity(reused);
+    EXPECT_EQ(counter.use_count(), 3);
+
+    world.FlushCommands();
+    EXPECT_EQ(counter.use_count(), 1);
+    EXPECT_FALSE(world.IsAlive(reused));
+}
+
+TEST(CommandBufferTests, UnplayedValuesAreDestroyed)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        Core::World world;
+        world.GetCommandBuffer().CreateEntity(Counted(counter), Name {"pending"});
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(CommandBufferTests, ThrowingConstructorsLeaveNoCommand)
+{
+    Core::World world;
+    ECS::CommandBuffer& buffer = world.GetCommandBuffer();
+    EXPECT_THROW(buffer.AddComponent<Throwing>(ECS::Entity {}, 1), std::runtime_error);
+    EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(CommandBufferTests, ArenaGrowsAndIsReused)
+{
+    Core::World world;
+    ECS::CommandBuffer& commands = world.GetCommandBuffer();
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        for (int i = 0; i < 10000; ++i)
+            commands.CreateEntity(Position {float(i)}, Wide {});
+        world.FlushCommands();
+    }
+    EXPECT_EQ(world.GetEntityCount(), 30000u);
+    world.Query<const Wide&>().ForEachChunk([](const auto& chunk)
+                                           {
+                                               EXPECT_EQ(reinterpret_cast<UIntPtr>(chunk.template Get<Wide>().data()) % 32, 0u);
+                                           });
+}
+
+TEST(CommandBufferTests, EveryThreadRecordsIntoItsOwnBuffer)
+{
+    Core::World world;
+    ECS::CommandBuffer* mainBuffer = &world.GetCommandBuffer();
+    ECS::CommandBuffer* otherBuffer = nullptr;
+    std::thread thread([&]()
+                       {
+                           otherBuffer = &world.GetCommandBuffer();
+                           otherBuffer->CreateEntity(Position {});
+                       });
+    thread.join();
+    EXPECT_NE(mainBuffer, otherBuffer);
+
+    world.FlushCommands();
+    EXPECT_EQ(world.GetEntityCount(), 1u);
+}
+
+TEST(CommandBufferTests, SystemsRecordAndStagesFlush)
+{
+    Async::JobSystem jobSystem(3);
+    Core::World world;
+    for (int i = 0; i < 20000; ++i)
+        world.CreateEntity(Position {float(i)});
+
+    // Every even position gets a velocity, seen by the system after the exclusive sync point
+    world.AddSystem<const Position&>("Tag", [&world](const auto& chunk)
+    {
+        ECS::CommandBuffer& commands = world.GetCommandBuffer();
+        auto positions = chunk.template Get<Position>();
+        auto entities = chunk.GetEntities();
+        for (Size i = 0; i < chunk.GetCount(); ++i)
+        {
+            if (static_cast<int>(positions[i].x) % 2 == 0)
+                commands.AddComponent<Velocity>(entities[i], 1.0f);
+        }
+    });
+    world.AddExclusiveSystem("Sync", [](Core::World&, F64) {});
+
+    std::atomic<Size> moving = 0;
+    world.AddSystem<const Velocity&>("Count", [&](const auto& chunk) { moving += chunk.GetCount(); });
+
+    world.RunSystems(0.0, &jobSystem);
+    EXPECT_EQ(moving.load(), 10000u);
+}
@@ -2,6 +2,8 @@
 #include <NGIN/Core/EventBus.hpp>
 #include <thread>
 #include <chrono>
+#include <array>
+#include <stdexcept>
 
 using namespace NGIN::Core;
 
@@ -16,6 +18,31 @@ struct AnotherTestEvent
     int value;
 };
 
+struct SummableTestEvent
+{
+    int value;
+
+    SummableTestEvent& operator+=(const SummableTestEvent& other)
+    {
+        value += other.value;
+        return *this;
+    }
+};
+
+template<typename EventType, CoalescePolicy Policy>
+concept CanSetCoalescePolicy = requires(EventBus& bus) { bus.SetCoalescePolicy<EventType, Policy>(); };
+
+// Sum needs operator+= and Custom needs a merge function, both rejected at compile time
+static_assert(CanSetCoalescePolicy<SummableTestEvent, CoalescePolicy::Sum>);
+static_assert(!CanSetCoalescePolicy<TestEvent, CoalescePolicy::Sum>);
+static_assert(!CanSetCoalescePolicy<TestEvent, CoalescePolicy::Custom>);
+static_assert(CanSetCoalescePolicy<TestEvent, CoalescePolicy::KeepLatest>);
+
+struct ConsumableTestEvent : NGIN::Core::Events::ConsumableEvent
+{
+    int value;
+};
+
 // Define a class to test member function subscriptions
 class DummyClass
 {
@@ -28,6 +55,13 @@ public:
     int receivedValue = 0;
 };
 
+static int freeFunctionSum = 0;
+
+static void FreeTestEventFunction(const TestEvent& event)
+{
+    freeFunctionSum += event.value;
+}
+
 // Define a static function for testing
 static void StaticTestEventFunction(const TestEvent& event, int& storage)
 {
@@ -169,6 +203,302 @@ TEST(EventBusTest, QueuedEvents)
 
 }
 
+TEST(EventBusTest, Unsubscribe)
+{
+    EventBus bus;
+    int sum = 0;
+
+    auto handle = bus.Subscribe<TestEvent>([&](const TestEvent& event)
+                                           {
+                                               sum += event.value;
+                                           });
+    ASSERT_TRUE(bus.IsSubscribed(handle));
+
+    bus.Publish(TestEvent {1});
+    ASSERT_TRUE(bus.Unsubscribe(handle));
+    ASSERT_FALSE(bus.IsSubscribed(handle));
+    bus.Publish(TestEvent {1});
+
+    ASSERT_EQ(sum, 1);
+}
+
+TEST(EventBusTest, StaleHandleIsRejected)
+{
+    EventBus bus;
+    int first = 0;
+    int second = 0;
+
+    auto handle = bus.Subscribe<TestEvent>([&](const TestEvent& event) { first += event.value; });
+    ASSERT_TRUE(bus.Unsubscribe(handle));
+
+    // The freed slot is reused by the next subscription with a new generation
+    auto newHandle = bus.Subscribe<TestEvent>([&](const TestEvent& event) { second += event.value; });
+    ASSERT_EQ(newHandle.index, handle.index);
+    ASSERT_FALSE(bus.Unsubscribe(handle));
+    ASSERT_TRUE(bus.IsSubscribed(newHandle));
+
+    bus.Publish(TestEvent {3});
+    ASSERT_EQ(first, 0);
+    ASSERT_EQ(second, 3);
+    ASSERT_FALSE(bus.Unsubscribe(SubscriptionHandle {}));
+}
+
+TEST(EventBusTest, UnsubscribePreservesOrderAfterCompaction)
+{
+    EventBus bus;
+    std::vector<int> order;
+    std::vector<SubscriptionHandle> handles;
+
+    for (int i = 0; i < 5; ++i)
+        handles.push_back(bus.Subscribe<TestEvent>([&order, i](const TestEvent&) { order.push_back(i); }));
+
+    bus.Unsubscribe(handles[1]);
+    bus.Unsubscribe(handles[3]);
+    bus.FlushEvents();
+
+    bus.Publish(TestEvent {0});
+    ASSERT_EQ(order, (std::vector<int> {0, 2, 4}));
+    ASSERT_TRUE(bus.IsSubscribed(handles[4]));
+    ASSERT_TRUE(bus.Unsubscribe(handles[4]));
+}
+
+TEST(EventBusTest, UnsubscribeDuringDispatch)
+{
+    EventBus bus;
+    int calls = 0;
+    SubscriptionHandle second;
+
+    bus.Subscribe<TestEvent>([&](const TestEvent&)
+                             {
+                                 ++calls;
+                                 bus.Unsubscribe(second);
+                             });
+    second = bus.Subscribe<TestEvent>([&](const TestEvent&) { ++calls; });
+
+    bus.Publish(TestEvent {0});
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(EventBusTest, SubscribeDuringDispatch)
+{
+    EventBus bus;
+    int lateCalls = 0;
+
+    bus.Subscribe<TestEvent>([&](const TestEvent&)
+                             {
+                                 if (lateCalls == 0)
+                                     bus.Subscribe<TestEvent>([&](const TestEvent&) { ++lateCalls; });
+                             });
+
+    // Listeners added during dispatch only see subsequent events
+    bus.Publish(TestEvent {0});
+    ASSERT_EQ(lateCalls, 0);
+    bus.Publish(TestEvent {0});
+    ASSERT_EQ(lateCalls, 1);
+}
+
+TEST(EventBusTest, ThrowingListenerEndsDispatch)
+{
+    EventBus bus;
+    bool shouldThrow = true;
+    bus.Subscribe<TestEvent>([&](const TestEvent&)
+                             {
+                                 if (shouldThrow)
+                                     throw std::runtime_error("listener");
+                             });
+    EXPECT_THROW(bus.Publish(TestEvent {0}), std::runtime_error);
+
+    // The dispatch is over, so new listeners are added right away
+    shouldThrow = false;
+    int calls = 0;
+    bus.Subscribe<TestEvent>([&](const TestEvent&) { ++calls; });
+    bus.Publish(TestEvent {0});
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(EventBusTest, QueuedEventSkipsUnsubscribedListener)
+{
+    EventBus bus;
+    int sum = 0;
+
+    auto handle = bus.Subscribe<TestEvent>([&](const TestEvent& event) { sum += event.value; });
+    bus.Publish(TestEvent {5}, EventMode::Queued);
+    bus.Unsubscribe(handle);
+    bus.FlushEvents();
+
+    ASSERT_EQ(sum, 0);
+}
+
+TEST(EventBusTest, PriorityOrder)
+{
+    EventBus bus;
+    std::vector<int> order;
+
+    bus.Subscribe<TestEvent>([&](const TestEvent&) { order.push_back(0); });
+    bus.Subscribe<TestEvent>([&](const TestEvent&) { order.push_back(10); }, 10);
+    bus.Subscribe<TestEvent>([&](const TestEvent&) { order.push_back(-5); }, -5);
+    bus.Subscribe<TestEvent>([&](const TestEvent&) { order.push_back(11); }, 10);
+    auto handle = bus.Subscribe<TestEvent>([&](const TestEvent&) { order.push_back(5); }, 5);
+
+    bus.Publish(TestEvent {0});
+    ASSERT_EQ(order, (std::vector<int> {10, 11, 5, 0, -5}));
+
+    // Handles stay valid after listeners were shifted by a higher priority insertion
+    order.clear();
+    ASSERT_TRUE(bus.Unsubscribe(handle));
+    bus.Publish(TestEvent {0});
+    ASSERT_EQ(order, (std::vector<int> {10, 11, 0, -5}));
+}
+
+TEST(EventBusTest, ConsumedEventStopsDispatch)
+{
+    EventBus bus;
+    int lowPriorityCalls = 0;
+
+    bus.Subscribe<ConsumableTestEvent>([&](const ConsumableTestEvent&) { ++lowPriorityCalls; });
+    bus.Subscribe<ConsumableTestEvent>([&](const ConsumableTestEvent& event)
+                                       {
+                                           if (event.value > 0)
+                                               event.Consume();
+                                       }, 100);
+
+    ConsumableTestEvent event;
+    event.value = 1;
+    bus.Publish(event);
+    ASSERT_EQ(lowPriorityCalls, 0);
+
+    event.value = 0;
+    bus.Publish(event);
+    ASSERT_EQ(lowPriorityCalls, 1);
+}
+
+TEST(EventBusTest, CoalesceKeepLatest)
+{
+    EventBus bus;
+    std::vector<int> received;
+
+    bus.SetCoalescePolicy<TestEvent, CoalescePolicy::KeepLatest>();
+    bus.Subscribe<TestEvent>([&](const TestEvent& event) { received.push_back(event.value); });
+
+    for (int i = 1; i <= 5; ++i)
+        bus.Publish(TestEvent {i}, EventMode::Queued);
+    bus.FlushEvents();
+    ASSERT_EQ(received, (std::vector<int> {5}));
+
+    // A new frame queues a new event
+    bus.Publish(TestEvent {7}, EventMode::Queued);
+    bus.FlushEvents();
+    ASSERT_EQ(received, (std::vector<int> {5, 7}));
+}
+
+TEST(EventBusTest, CoalesceSum)
+{
+    EventBus bus;
+    int received = 0;
+    int calls = 0;
+
+    bus.SetCoalescePolicy<SummableTestEvent, CoalescePolicy::Sum>();
+    bus.Subscribe<SummableTestEvent>([&](const SummableTestEvent& event)
+                                     {
+                                         received = event.value;
+                                         ++calls;
+                                     });
+
+    bus.Publish(SummableTestEvent {1}, EventMode::Queued);
+    bus.Publish(SummableTestEvent {2}, EventMode::Queued);
+    bus.Publish(SummableTestEvent {3}, EventMode::Queued);
+    bus.FlushEvents();
+
+    ASSERT_EQ(received, 6);
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(EventBusTest, CoalesceCustom)
+{
+    EventBus bus;
+    std::vector<int> received;
+
+    bus.SetCoalescePolicy<TestEvent>([](TestEvent& pending, const TestEvent& incoming)
+                                     {
+                                         pending.value = std::max(pending.value, incoming.value);
+                                     });
+    bus.Subscribe<TestEvent>([&](const TestEvent& event) { received.push_back(event.value); });
+
+    bus.Publish(TestEvent {3}, EventMode::Queued);
+    bus.Publish(TestEvent {9}, EventMode::Queued);
+    bus.Publish(TestEvent {4}, EventMode::Queued);
+    bus.FlushEvents();
+
+    ASSERT_EQ(received, (std::vector<int> {9}));
+}
+
+TEST(EventBusTest, CoalescedEventKeepsQueuePosition)
+{
+    EventBus bus;
+    std::vector<int> order;
+
+    bus.SetCoalescePolicy<TestEvent, CoalescePolicy::KeepLatest>();
+    bus.Subscribe<TestEvent>([&](const TestEvent& event) { order.push_back(event.value); });
+    bus.Subscribe<AnotherTestEvent>([&](const AnotherTestEvent& event) { order.push_back(event.value); });
+
+    bus.Publish(TestEvent {1}, EventMode::Queued);
+    bus.Publish(AnotherTestEvent {100}, EventMode::Queued);
+    bus.Publish(TestEvent {2}, EventMode::Queued);
+    bus.FlushEvents();
+    ASSERT_EQ(order, (std::vector<int> {2, 100}));
+
+    // Disabling coalescing delivers every event again
+    order.clear();
+    bus.SetCoalescePolicy<TestEvent, CoalescePolicy::None>();
+    bus.Publish(TestEvent {1}, EventMode::Queued);
+    bus.Publish(TestEvent {2}, EventMode::Queued);
+    bus.FlushEvents();
+    ASSERT_EQ(order, (std::vector<int> {1, 2}));
+}
+
+TEST(EventBusTest, ImmediateEventsAreNotCoalesced)
+{
+    EventBus bus;
+    int calls = 0;
+
+    bus.SetCoalescePolicy<TestEvent, CoalescePolicy::KeepLatest>();
+    bus.Subscribe<TestEvent>([&](const TestEvent&) { ++calls; });
+
+    bus.Publish(TestEvent {1});
+    bus.Publish(TestEvent {2});
+    ASSERT_EQ(calls, 2);
+}
+
+TEST(EventBusTest, FunctionPointer)
+{
+    EventBus bus;
+    freeFunctionSum = 0;
+
+    bus.Subscribe<TestEvent>(&FreeTestEventFunction);
+    bus.Publish(TestEvent {4});
+
+    ASSERT_EQ(freeFunctionSum, 4);
+}
+
+TEST(EventBusTest, LargeCaptureListener)
+{
+    EventBus bus;
+    std::array<int, 32> weights {};
+    weights.fill(2);
+    int observedValue = 0;
+
+    // Capture does not fit the inline buffer of the listener delegate
+    auto handle = bus.Subscribe<TestEvent>([weights, &observedValue](const TestEvent& event)
+                                           {
+                                               observedValue = event.value * weights[31];
+                                           });
+    bus.Subscribe<TestEvent>([](const TestEvent&) {}, 1);
+
+    bus.Publish(TestEvent {3});
+    ASSERT_EQ(observedValue, 6);
+    ASSERT_TRUE(bus.Unsubscribe(handle));
+}
+
 // Add more edge cases as necessary, like handling of invalid arguments, etc.
 
 
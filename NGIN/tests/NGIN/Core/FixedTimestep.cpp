@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/FixedTimestep.hpp>
+
+using namespace NGIN;
+
+TEST(FixedTimestepTests, DisabledRunsNoSteps)
+{
+    Core::FixedTimestep timestep;
+    EXPECT_FALSE(timestep.IsEnabled());
+    EXPECT_EQ(timestep.Advance(1.0), 0u);
+    EXPECT_EQ(timestep.GetAlpha(), 0.0);
+}
+
+TEST(FixedTimestepTests, AccumulatesPartialSteps)
+{
+    Core::FixedTimestep timestep(0.01);
+    EXPECT_EQ(timestep.Advance(0.004), 0u);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.4, 1e-9);
+
+    EXPECT_EQ(timestep.Advance(0.008), 1u);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.2, 1e-9);
+
+    EXPECT_EQ(timestep.Advance(0.025), 2u);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.7, 1e-9);
+}
+
+TEST(FixedTimestepTests, StepCountIsIndependentOfFrameRate)
+{
+    Core::FixedTimestep fast(1.0 / 64.0);
+    Core::FixedTimestep slow(1.0 / 64.0);
+
+    UInt32 fastSteps = 0;
+    for (int i = 0; i < 256; ++i)
+        fastSteps += fast.Advance(1.0 / 256.0);
+
+    UInt32 slowSteps = 0;
+    for (int i = 0; i < 32; ++i)
+        slowSteps += slow.Advance(1.0 / 32.0);
+
+    EXPECT_EQ(fastSteps, 64u);
+    EXPECT_EQ(slowSteps, 64u);
+}
+
+TEST(FixedTimestepTests, ClampsStepsAndDropsBacklog)
+{
+    Core::FixedTimestep timestep(0.01, 4);
+    EXPECT_EQ(timestep.Advance(1.0), 4u);
+    EXPECT_EQ(timestep.GetAlpha(), 0.0);
+    EXPECT_EQ(timestep.Advance(0.01), 1u);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/FramePacer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace NGIN;
+
+TEST(FramePacerTests, UnlimitedDoesNotWait)
+{
+    Core::FramePacer pacer;
+    pacer.Reset();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i)
+        pacer.WaitForNextFrame();
+    EXPECT_LT(std::chrono::duration<F64>(std::chrono::steady_clock::now() - start).count(), 0.05);
+}
+
+TEST(FramePacerTests, PreciseHoldsTargetFrameRate)
+{
+    Core::FramePacer pacer;
+    pacer.SetPacing(Core::FramePacing::Precise, 200.0);
+    pacer.Reset();
+
+    constexpr F64 period = 0.005;
+    F64 total = 0.0;
+    // How far the previous frame ended behind its deadline
+    F64 lateness = 0.0;
+    for (int i = 0; i < 20; ++i)
+    {
+        const F64 delta = pacer.WaitForNextFrame();
+        // Deadlines are spaced from the first frame, so a frame is only shorter than the period by as much
+        // as the previous one was late
+        if (lateness < period / 2.0)
+        {
+            EXPECT_GE(delta, period / 2.0);
+        }
+        lateness = std::max(0.0, lateness + delta - period);
+        // More than a whole period late restarts the schedule
+        if (lateness > period)
+            lateness = 0.0;
+        total += delta;
+    }
+    EXPECT_NEAR(total / 20.0, period, 0.002);
+}
+
+TEST(FramePacerTests, ThrottledSleepsUntilDeadline)
+{
+    Core::FramePacer pacer;
+    pacer.SetPacing(Core::FramePacing::Throttled, 100.0);
+    pacer.Reset();
+
+    for (int i = 0; i < 5; ++i)
+        EXPECT_GE(pacer.WaitForNextFrame(), 0.009);
+    EXPECT_EQ(pacer.GetPacing(), Core::FramePacing::Throttled);
+    EXPECT_EQ(pacer.GetTargetFrameRate(), 100.0);
+}
+
+TEST(FramePacerTests, LateFrameRestartsSchedule)
+{
+    Core::FramePacer pacer;
+    pacer.SetPacing(Core::FramePacing::Precise, 100.0);
+    pacer.Reset();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_GE(pacer.WaitForNextFrame(), 0.05);
+
+    // The missed frames are not rushed, the next one is a whole period later
+    EXPECT_GE(pacer.WaitForNextFrame(), 0.009);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/ModuleScheduler.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace NGIN;
+
+namespace
+{
+    struct Recorder
+    {
+        std::mutex mutex;
+        std::vector<int> order;
+
+        void Record(int id)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        }
+
+        int IndexOf(int id)
+        {
+            for (int i = 0; i < static_cast<int>(order.size()); ++i)
+                if (order[i] == id)
+                    return i;
+            return -1;
+        }
+    };
+
+    class RecordingModule : public Core::Module
+    {
+    public:
+        RecordingModule(Recorder& recorder, int id) : recorder(recorder), id(id) {}
+
+        std::thread::id tickThread;
+
+    protected:
+        void OnTick(const F64) override
+        {
+            tickThread = std::this_thread::get_id();
+            recorder.Record(id);
+        }
+
+    private:
+        Recorder& recorder;
+        int id;
+    };
+
+    class ThrowingModule : public Core::Module
+    {
+    protected:
+        void OnTick(const F64) override
+        {
+            throw std::runtime_error("Tick failed");
+        }
+    };
+}
+
+TEST(ModuleSchedulerTests, SerialRunsInRegistrationOrder)
+{
+    Recorder recorder;
+    RecordingModule a(recorder, 0), b(recorder, 1), c(recorder, 2);
+
+    Core::ModuleScheduler scheduler;
+    scheduler.AddModule(&a, {}, false);
+    scheduler.AddModule(&b, {}, false);
+    scheduler.AddModule(&c, {0}, false);
+    scheduler.RunPhase(Core::TickPhase::Tick, 0.0, nullptr);
+
+    EXPECT_EQ(recorder.order, (std::vector<int> {0, 1, 2}));
+}
+
+TEST(ModuleSchedulerTests, ParallelRespectsDependencies)
+{
+    Async::JobSystem jobSystem(4);
+    for (int iteration = 0; iteration < 50; ++iteration)
+    {
+        Recorder recorder;
+        std::vector<Scope<RecordingModule>> modules;
+        for (int i = 0; i < 6; ++i)
+            modules.push_back(CreateScope<RecordingModule>(recorder, i));
+
+        // 0 -> 2, 1 -> 2, 2 -> {3, 4}, 4 -> 5
+        Core::ModuleScheduler scheduler;
+        scheduler.AddModule(modules[0].get(), {}, false);
+        scheduler.AddModule(modules[1].get(), {}, false);
+        scheduler.AddModule(modules[2].get(), {0, 1}, false);
+        scheduler.AddModule(modules[3].get(), {2}, false);
+        scheduler.AddModule(modules[4].get(), {2}, false);
+        scheduler.AddModule(modules[5].get(), {4}, false);
+        scheduler.RunPhase(Core::TickPhase::Tick, 0.0, &jobSystem);
+
+        ASSERT_EQ(recorder.order.size(), 6u);
+        EXPECT_LT(recorder.IndexOf(0), recorder.IndexOf(2));
+        EXPECT_LT(recorder.IndexOf(1), recorder.IndexOf(2));
+        EXPECT_LT(recorder.IndexOf(2), recorder.IndexOf(3));
+        EXPECT_LT(recorder.IndexOf(2), recorder.IndexOf(4));
+        EXPECT_LT(recorder.IndexOf(4), recorder.IndexOf(5));
+    }
+}
+
+TEST(ModuleSchedulerTests, MainThreadOnlyRunsOnCaller)
+{
+    Async::JobSystem jobSystem(2);
+    Recorder recorder;
+    RecordingModule a(recorder, 0), b(recorder, 1), c(recorder, 2);
+
+    Core::ModuleScheduler scheduler;
+    scheduler.AddModule(&a, {}, false);
+    scheduler.AddModule(&b, {0}, true);
+    scheduler.AddModule(&c, {}, true);
+    scheduler.RunPhase(Core::TickPhase::Tick, 0.0, &jobSystem);
+
+    EXPECT_EQ(b.tickThread, std::this_thread::get_id());
+    EXPECT_EQ(c.tickThread, std::this_thread::get_id());
+    EXPECT_LT(recorder.IndexOf(0), recorder.IndexOf(1));
+}
+
+TEST(ModuleSchedulerTests, ExceptionIsRethrownAfterPhase)
+{
+    Async::JobSystem jobSystem(2);
+    Recorder recorder;
+    ThrowingModule throwing;
+    RecordingModule dependent(recorder, 1);
+
+    Core::ModuleScheduler scheduler;
+    scheduler.AddModule(&throwing, {}, false);
+    scheduler.AddModule(&dependent, {0}, false);
+    EXPECT_THROW(scheduler.RunPhase(Core::TickPhase::Tick, 0.0, &jobSystem), std::runtime_error);
+    EXPECT_EQ(recorder.order.size(), 1u);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/World.hpp>
+
+#include <algorithm>
+#include <type_traits>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct Frozen
+    {
+    };
+
+    struct Tag
+    {
+    };
+}
+
+TEST(QueryTests, SignatureIsComputedAtCompileTime)
+{
+    using Traits = ECS::QueryTraits<const Position&, Velocity&, ECS::Without<Frozen>, ECS::With<Tag>>;
+    static_assert(Traits::FETCHED_IDS.size() == 2);
+    static_assert(Traits::FETCHED_IDS[0] == ECS::ComponentID<Position>());
+    static_assert(Traits::REQUIRED_IDS.size() == 3);
+    static_assert(Traits::EXCLUDED_IDS.size() == 1 && Traits::EXCLUDED_IDS[0] == ECS::ComponentID<Frozen>());
+    static_assert(Traits::READ_IDS.size() == 1 && Traits::READ_IDS[0] == ECS::ComponentID<Position>());
+    static_assert(Traits::WRITE_IDS.size() == 1 && Traits::WRITE_IDS[0] == ECS::ComponentID<Velocity>());
+    static_assert(Traits::SIGNATURE_HASH != ECS::QueryTraits<const Position&, Velocity&, ECS::Without<Frozen>>::SIGNATURE_HASH);
+    static_assert(Traits::SIGNATURE_HASH == ECS::QueryTraits<Position&, const Velocity&, ECS::Without<Frozen>, ECS::With<Tag>>::SIGNATURE_HASH);
+    SUCCEED();
+}
+
+TEST(QueryTests, StatesTellApartSignaturesSharingAHash)
+{
+    using Traits = ECS::QueryTraits<const Position&, Velocity&, ECS::Without<Frozen>>;
+    using Other = ECS::QueryTraits<const Position&, Velocity&, ECS::Without<Tag>>;
+    const ECS::QueryState state(Traits::FETCHED_IDS, Traits::REQUIRED_IDS, Traits::EXCLUDED_IDS);
+    EXPECT_TRUE(state.HasSignature(Traits::FETCHED_IDS, Traits::REQUIRED_IDS, Traits::EXCLUDED_IDS,
+                                   Traits::CHANGED_IDS, Traits::ADDED_IDS));
+    EXPECT_FALSE(state.HasSignature(Other::FETCHED_IDS, Other::REQUIRED_IDS, Other::EXCLUDED_IDS,
+                                    Other::CHANGED_IDS, Other::ADDED_IDS));
+}
+
+TEST(QueryTests, ChunksYieldTypedSpans)
+{
+    Core::World world;
+    for (int i = 0; i < 3000; ++i)
+        world.CreateEntity(Position {float(i), 0.0f}, Velocity {1.0f, 2.0f});
+
+    Size rows = 0;
+    Size chunks = 0;
+    for (auto chunk: world.Query<const Position&, Velocity&>())
+    {
+        std::span<const Position> positions = chunk.Get<Position>();
+        std::span<Velocity> velocities = chunk.Get<1>();
+        static_assert(std::is_same_v<decltype(chunk.Get<0>()), std::span<const Position>>);
+        ASSERT_EQ(positions.size(), chunk.GetCount());
+        ASSERT_EQ(velocities.size(), chunk.GetCount());
+
+        for (Size i = 0; i < chunk.GetCount(); ++i)
+            velocities[i].x += positions[i].x;
+        rows += chunk.GetCount();
+        ++chunks;
+    }
+    EXPECT_EQ(rows, 3000u);
+    EXPECT_GT(chunks, 1u);
+
+    F64 sum = 0.0;
+    world.Query<const Velocity&>().ForEach([&](const Velocity& velocity) { sum += velocity.x; });
+    EXPECT_DOUBLE_EQ(sum, 3000.0 + 2999.0 * 3000.0 / 2.0);
+}
+
+TEST(QueryTests, FiltersIncludeAndExclude)
+{
+    Core::World world;
+    world.CreateEntity(Position {}, Velocity {});
+    world.CreateEntity(Position {}, Velocity {}, Frozen {});
+    world.CreateEntity(Position {}, Velocity {}, Tag {});
+    world.CreateEntity(Position {}, Velocity {}, Tag {}, Frozen {});
+    world.CreateEntity(Position {});
+
+    EXPECT_EQ(world.Query<const Position&>().GetEntityCount(), 5u);
+    EXPECT_EQ((world.Query<const Position&, Velocity&>().GetEntityCount()), 4u);
+    EXPECT_EQ((world.Query<const Position&, Velocity&, ECS::Without<Frozen>>().GetEntityCount()), 2u);
+    EXPECT_EQ((world.Query<Velocity&, ECS::With<Tag>, ECS::Without<Frozen>>().GetEntityCount()), 1u);
+    EXPECT_EQ((world.Query<ECS::With<Frozen>>().GetEntityCount()), 2u);
+}
+
+TEST(QueryTests, CachedMatchesPickUpNewArchetypes)
+{
+    Core::World world;
+    world.CreateEntity(Position {});
+    EXPECT_EQ(world.Query<Position&>().GetArchetypeCount(), 1u);
+
+    const ECS::Entity entity = world.CreateEntity(Position {}, Velocity {});
+    world.CreateEntity(Velocity {});
+    auto query = world.Query<Position&>();
+    EXPECT_EQ(query.GetArchetypeCount(), 2u);
+    EXPECT_EQ(query.GetEntityCount(), 2u);
+
+    // Emptied archetypes stay matched but yield no chunks
+    world.DestroyEntity(entity);
+    Size rows = 0;
+    for (auto chunk: world.Query<Position&>())
+        rows += chunk.GetCount();
+    EXPECT_EQ(rows, 1u);
+}
+
+TEST(QueryTests, ForEachPassesEntities)
+{
+    Core::World world;
+    std::vector<ECS::Entity> created;
+    for (int i = 0; i < 10; ++i)
+        created.push_back(world.CreateEntity(Position {float(i), 0.0f}));
+
+    std::vector<ECS::Entity> visited;
+    world.Query<const Position&>().ForEach([&](ECS::Entity entity, const Position& position)
+                                           {
+                                               EXPECT_FLOAT_EQ(position.x, float(entity.GetIndex()));
+                                               visited.push_back(entity);
+                                           });
+    std::sort(visited.begin(), visited.end(), [](ECS::Entity a, ECS::Entity b) { return a.value < b.value; });
+    EXPECT_EQ(visited, created);
+}
+
+TEST(QueryTests, EmptyWorldYieldsNothing)
+{
+    Core::World world;
+    auto query = world.Query<Position&>();
+    EXPECT_TRUE(query.begin() == query.end());
+}
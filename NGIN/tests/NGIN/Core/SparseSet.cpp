@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/World.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 0.0f;
+    };
+
+    struct Stunned
+    {
+        static constexpr ECS::ComponentStorage STORAGE = ECS::ComponentStorage::SparseSet;
+
+        int turns = 0;
+    };
+
+    struct Label
+    {
+        static constexpr ECS::ComponentStorage STORAGE = ECS::ComponentStorage::SparseSet;
+
+        std::string value;
+    };
+
+    struct Counted
+    {
+        static constexpr ECS::ComponentStorage STORAGE = ECS::ComponentStorage::SparseSet;
+
+        explicit Counted(std::shared_ptr<int> counter)
+                : counter(std::move(counter))
+        {}
+
+        std::shared_ptr<int> counter;
+    };
+
+    std::vector<ECS::Entity> Sorted(std::vector<ECS::Entity> entities)
+    {
+        std::sort(entities.begin(), entities.end(), [](ECS::Entity a, ECS::Entity b) { return a.value < b.value; });
+        return entities;
+    }
+}
+
+TEST(SparseSetTests, StorageIsDeclaredByTheComponent)
+{
+    EXPECT_EQ(ECS::COMPONENT_STORAGE<Position>, ECS::ComponentStorage::Table);
+    EXPECT_EQ(ECS::COMPONENT_STORAGE<Stunned>, ECS::ComponentStorage::SparseSet);
+    EXPECT_EQ(ECS::GetComponentInfo<Stunned>().storage, ECS::ComponentStorage::SparseSet);
+    EXPECT_THROW(ECS::SparseSet(ECS::GetComponentInfo<Position>()), std::invalid_argument);
+}
+
+TEST(SparseSetTests, AddingAndRemovingKeepsTheArchetype)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity(Position {1.0f});
+    const Size archetypeCount = world.GetArchetypeCount();
+
+    world.AddComponent<Stunned>(entity, 3);
+    EXPECT_TRUE(world.HasComponent<Stunned>(entity));
+    EXPECT_EQ(world.GetComponent<Stunned>(entity).turns, 3);
+    EXPECT_EQ(world.GetComponent<Position>(entity).x, 1.0f);
+
+    // Adding again replaces the value
+    world.AddComponent<Stunned>(entity, 5);
+    EXPECT_EQ(world.GetComponent<Stunned>(entity).turns, 5);
+    EXPECT_EQ(world.FindSparseSet(ECS::ComponentID<Stunned>())->GetCount(), 1u);
+
+    EXPECT_TRUE(world.RemoveComponent<Stunned>(entity));
+    EXPECT_FALSE(world.RemoveComponent<Stunned>(entity));
+    EXPECT_FALSE(world.HasComponent<Stunned>(entity));
+    EXPECT_EQ(world.GetArchetypeCount(), archetypeCount);
+    EXPECT_THROW((void) world.GetComponent<Stunned>(entity), std::out_of_range);
+    EXPECT_EQ(world.FindSparseSet(ECS::ComponentID<Position>()), nullptr);
+}
+
+TEST(SparseSetTests, RemovingMovesTheLastComponent)
+{
+    Core::World world;
+    std::vector<ECS::Entity> entities;
+    for (int i = 0; i < 100; ++i)
+    {
+        entities.push_back(world.CreateEntity());
+        world.AddComponent<Label>(entities.back(), std::to_string(i));
+    }
+    for (int i = 0; i < 100; i += 3)
+        EXPECT_TRUE(world.RemoveComponent<Label>(entities[i]));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i % 3 == 0)
+            EXPECT_FALSE(world.HasComponent<Label>(entities[i]));
+        else
+            EXPECT_EQ(world.GetComponent<Label>(entities[i]).value, std::to_string(i));
+    }
+}
+
+TEST(SparseSetTests, PagesCoverHighEntityIndices)
+{
+    ECS::SparseSet set(ECS::GetComponentInfo<Stunned>());
+    const ECS::Entity low = ECS::Entity::FromParts(1, 0);
+    const ECS::Entity high = ECS::Entity::FromParts(10 * ECS::SparseSet::PAGE_SIZE + 7, 2);
+    ::new(set.Emplace(high)) Stunned {2};
+    ::new(set.Emplace(low)) Stunned {1};
+
+    EXPECT_EQ(reinterpret_cast<Stunned*>(set.TryGet(high))->turns, 2);
+    EXPECT_EQ(reinterpret_cast<Stunned*>(set.TryGet(low))->turns, 1);
+    EXPECT_FALSE(set.Contains(ECS::Entity::FromParts(10 * ECS::SparseSet::PAGE_SIZE + 7, 1)));
+    EXPECT_FALSE(set.Contains(ECS::Entity::FromParts(5 * ECS::SparseSet::PAGE_SIZE, 0)));
+    EXPECT_THROW(set.Emplace(high), std::invalid_argument);
+
+    // A newer generation of the same slot replaces the stale component
+    const ECS::Entity reused = ECS::Entity::FromParts(1, 1);
+    ::new(set.Emplace(reused)) Stunned {4};
+    EXPECT_FALSE(set.Contains(low));
+    EXPECT_EQ(reinterpret_cast<Stunned*>(set.TryGet(reused))->turns, 4);
+    EXPECT_EQ(set.GetCount(), 2u);
+}
+
+TEST(SparseSetTests, DestroyingReleasesComponents)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        Core::World world;
+        const ECS::Entity a = world.CreateEntity(Position {}, Counted(counter));
+        const ECS::Entity b = world.CreateEntity(Counted(counter));
+        EXPECT_EQ(counter.use_count(), 3);
+
+        world.DestroyEntity(a);
+        EXPECT_EQ(counter.use_count(), 2);
+        EXPECT_FALSE(world.FindSparseSet(ECS::ComponentID<Counted>())->Contains(a));
+
+        // The recycled slot does not inherit the component
+        const ECS::Entity recycled = world.CreateEntity(Position {});
+        EXPECT_EQ(recycled.GetIndex(), a.GetIndex());
+        EXPECT_FALSE(world.HasComponent<Counted>(recycled));
+        EXPECT_TRUE(world.HasComponent<Counted>(b));
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(SparseSetTests, QueriesJoinTablesAndSparseSets)
+{
+    // Few stunned entities drive the join from the set, many from the chunks
+    for (const UInt32 stunnedEvery: {50u, 1u})
+    {
+        Core::World world;
+        std::mt19937 random(stunnedEvery);
+        std::vector<ECS::Entity> entities;
+        for (UInt32 i = 0; i < 2000; ++i)
+        {
+            const ECS::Entity entity = i % 4 == 0 ? world.CreateEntity(Position {static_cast<float>(i)})
+                                                  : world.CreateEntity(Position {static_cast<float>(i)}, Velocity {1.0f});
+            if (random() % stunnedEvery == 0)
+                world.AddComponent<Stunned>(entity, static_cast<int>(i));
+            if (i % 3 == 0)
+                world.AddComponent<Label>(entity, "x");
+            entities.push_back(entity);
+        }
+
+        std::vector<ECS::Entity> expected;
+        std::vector<ECS::Entity> expectedUnlabeled;
+        for (ECS::Entity entity: entities)
+        {
+            if (!world.HasComponent<Velocity>(entity) || !world.HasComponent<Stunned>(entity))
+                continue;
+            expected.push_back(entity);
+            if (!world.HasComponent<Label>(entity))
+                expectedUnlabeled.push_back(entity);
+        }
+
+        std::vector<ECS::Entity> found;
+        world.Query<Position&, const Stunned&, const Velocity&>().ForEach(
+                [&](ECS::Entity entity, Position& position, const Stunned& stunned, const Velocity&)
+                {
+                    EXPECT_EQ(static_cast<int>(position.x), stunned.turns);
+                    position.x += 1.0f;
+                    found.push_back(entity);
+                });
+        EXPECT_EQ(Sorted(found), Sorted(expected));
+        EXPECT_EQ((world.Query<const Velocity&, ECS::With<Stunned>>().GetEntityCount()), expected.size());
+
+        found.clear();
+        world.Query<ECS::With<Velocity>, Stunned&, ECS::Without<Label>>().ForEach(
+                [&](ECS::Entity entity, Stunned&) { found.push_back(entity); });
+        EXPECT_EQ(Sorted(found), Sorted(expectedUnlabeled));
+
+        // The writes went through to the table
+        for (ECS::Entity entity: expected)
+            EXPECT_EQ(static_cast<int>(world.GetComponent<Position>(entity).x), world.GetComponent<Stunned>(entity).turns + 1);
+    }
+}
+
+TEST(SparseSetTests, QueriesOnMissingSetsMatchNothingOrEverything)
+{
+    Core::World world;
+    world.CreateEntity(Position {});
+    world.CreateEntity(Position {}, Velocity {});
+
+    Size visited = 0;
+    world.Query<const Position&, const Stunned&>().ForEach([&](const Position&, const Stunned&) { ++visited; });
+    EXPECT_EQ(visited, 0u);
+    EXPECT_EQ((world.Query<const Position&, ECS::Without<Stunned>>().GetEntityCount()), 2u);
+}
+
+TEST(SparseSetTests, CommandBuffersApplySparseChanges)
+{
+    Core::World world;
+    const ECS::Entity a = world.CreateEntity(Position {});
+    const ECS::Entity b = world.CreateEntity(Position {});
+    world.AddComponent<Stunned>(b, 1);
+    const Size archetypeCount = world.GetArchetypeCount();
+
+    ECS::CommandBuffer& commands = world.GetCommandBuffer();
+    commands.AddComponent<Stunned>(a, 2);
+    commands.AddComponent<Velocity>(a, 1.0f);
+    commands.AddComponent<Stunned>(b, 3);
+    commands.AddComponent<Label>(b, "dropped");
+    commands.RemoveComponent<Label>(b);
+    commands.CreateEntity(Position {4.0f}, Stunned {4});
+    world.FlushCommands();
+
+    EXPECT_EQ(world.GetComponent<Stunned>(a).turns, 2);
+    EXPECT_TRUE(world.HasComponent<Velocity>(a));
+    EXPECT_EQ(world.GetComponent<Stunned>(b).turns, 3);
+    EXPECT_FALSE(world.HasComponent<Label>(b));
+
+    Size created = 0;
+    world.Query<const Position&, const Stunned&>().ForEach([&](const Position& position, const Stunned& stunned)
+                                                           {
+                                                               if (position.x == 4.0f)
+                                                               {
+                                                                   EXPECT_EQ(stunned.turns, 4);
+                                                                   ++created;
+                                                               }
+                                                           });
+    EXPECT_EQ(created, 1u);
+    // Only the Velocity add created an archetype
+    EXPECT_EQ(world.GetArchetypeCount(), archetypeCount + 1);
+
+    commands.RemoveComponent<Stunned>(a);
+    commands.AddComponent<Stunned>(b, 5);
+    commands.RemoveComponent<Stunned>(b);
+    commands.AddComponent<Stunned>(b, 6);
+    world.FlushCommands();
+    EXPECT_FALSE(world.HasComponent<Stunned>(a));
+    EXPECT_EQ(world.GetComponent<Stunned>(b).turns, 6);
+}
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/World.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    struct Sphere
+    {
+        ECS::Entity entity;
+        glm::vec3 center;
+        F32 radius;
+    };
+
+    const std::array<Core::SpatialIndexSettings, 2> KINDS = {
+            Core::SpatialIndexSettings {.kind = Core::SpatialIndexKind::HashGrid, .cellSize = 4.0f},
+            Core::SpatialIndexSettings {.kind = Core::SpatialIndexKind::LooseOctree, .octreeHalfSize = 64.0f, .octreeMaxDepth = 6},
+    };
+
+    F32 DistanceSquared(glm::vec3 a, glm::vec3 b)
+    {
+        const glm::vec3 d = a - b;
+        return d.x * d.x + d.y * d.y + d.z * d.z;
+    }
+
+    std::vector<ECS::Entity> Sorted(std::span<const ECS::Entity> entities)
+    {
+        std::vector<ECS::Entity> sorted(entities.begin(), entities.end());
+        std::sort(sorted.begin(), sorted.end(), [](ECS::Entity a, ECS::Entity b) { return a.value < b.value; });
+        return sorted;
+    }
+
+    // Spheres of mixed sizes, some centered outside the octree root
+    std::vector<Sphere> MakeSpheres(std::mt19937& random, UInt32 count)
+    {
+        std::uniform_real_distribution<F32> position(-80.0f, 80.0f);
+        std::uniform_real_distribution<F32> size(0.0f, 1.0f);
+        std::vector<Sphere> spheres;
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            const F32 s = size(random);
+            spheres.push_back({ECS::Entity::FromParts(i, 0), {position(random), position(random), position(random)},
+                               s < 0.05f ? s * 200.0f : s * 3.0f});
+        }
+        return spheres;
+    }
+
+    void ExpectMatchesBruteForce(const Core::SpatialIndex& index, const std::vector<Sphere>& spheres, std::mt19937& random)
+    {
+        std::uniform_real_distribution<F32> position(-90.0f, 90.0f);
+        std::uniform_real_distribution<F32> size(0.0f, 20.0f);
+
+        std::vector<Core::SpatialSphere> radiusQueries;
+        std::vector<Core::SpatialBox> boxQueries;
+        std::vector<glm::vec3> points;
+        for (UInt32 i = 0; i < 32; ++i)
+        {
+            const glm::vec3 center(position(random), position(random), position(random));
+            radiusQueries.push_back({center, size(random)});
+            boxQueries.push_back({center, center + glm::vec3(size(random), size(random), size(random))});
+            points.push_back(center);
+        }
+
+        Core::SpatialQueryResults results;
+        index.QueryRadius(radiusQueries, results);
+        ASSERT_EQ(results.GetQueryCount(), radiusQueries.size());
+        for (Size q = 0; q < radiusQueries.size(); ++q)
+        {
+            std::vector<ECS::Entity> expected;
+            for (const Sphere& sphere: spheres)
+            {
+                const F32 reach = sphere.radius + radiusQueries[q].radius;
+                if (DistanceSquared(sphere.center, radiusQueries[q].center) <= reach * reach)
+                    expected.push_back(sphere.entity);
+            }
+            EXPECT_EQ(Sorted(results.Get(q)), Sorted(expected));
+        }
+
+        index.QueryBox(boxQueries, results);
+        ASSERT_EQ(results.GetQueryCount(), boxQueries.size());
+        for (Size q = 0; q < boxQueries.size(); ++q)
+        {
+            std::vector<ECS::Entity> expected;
+            for (const Sphere& sphere: spheres)
+            {
+                const glm::vec3 closest(std::clamp(sphere.center.x, boxQueries[q].min.x, boxQueries[q].max.x),
+                                        std::clamp(sphere.center.y, boxQueries[q].min.y, boxQueries[q].max.y),
+                                        std::clamp(sphere.center.z, boxQueries[q].min.z, boxQueries[q].max.z));
+                if (DistanceSquared(sphere.center, closest) <= sphere.radius * sphere.radius)
+                    expected.push_back(sphere.entity);
+            }
+            EXPECT_EQ(Sorted(results.Get(q)), Sorted(expected));
+        }
+
+        for (const F32 maxDistance: {std::numeric_limits<F32>::infinity(), 10.0f})
+        {
+            std::vector<ECS::Entity> nearest(points.size());
+            index.FindNearest(points, maxDistance, nearest);
+            for (Size q = 0; q < points.size(); ++q)
+            {
+                F32 best = maxDistance * maxDistance;
+                Bool found = false;
+                for (const Sphere& sphere: spheres)
+                {
+                    const F32 distanceSquared = DistanceSquared(sphere.center, points[q]);
+                    if (distanceSquared <= best)
+                    {
+                        best = distanceSquared;
+                        found = true;
+                    }
+                }
+                ASSERT_EQ(nearest[q].IsValid(), found);
+                if (found)
+                {
+                    const auto it = std::find_if(spheres.begin(), spheres.end(),
+                                                 [&](const Sphere& sphere) { return sphere.entity == nearest[q]; });
+                    ASSERT_NE(it, spheres.end());
+                    EXPECT_FLOAT_EQ(DistanceSquared(it->center, points[q]), best);
+                }
+            }
+        }
+    }
+}
+
+TEST(SpatialIndexTests, QueriesMatchBruteForce)
+{
+    for (const Core::SpatialIndexSettings& settings: KINDS)
+    {
+        std::mt19937 random(42);
+        const Scope<Core::SpatialIndex> index = Core::CreateSpatialIndex(settings);
+        const std::vector<Sphere> spheres = MakeSpheres(random, 2000);
+        for (const Sphere& sphere: spheres)
+            index->Set(sphere.entity, sphere.center, sphere.radius);
+        EXPECT_EQ(index->GetCount(), spheres.size());
+
+        ExpectMatchesBruteForce(*index, spheres, random);
+    }
+}
+
+TEST(SpatialIndexTests, MovingAndRemovingKeepsQueriesExact)
+{
+    for (const Core::SpatialIndexSettings& settings: KINDS)
+    {
+        std::mt19937 random(7);
+        const Scope<Core::SpatialIndex> index = Core::CreateSpatialIndex(settings);
+        std::vector<Sphere> spheres = MakeSpheres(random, 1500);
+        for (const Sphere& sphere: spheres)
+            index->Set(sphere.entity, sphere.center, sphere.radius);
+
+        // Move a third by small and large steps, shrink or grow some, then remove every fifth
+        std::uniform_real_distribution<F32> step(-30.0f, 30.0f);
+        for (Size i = 0; i < spheres.size(); i += 3)
+        {
+            spheres[i].center = spheres[i].center + glm::vec3(step(random), step(random), step(random)) * (i % 2 ? 0.05f : 1.0f);
+            spheres[i].radius = i % 4 == 0 ? spheres[i].radius * 0.25f : spheres[i].radius + 1.0f;
+            index->Set(spheres[i].entity, spheres[i].center, spheres[i].radius);
+        }
+        for (Size i = spheres.size(); i-- > 0;)
+        {
+            if (i % 5 == 0)
+            {
+                EXPECT_TRUE(index->Remove(spheres[i].entity));
+                EXPECT_FALSE(index->Remove(spheres[i].entity));
+                EXPECT_FALSE(index->Contains(spheres[i].entity));
+                spheres.erase(spheres.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+        }
+        EXPECT_EQ(index->GetCount(), spheres.size());
+
+        ExpectMatchesBruteForce(*index, spheres, random);
+    }
+}
+
+TEST(SpatialIndexTests, StaleHandlesAreReplaced)
+{
+    for (const Core::SpatialIndexSettings& settings: KINDS)
+    {
+        const Scope<Core::SpatialIndex> index = Core::CreateSpatialIndex(settings);
+        const ECS::Entity old = ECS::Entity::FromParts(3, 0);
+        const ECS::Entity reused = ECS::Entity::FromParts(3, 1);
+        index->Set(old, glm::vec3(1.0f), 0.5f);
+        index->Set(reused, glm::vec3(-1.0f), 0.5f);
+
+        EXPECT_FALSE(index->Contains(old));
+        EXPECT_TRUE(index->Contains(reused));
+        EXPECT_EQ(index->GetCount(), 1u);
+        EXPECT_EQ(index->FindNearest(glm::vec3(1.0f)), reused);
+        EXPECT_FALSE(index->FindNearest(glm::vec3(1.0f), 1.0f).IsValid());
+        EXPECT_THROW(index->Set({}, glm::vec3(0.0f), 0.0f), std::invalid_argument);
+    }
+}
+
+TEST(SpatialIndexTests, InvalidSettingsThrow)
+{
+    EXPECT_THROW((void) Core::CreateSpatialIndex({.kind = Core::SpatialIndexKind::HashGrid, .cellSize = 0.0f}), std::invalid_argument);
+    EXPECT_THROW((void) Core::CreateSpatialIndex({.kind = Core::SpatialIndexKind::LooseOctree, .octreeHalfSize = -1.0f}), std::invalid_argument);
+}
+
+TEST(SpatialIndexTests, WorldIndexesTransformsIncrementally)
+{
+    for (const Core::SpatialIndexSettings& settings: KINDS)
+    {
+        Core::World world(settings);
+        const ECS::Entity parent = world.CreateEntity();
+        const ECS::Entity child = world.CreateEntity(Core::SpatialBounds {1.0f});
+        const ECS::Entity unplaced = world.CreateEntity(Core::SpatialBounds {1.0f});
+        Core::Transform local;
+        local.position = glm::vec3(10.0f, 0.0f, 0.0f);
+        world.GetTransforms().Add(parent, local);
+        local.position = glm::vec3(0.0f, 5.0f, 0.0f);
+        local.scale = glm::vec3(1.0f, 3.0f, 1.0f);
+        world.GetTransforms().Add(child, local, parent);
+        world.RunSystems(0.0);
+
+        const Core::SpatialIndex& index = world.GetSpatialIndex();
+        EXPECT_EQ(index.GetCount(), 2u);
+        EXPECT_FALSE(index.Contains(unplaced));
+        EXPECT_EQ(index.FindNearest(glm::vec3(10.0f, 4.0f, 0.0f)), child);
+
+        // The child's radius is scaled by its largest axis scale
+        std::vector<ECS::Entity> found;
+        index.QueryRadius(glm::vec3(10.0f, 7.5f, 0.0f), 0.0f, found);
+        EXPECT_EQ(found, std::vector<ECS::Entity> {child});
+
+        // Moving the parent moves the child
+        Core::Transform moved = world.GetTransforms().GetLocal(parent);
+        moved.position = glm::vec3(-10.0f, 0.0f, 0.0f);
+        world.GetTransforms().SetLocal(parent, moved);
+        world.UpdateTransforms();
+        EXPECT_EQ(index.FindNearest(glm::vec3(-10.0f, 5.0f, 0.0f)), child);
+
+        // Changed bounds are reindexed without a transform change
+        world.GetComponent<Core::SpatialBounds>(child).radius = 0.0f;
+        world.UpdateTransforms();
+        found.clear();
+        index.QueryRadius(glm::vec3(-10.0f, 7.5f, 0.0f), 0.0f, found);
+        EXPECT_TRUE(found.empty());
+
+        world.DestroyEntity(child);
+        EXPECT_FALSE(index.Contains(child));
+        world.GetTransforms().Remove(parent);
+        world.UpdateTransforms();
+        EXPECT_EQ(index.GetCount(), 0u);
+    }
+}
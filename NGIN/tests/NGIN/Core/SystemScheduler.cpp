@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/World.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 1.0f;
+    };
+
+    struct Health
+    {
+        int value = 100;
+    };
+
+    struct Recorder
+    {
+        std::mutex mutex;
+        std::vector<int> order;
+
+        void Record(int id)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (order.empty() || order.back() != id)
+                order.push_back(id);
+        }
+
+        int IndexOf(int id)
+        {
+            for (int i = 0; i < static_cast<int>(order.size()); ++i)
+                if (order[i] == id)
+                    return i;
+            return -1;
+        }
+    };
+}
+
+TEST(SystemSchedulerTests, AccessConflicts)
+{
+    const ECS::SystemAccess readPosition = {{ECS::ComponentID<Position>()}, {}, false};
+    const ECS::SystemAccess readPosition2 = {{ECS::ComponentID<Position>()}, {ECS::ComponentID<Health>()}, false};
+    const ECS::SystemAccess writePosition = {{}, {ECS::ComponentID<Position>()}, false};
+    const ECS::SystemAccess writeVelocity = {{}, {ECS::ComponentID<Velocity>()}, false};
+    const ECS::SystemAccess exclusive = {{}, {}, true};
+
+    EXPECT_FALSE(readPosition.ConflictsWith(readPosition2));
+    EXPECT_TRUE(readPosition.ConflictsWith(writePosition));
+    EXPECT_TRUE(writePosition.ConflictsWith(readPosition));
+    EXPECT_TRUE(writePosition.ConflictsWith(writePosition));
+    EXPECT_FALSE(writePosition.ConflictsWith(writeVelocity));
+    EXPECT_TRUE(exclusive.ConflictsWith(readPosition));
+}
+
+TEST(SystemSchedulerTests, DependenciesFollowQuerySignatures)
+{
+    Core::World world;
+    const UInt32 integrate = world.AddSystem<Position&, const Velocity&>("Integrate", [](const auto&) {});
+    const UInt32 damp = world.AddSystem<Velocity&>("Damp", [](const auto&) {});
+    const UInt32 heal = world.AddSystem<Health&>("Heal", [](const auto&) {});
+    const UInt32 render = world.AddSystem<const Position&, const Health&>("Render", [](const auto&) {});
+    const UInt32 spawn = world.AddExclusiveSystem("Spawn", [](Core::World&, F64) {});
+    const UInt32 move = world.AddSystem<Position&>("Move", [](const auto&) {});
+
+    const ECS::SystemScheduler& scheduler = world.GetSystemScheduler();
+    EXPECT_EQ(scheduler.GetSystemCount(), 6u);
+    EXPECT_EQ(scheduler.GetSystem(damp).GetName(), "Damp");
+    EXPECT_TRUE(scheduler.GetDependencies(integrate).empty());
+    EXPECT_EQ(scheduler.GetDependencies(damp), std::vector<UInt32>({integrate}));
+    EXPECT_TRUE(scheduler.GetDependencies(heal).empty());
+    EXPECT_EQ(scheduler.GetDependencies(render), std::vector<UInt32>({integrate, heal}));
+    // Exclusive systems split stages, dependencies never cross them
+    EXPECT_TRUE(scheduler.GetDependencies(spawn).empty());
+    EXPECT_TRUE(scheduler.GetDependencies(move).empty());
+    EXPECT_EQ(scheduler.GetStageCount(), 3u);
+}
+
+TEST(SystemSchedulerTests, ConflictingSystemsKeepRegistrationOrder)
+{
+    Async::JobSystem jobSystem(3);
+    Core::World world;
+    for (int i = 0; i < 20000; ++i)
+        world.CreateEntity(Position {}, Velocity {}, Health {});
+
+    Recorder recorder;
+    world.AddSystem<Velocity&>("Accelerate", [&](const auto& chunk)
+    {
+        recorder.Record(0);
+        for (Velocity& velocity: chunk.template Get<Velocity>())
+            velocity.x += 1.0f;
+    });
+    world.AddSystem<Health&>("Heal", [&](const auto& chunk)
+    {
+        for (Health& health: chunk.template Get<Health>())
+            health.value += 1;
+    });
+    world.AddSystem<Position&, const Velocity&>("Integrate", [&](const auto& chunk, F64 deltaTime)
+    {
+        recorder.Record(1);
+        auto positions = chunk.template Get<Position>();
+        auto velocities = chunk.template Get<Velocity>();
+        for (Size i = 0; i < chunk.GetCount(); ++i)
+            positions[i].x += velocities[i].x * static_cast<float>(deltaTime);
+    });
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        recorder.order.clear();
+        world.RunSystems(0.5, &jobSystem);
+        EXPECT_LT(recorder.IndexOf(0), recorder.IndexOf(1));
+        EXPECT_EQ(recorder.order.size(), 2u);
+    }
+
+    // Velocity reaches 2..11 over the frames, each integrated with a step of 0.5
+    world.Query<const Position&, const Health&>().ForEach([](const Position& position, const Health& health)
+                                                          {
+                                                              ASSERT_FLOAT_EQ(position.x, 32.5f);
+                                                              ASSERT_EQ(health.value, 110);
+                                                          });
+}
+
+TEST(SystemSchedulerTests, ChunksOfOneSystemRunConcurrently)
+{
+    Async::JobSystem jobSystem(3);
+    Core::World world;
+    for (int i = 0; i < 100000; ++i)
+        world.CreateEntity(Position {float(i)});
+
+    std::atomic<Size> rows = 0;
+    std::atomic<Size> calls = 0;
+    world.AddSystem<const Position&>("Count", [&](const auto& chunk)
+    {
+        rows += chunk.GetCount();
+        ++calls;
+    });
+    world.RunSystems(0.0, &jobSystem);
+
+    EXPECT_EQ(rows.load(), 100000u);
+    EXPECT_GT(calls.load(), 1u);
+}
+
+TEST(SystemSchedulerTests, ExclusiveSystemsMakeStructuralChanges)
+{
+    Async::JobSystem jobSystem(2);
+    Core::World world;
+    world.CreateEntity(Position {});
+
+    std::atomic<int> moved = 0;
+    world.AddExclusiveSystem("Spawn", [](Core::World& world, F64)
+    {
+        for (int i = 0; i < 1000; ++i)
+            world.CreateEntity(Position {}, Velocity {});
+    });
+    world.AddSystem<const Velocity&>("Observe", [&](const auto& chunk) { moved += static_cast<int>(chunk.GetCount()); });
+
+    world.RunSystems(0.0, &jobSystem);
+    EXPECT_EQ(moved.load(), 1000);
+    world.RunSystems(0.0, nullptr);
+    EXPECT_EQ(moved.load(), 3000);
+}
+
+TEST(SystemSchedulerTests, ExceptionsAreRethrownAfterTheStage)
+{
+    Async::JobSystem jobSystem(2);
+    Core::World world;
+    for (int i = 0; i < 10000; ++i)
+        world.CreateEntity(Position {}, Velocity {});
+
+    std::atomic<Bool> dependentRan = false;
+    world.AddSystem<Position&>("Fail", [](const auto&) { throw std::runtime_error("System failed"); });
+    world.AddSystem<const Position&>("After", [&](const auto&) { dependentRan = true; });
+
+    EXPECT_THROW(world.RunSystems(0.0, &jobSystem), std::runtime_error);
+    EXPECT_TRUE(dependentRan.load());
+    EXPECT_THROW(world.RunSystems(0.0, nullptr), std::runtime_error);
+}
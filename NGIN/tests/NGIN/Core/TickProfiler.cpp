@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/TickProfiler.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace NGIN;
+
+namespace
+{
+    class SleepingModule : public Core::Module
+    {
+    protected:
+        void OnTick(const F64) override
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    };
+
+    class IdleModule : public Core::Module
+    {
+    };
+}
+
+TEST(TickProfilerTests, EmptyStats)
+{
+    Core::TickProfiler profiler;
+    profiler.AddModule("Module");
+
+    const Core::TickStats stats = profiler.GetStats(0, Core::TickPhase::Tick);
+    EXPECT_EQ(stats.sampleCount, 0u);
+    EXPECT_EQ(stats.max, 0.0);
+    EXPECT_THROW((void) profiler.GetStats(1, Core::TickPhase::Tick), std::out_of_range);
+}
+
+TEST(TickProfilerTests, Percentiles)
+{
+    Core::TickProfiler profiler(100);
+    profiler.AddModule("Module");
+
+    // 1 ms to 100 ms, shuffled so the window order does not matter
+    for (int i = 0; i < 100; ++i)
+        profiler.Record(0, Core::TickPhase::Tick, ((i * 37) % 100 + 1) * 1e-3);
+
+    const Core::TickStats stats = profiler.GetStats(0, Core::TickPhase::Tick);
+    EXPECT_EQ(stats.sampleCount, 100u);
+    EXPECT_NEAR(stats.p50, 0.050, 1e-6);
+    EXPECT_NEAR(stats.p99, 0.099, 1e-6);
+    EXPECT_NEAR(stats.max, 0.100, 1e-6);
+    EXPECT_NEAR(stats.mean, 0.0505, 1e-6);
+    EXPECT_EQ(profiler.GetStats(0, Core::TickPhase::PreTick).sampleCount, 0u);
+}
+
+TEST(TickProfilerTests, WindowKeepsRecentSamples)
+{
+    Core::TickProfiler profiler(4);
+    profiler.AddModule("Module");
+
+    profiler.Record(0, Core::TickPhase::Tick, 1.0);
+    for (int i = 0; i < 4; ++i)
+        profiler.Record(0, Core::TickPhase::Tick, 0.001);
+
+    const Core::TickStats stats = profiler.GetStats(0, Core::TickPhase::Tick);
+    EXPECT_EQ(stats.sampleCount, 4u);
+    EXPECT_NEAR(stats.max, 0.001, 1e-9);
+
+    profiler.Clear();
+    EXPECT_EQ(profiler.GetStats(0, Core::TickPhase::Tick).sampleCount, 0u);
+}
+
+TEST(TickProfilerTests, SchedulerRecordsModulePhases)
+{
+    SleepingModule sleeping;
+    IdleModule idle;
+
+    Core::ModuleScheduler scheduler;
+    Core::TickProfiler profiler;
+    scheduler.AddModule(&sleeping, {}, false);
+    profiler.AddModule("Sleeping");
+    scheduler.AddModule(&idle, {}, false);
+    profiler.AddModule("Idle");
+    scheduler.SetProfiler(&profiler);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        scheduler.RunPhase(Core::TickPhase::PreTick, 0.0, nullptr);
+        scheduler.RunPhase(Core::TickPhase::Tick, 0.0, nullptr);
+    }
+
+    const Core::TickStats sleepingTick = profiler.GetStats(0, Core::TickPhase::Tick);
+    EXPECT_EQ(sleepingTick.sampleCount, 3u);
+    EXPECT_GE(sleepingTick.p50, 0.002);
+    EXPECT_EQ(profiler.GetStats(1, Core::TickPhase::PreTick).sampleCount, 3u);
+    EXPECT_EQ(profiler.GetStats(1, Core::TickPhase::PostTick).sampleCount, 0u);
+
+    scheduler.SetProfiler(nullptr);
+    scheduler.RunPhase(Core::TickPhase::Tick, 0.0, nullptr);
+    EXPECT_EQ(profiler.GetStats(0, Core::TickPhase::Tick).sampleCount, 3u);
+}
+
+TEST(TickProfilerTests, Reports)
+{
+    Core::TickProfiler profiler;
+    profiler.AddModule("Game::\"Physics\"");
+    profiler.Record(0, Core::TickPhase::Tick, 0.004);
+    profiler.RecordFrame(0.016);
+
+    const String text = profiler.ToString();
+    EXPECT_NE(text.find("Frame: p50 16.000 ms"), String::npos);
+    EXPECT_NE(text.find("Tick: p50 4.000 ms"), String::npos);
+    EXPECT_EQ(text.find("PreTick"), String::npos);
+
+    const String json = profiler.ToJSON();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find(R"("Game::\"Physics\"":{"FixedTick":)"), String::npos);
+    EXPECT_NE(json.find(R"("Tick":{"p50":4.0000,"p99":4.0000,"max":4.0000,"mean":4.0000,"samples":1})"), String::npos);
+}
+
+TEST(TickProfilerTests, JSONEscapesControlCharacters)
+{
+    Core::TickProfiler profiler;
+    profiler.AddModule(String("Line\nTab\tReturn\rBell\x07") + '\0');
+    profiler.Record(0, Core::TickPhase::Tick, 0.004);
+
+    const String json = profiler.ToJSON();
+    EXPECT_NE(json.find(R"("Line\nTab\tReturn\rBell\u0007\u0000":{)"), String::npos);
+    EXPECT_TRUE(std::none_of(json.begin(), json.end(), [](char c) { return static_cast<unsigned char>(c) < 0x20; }));
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/World.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    Core::Transform MakeTransform(glm::vec3 position, F32 angle = 0.0f, glm::vec3 scale = glm::vec3(1.0f))
+    {
+        Core::Transform transform;
+        transform.position = position;
+        transform.rotation = glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 0.0f, 1.0f));
+        transform.scale = scale;
+        return transform;
+    }
+
+    void ExpectPosition(const glm::mat4& matrix, F32 x, F32 y, F32 z)
+    {
+        EXPECT_NEAR(matrix[3][0], x, 1e-4f);
+        EXPECT_NEAR(matrix[3][1], y, 1e-4f);
+        EXPECT_NEAR(matrix[3][2], z, 1e-4f);
+    }
+}
+
+TEST(TransformHierarchyTests, RootWorldMatrixIsItsLocalTransform)
+{
+    Core::TransformHierarchy hierarchy;
+    const ECS::Entity entity = ECS::Entity::FromParts(0, 0);
+    hierarchy.Add(entity, MakeTransform({1.0f, 2.0f, 3.0f}, 0.0f, glm::vec3(2.0f)));
+    hierarchy.Update();
+
+    const glm::mat4& world = hierarchy.GetWorldMatrix(entity);
+    ExpectPosition(world, 1.0f, 2.0f, 3.0f);
+    EXPECT_FLOAT_EQ(world[0][0], 2.0f);
+    EXPECT_FLOAT_EQ(world[1][1], 2.0f);
+    EXPECT_EQ(hierarchy.GetDepthCount(), 1u);
+}
+
+TEST(TransformHierarchyTests, ChildrenInheritParentTransforms)
+{
+    Core::TransformHierarchy hierarchy;
+    const ECS::Entity parent = ECS::Entity::FromParts(0, 0);
+    const ECS::Entity child = ECS::Entity::FromParts(1, 0);
+    const ECS::Entity grandchild = ECS::Entity::FromParts(2, 0);
+    hierarchy.Add(parent, MakeTransform({1.0f, 0.0f, 0.0f}, 90.0f));
+    hierarchy.Add(child, MakeTransform({1.0f, 0.0f, 0.0f}, 0.0f, glm::vec3(2.0f)), parent);
+    hierarchy.Add(grandchild, MakeTransform({1.0f, 0.0f, 0.0f}), child);
+    hierarchy.Update();
+
+    ExpectPosition(hierarchy.GetWorldMatrix(child), 1.0f, 1.0f, 0.0f);
+    ExpectPosition(hierarchy.GetWorldMatrix(grandchild), 1.0f, 3.0f, 0.0f);
+    EXPECT_EQ(hierarchy.GetParent(grandchild), child);
+    EXPECT_EQ(hierarchy.GetDepthCount(), 3u);
+}
+
+TEST(TransformHierarchyTests, OnlyDirtySubtreesArePropagated)
+{
+    Core::TransformHierarchy hierarchy;
+    std::vector<ECS::Entity> entities;
+    for (UInt32 i = 0; i < 4; ++i)
+        entities.push_back(ECS::Entity::FromParts(i, 0));
+    hierarchy.Add(entities[0], MakeTransform({0.0f, 0.0f, 0.0f}));
+    hierarchy.Add(entities[1], MakeTransform({1.0f, 0.0f, 0.0f}), entities[0]);
+    hierarchy.Add(entities[2], MakeTransform({2.0f, 0.0f, 0.0f}), entities[0]);
+    hierarchy.Add(entities[3], MakeTransform({0.0f, 1.0f, 0.0f}), entities[1]);
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetUpdatedCount(), 4u);
+
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetUpdatedCount(), 0u);
+
+    hierarchy.SetLocal(entities[1], MakeTransform({5.0f, 0.0f, 0.0f}));
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetUpdatedCount(), 2u);
+    ExpectPosition(hierarchy.GetWorldMatrix(entities[3]), 5.0f, 1.0f, 0.0f);
+    ExpectPosition(hierarchy.GetWorldMatrix(entities[2]), 2.0f, 0.0f, 0.0f);
+
+    // Dirty nodes on different levels with a clean node in between
+    hierarchy.SetLocal(entities[2], MakeTransform({3.0f, 0.0f, 0.0f}));
+    hierarchy.SetLocal(entities[3], MakeTransform({0.0f, 2.0f, 0.0f}));
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetUpdatedCount(), 2u);
+    ExpectPosition(hierarchy.GetWorldMatrix(entities[3]), 5.0f, 2.0f, 0.0f);
+    ExpectPosition(hierarchy.GetWorldMatrix(entities[2]), 3.0f, 0.0f, 0.0f);
+
+    hierarchy.SetLocal(entities[0], MakeTransform({0.0f, 0.0f, 1.0f}));
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetUpdatedCount(), 4u);
+    ExpectPosition(hierarchy.GetWorldMatrix(entities[3]), 5.0f, 2.0f, 1.0f);
+}
+
+TEST(TransformHierarchyTests, ReparentingRejectsCycles)
+{
+    Core::TransformHierarchy hierarchy;
+    const ECS::Entity a = ECS::Entity::FromParts(0, 0);
+    const ECS::Entity b = ECS::Entity::FromParts(1, 0);
+    const ECS::Entity c = ECS::Entity::FromParts(2, 0);
+    hierarchy.Add(a, MakeTransform({1.0f, 0.0f, 0.0f}));
+    hierarchy.Add(b, MakeTransform({0.0f, 1.0f, 0.0f}), a);
+    hierarchy.Add(c, MakeTransform({0.0f, 0.0f, 1.0f}));
+
+    EXPECT_THROW(hierarchy.SetParent(a, b), std::invalid_argument);
+    EXPECT_THROW(hierarchy.SetParent(a, a), std::invalid_argument);
+    EXPECT_THROW(hierarchy.Add(a), std::invalid_argument);
+    EXPECT_THROW(hierarchy.Add(ECS::Entity::FromParts(3, 0), {}, ECS::Entity::FromParts(4, 0)), std::invalid_argument);
+
+    hierarchy.SetParent(b, c);
+    hierarchy.Update();
+    ExpectPosition(hierarchy.GetWorldMatrix(b), 0.0f, 1.0f, 1.0f);
+
+    hierarchy.SetParent(b, {});
+    hierarchy.Update();
+    ExpectPosition(hierarchy.GetWorldMatrix(b), 0.0f, 1.0f, 0.0f);
+    EXPECT_EQ(hierarchy.GetDepthCount(), 1u);
+}
+
+TEST(TransformHierarchyTests, RemovingANodeMakesItsChildrenRoots)
+{
+    Core::TransformHierarchy hierarchy;
+    const ECS::Entity parent = ECS::Entity::FromParts(0, 0);
+    const ECS::Entity child = ECS::Entity::FromParts(1, 0);
+    const ECS::Entity sibling = ECS::Entity::FromParts(2, 0);
+    hierarchy.Add(parent, MakeTransform({1.0f, 0.0f, 0.0f}));
+    hierarchy.Add(child, MakeTransform({0.0f, 1.0f, 0.0f}), parent);
+    hierarchy.Add(sibling, MakeTransform({0.0f, 2.0f, 0.0f}), parent);
+    hierarchy.Update();
+
+    EXPECT_TRUE(hierarchy.Remove(parent));
+    EXPECT_FALSE(hierarchy.Remove(parent));
+    EXPECT_FALSE(hierarchy.Contains(parent));
+    EXPECT_FALSE(hierarchy.GetParent(child).IsValid());
+
+    // Re-adding the same handle does not adopt the former children
+    hierarchy.Add(parent, MakeTransform({1.0f, 0.0f, 0.0f}));
+    hierarchy.Update();
+    ExpectPosition(hierarchy.GetWorldMatrix(child), 0.0f, 1.0f, 0.0f);
+    ExpectPosition(hierarchy.GetWorldMatrix(sibling), 0.0f, 2.0f, 0.0f);
+    EXPECT_EQ(hierarchy.GetCount(), 3u);
+}
+
+TEST(TransformHierarchyTests, DeepHierarchiesMatchSequentialComposition)
+{
+    Core::TransformHierarchy hierarchy;
+    constexpr UInt32 WIDTH = 37;
+    constexpr UInt32 DEPTH = 6;
+
+    // WIDTH chains of DEPTH nodes, every node rotated, scaled and offset, added deepest first as roots
+    // and parented afterwards, so the breadth-first order has to be rebuilt
+    std::vector<ECS::Entity> entities;
+    for (UInt32 i = 0; i < WIDTH * DEPTH; ++i)
+        entities.push_back(ECS::Entity::FromParts(i, 1));
+    for (UInt32 i = WIDTH * DEPTH; i-- > 0;)
+    {
+        const UInt32 chain = i / DEPTH;
+        const UInt32 level = i % DEPTH;
+        hierarchy.Add(entities[i], MakeTransform({F32(chain), F32(level), 0.5f}, F32(chain * 7 + level * 13),
+                                                 glm::vec3(1.0f + F32(level) * 0.1f)));
+    }
+    for (UInt32 i = 0; i < WIDTH * DEPTH; ++i)
+    {
+        if (i % DEPTH != 0)
+            hierarchy.SetParent(entities[i], entities[i - 1]);
+    }
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetDepthCount(), DEPTH);
+
+    for (UInt32 chain = 0; chain < WIDTH; ++chain)
+    {
+        glm::mat4 expected(1.0f);
+        for (UInt32 level = 0; level < DEPTH; ++level)
+        {
+            const Core::Transform& local = hierarchy.GetLocal(entities[chain * DEPTH + level]);
+            glm::mat4 matrix = glm::mat4_cast(local.rotation);
+            matrix[0] *= local.scale.x;
+            matrix[1] *= local.scale.y;
+            matrix[2] *= local.scale.z;
+            matrix[3] = glm::vec4(local.position, 1.0f);
+            expected = expected * matrix;
+
+            const glm::mat4& world = hierarchy.GetWorldMatrix(entities[chain * DEPTH + level]);
+            for (int column = 0; column < 4; ++column)
+                for (int row = 0; row < 4; ++row)
+                    ASSERT_NEAR(world[column][row], expected[column][row], 1e-3f);
+        }
+    }
+}
+
+TEST(TransformHierarchyTests, WorldUpdatesTransformsAndRemovesThemWithEntities)
+{
+    Core::World world;
+    const ECS::Entity parent = world.CreateEntity();
+    const ECS::Entity child = world.CreateEntity();
+    world.GetTransforms().Add(parent, MakeTransform({1.0f, 0.0f, 0.0f}));
+    world.GetTransforms().Add(child, MakeTransform({0.0f, 1.0f, 0.0f}), parent);
+
+    world.RunSystems(0.0);
+    ExpectPosition(world.GetTransforms().GetWorldMatrix(child), 1.0f, 1.0f, 0.0f);
+
+    world.DestroyEntity(parent);
+    EXPECT_FALSE(world.GetTransforms().Contains(parent));
+    world.RunSystems(0.0);
+    ExpectPosition(world.GetTransforms().GetWorldMatrix(child), 0.0f, 1.0f, 0.0f);
+}
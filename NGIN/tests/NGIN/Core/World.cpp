@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/World.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct Name
+    {
+        std::string value;
+    };
+
+    struct alignas(64) Aligned
+    {
+        float value = 0.0f;
+    };
+
+    struct Counted
+    {
+        explicit Counted(std::shared_ptr<int> counter)
+                : counter(std::move(counter))
+        {}
+
+        std::shared_ptr<int> counter;
+    };
+}
+
+TEST(WorldTests, CreateAndDestroyEntities)
+{
+    Core::World world;
+    const ECS::Entity a = world.CreateEntity();
+    const ECS::Entity b = world.CreateEntity(Position {1.0f, 2.0f});
+    EXPECT_TRUE(world.IsAlive(a));
+    EXPECT_TRUE(world.IsAlive(b));
+    EXPECT_EQ(world.GetEntityCount(), 2u);
+
+    world.DestroyEntity(a);
+    EXPECT_FALSE(world.IsAlive(a));
+    EXPECT_TRUE(world.IsAlive(b));
+    EXPECT_EQ(world.GetEntityCount(), 1u);
+    EXPECT_FLOAT_EQ(world.GetComponent<Position>(b).y, 2.0f);
+}
+
+TEST(WorldTests, EntityHandlePacksIndexAndGeneration)
+{
+    const ECS::Entity entity = ECS::Entity::FromParts(7, 3);
+    EXPECT_EQ(entity.GetIndex(), 7u);
+    EXPECT_EQ(entity.GetGeneration(), 3u);
+    EXPECT_EQ(entity.value, (UInt64(3) << 32) | 7u);
+    EXPECT_TRUE(entity.IsValid());
+    EXPECT_FALSE(ECS::Entity {}.IsValid());
+    static_assert(sizeof(ECS::Entity) == 8);
+}
+
+TEST(WorldTests, DestroyedSlotsAreRecycledWithNewGeneration)
+{
+    Core::World world;
+    const ECS::Entity first = world.CreateEntity(Position {1.0f, 0.0f});
+    world.DestroyEntity(first);
+
+    const ECS::Entity second = world.CreateEntity(Position {2.0f, 0.0f});
+    EXPECT_EQ(second.GetIndex(), first.GetIndex());
+    EXPECT_NE(second.GetGeneration(), first.GetGeneration());
+
+    EXPECT_FALSE(world.IsAlive(first));
+    EXPECT_TRUE(world.IsAlive(second));
+    EXPECT_EQ(world.TryGetComponent<Position>(first), nullptr);
+    EXPECT_FLOAT_EQ(world.GetComponent<Position>(second).x, 2.0f);
+
+    // Stale handles are ignored by every operation
+    world.DestroyEntity(first);
+    EXPECT_TRUE(world.IsAlive(second));
+    EXPECT_FALSE(world.RemoveComponent<Position>(first));
+    EXPECT_THROW(world.AddComponent<Velocity>(first), std::invalid_argument);
+    EXPECT_FALSE(world.IsAlive(ECS::Entity {}));
+    EXPECT_FALSE(world.IsAlive(ECS::Entity::FromParts(1000, 0)));
+}
+
+TEST(WorldTests, EntityTableDoesNotGrowWhenRecycling)
+{
+    Core::World world;
+    std::vector<ECS::Entity> entities;
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+            entities.push_back(world.CreateEntity());
+        for (ECS::Entity entity: entities)
+            world.DestroyEntity(entity);
+        entities.clear();
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const ECS::Entity entity = world.CreateEntity();
+        EXPECT_LT(entity.GetIndex(), 100u);
+        EXPECT_EQ(entity.GetGeneration(), 10u);
+    }
+    EXPECT_EQ(world.GetEntityCount(), 100u);
+}
+
+TEST(WorldTests, AddAndRemoveComponentsMoveBetweenArchetypes)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity();
+    world.AddComponent<Position>(entity, 1.0f, 2.0f);
+    world.AddComponent<Name>(entity, "player");
+    world.AddComponent<Velocity>(entity, 3.0f, 4.0f);
+
+    EXPECT_TRUE(world.HasComponent<Position>(entity));
+    EXPECT_TRUE(world.HasComponent<Velocity>(entity));
+    EXPECT_EQ(world.GetComponent<Name>(entity).value, "player");
+    EXPECT_FLOAT_EQ(world.GetComponent<Velocity>(entity).x, 3.0f);
+
+    EXPECT_TRUE(world.RemoveComponent<Position>(entity));
+    EXPECT_FALSE(world.RemoveComponent<Position>(entity));
+    EXPECT_FALSE(world.HasComponent<Position>(entity));
+    EXPECT_EQ(world.TryGetComponent<Position>(entity), nullptr);
+    EXPECT_EQ(world.GetComponent<Name>(entity).value, "player");
+    EXPECT_FLOAT_EQ(world.GetComponent<Velocity>(entity).y, 4.0f);
+    EXPECT_THROW((void) world.GetComponent<Position>(entity), std::out_of_range);
+}
+
+TEST(WorldTests, ComponentOrderDoesNotCreateNewArchetypes)
+{
+    Core::World world;
+    const ECS::Entity a = world.CreateEntity(Position {}, Velocity {});
+    const Size count = world.GetArchetypeCount();
+
+    world.CreateEntity(Velocity {}, Position {});
+    const ECS::Entity b = world.CreateEntity();
+    world.AddComponent<Velocity>(b);
+    world.AddComponent<Position>(b);
+    EXPECT_EQ(world.GetArchetypeCount(), count + 1);
+
+    world.RemoveComponent<Velocity>(a);
+    world.AddComponent<Velocity>(a);
+    EXPECT_EQ(world.GetArchetypeCount(), count + 2);
+}
+
+TEST(WorldTests, AddingExistingComponentReplacesIt)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity(Name {"old"});
+    const Size count = world.GetArchetypeCount();
+    world.AddComponent<Name>(entity, "new");
+    EXPECT_EQ(world.GetComponent<Name>(entity).value, "new");
+    EXPECT_EQ(world.GetArchetypeCount(), count);
+}
+
+TEST(WorldTests, RemovingRowsKeepsOtherEntitiesIntact)
+{
+    Core::World world;
+    std::vector<ECS::Entity> entities;
+    for (int i = 0; i < 5000; ++i)
+        entities.push_back(world.CreateEntity(Position {float(i), 0.0f}, Name {std::to_string(i)}));
+
+    for (int i = 0; i < 5000; i += 3)
+        world.DestroyEntity(entities[i]);
+    for (int i = 1; i < 5000; i += 3)
+        world.RemoveComponent<Name>(entities[i]);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            ASSERT_FALSE(world.IsAlive(entities[i]));
+            continue;
+        }
+        ASSERT_FLOAT_EQ(world.GetComponent<Position>(entities[i]).x, float(i));
+        if (i % 3 == 2)
+            ASSERT_EQ(world.GetComponent<Name>(entities[i]).value, std::to_string(i));
+        else
+            ASSERT_FALSE(world.HasComponent<Name>(entities[i]));
+    }
+}
+
+TEST(WorldTests, ChunksAreDenseAndReleased)
+{
+    Core::World world;
+    std::vector<ECS::Entity> entities;
+    for (int i = 0; i < 10000; ++i)
+        entities.push_back(world.CreateEntity(Position {}));
+
+    const ECS::Archetype* archetype = nullptr;
+    for (Size i = 0; i < world.GetArchetypeCount(); ++i)
+    {
+        if (world.GetArchetype(i).Has(ECS::ComponentID<Position>()))
+            archetype = &world.GetArchetype(i);
+    }
+    ASSERT_NE(archetype, nullptr);
+    EXPECT_GT(archetype->GetChunkCapacity(), 1000u);
+    EXPECT_EQ(archetype->GetEntityCount(), 10000u);
+    for (Size i = 0; i + 1 < archetype->GetChunkCount(); ++i)
+        EXPECT_EQ(archetype->GetChunk(i).count, archetype->GetChunkCapacity());
+
+    for (ECS::Entity entity: entities)
+        world.DestroyEntity(entity);
+    EXPECT_EQ(archetype->GetChunkCount(), 0u);
+    EXPECT_EQ(world.GetChunkCount(), 0u);
+}
+
+TEST(WorldTests, ColumnsAreAligned)
+{
+    Core::World world;
+    for (int i = 0; i < 100; ++i)
+    {
+        const ECS::Entity entity = world.CreateEntity(Position {}, Aligned {float(i)});
+        EXPECT_EQ(reinterpret_cast<UIntPtr>(&world.GetComponent<Aligned>(entity)) % 64, 0u);
+    }
+}
+
+TEST(WorldTests, EachVisitsMatchingEntities)
+{
+    Core::World world;
+    for (int i = 0; i < 100; ++i)
+    {
+        const ECS::Entity entity = world.CreateEntity(Position {float(i), 0.0f});
+        if (i % 2 == 0)
+            world.AddComponent<Velocity>(entity, 1.0f, 1.0f);
+    }
+
+    int visited = 0;
+    world.Each<Position, const Velocity>([&](Position& position, const Velocity& velocity)
+                                         {
+                                             position.x += velocity.x;
+                                             ++visited;
+                                         });
+    EXPECT_EQ(visited, 50);
+
+    float sum = 0.0f;
+    int withEntity = 0;
+    world.Each<const Position>([&](ECS::Entity entity, const Position& position)
+                               {
+                                   EXPECT_TRUE(world.IsAlive(entity));
+                                   sum += position.x;
+                                   ++withEntity;
+                               });
+    EXPECT_EQ(withEntity, 100);
+    EXPECT_FLOAT_EQ(sum, 4950.0f + 50.0f);
+}
+
+TEST(WorldTests, ComponentsAreDestroyed)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        Core::World world;
+        const ECS::Entity a = world.CreateEntity(Counted(counter));
+        world.CreateEntity(Counted(counter), Position {});
+        const ECS::Entity c = world.CreateEntity(Counted(counter));
+        EXPECT_EQ(counter.use_count(), 4);
+
+        world.DestroyEntity(a);
+        EXPECT_EQ(counter.use_count(), 3);
+        world.RemoveComponent<Counted>(c);
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
@@ -0,0 +1,343 @@
+#include <gtest/gtest.h>
+#include <NGIN/Core/WorldSnapshot.hpp>
+#include <NGIN/Meta/Reflection/Registration.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace NGIN;
+namespace ECS = NGIN::Core::ECS;
+
+namespace
+{
+    struct SnapshotPosition
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    struct SnapshotStats
+    {
+        int health = 0;
+        std::string title;
+    };
+
+    struct SnapshotCharacter
+    {
+        std::string name;
+        SnapshotStats stats;
+        float speed = 0.0f;
+    };
+
+    struct SnapshotNote
+    {
+        static constexpr ECS::ComponentStorage STORAGE = ECS::ComponentStorage::SparseSet;
+
+        std::string text;
+    };
+
+    struct SnapshotStunned
+    {
+        static constexpr ECS::ComponentStorage STORAGE = ECS::ComponentStorage::SparseSet;
+
+        int turns = 0;
+    };
+
+    struct SnapshotUnreflected
+    {
+        std::string value;
+    };
+
+    namespace first
+    {
+        struct SnapshotNamesake
+        {
+            std::string label;
+        };
+    }
+
+    namespace second
+    {
+        struct SnapshotNamesake
+        {
+            int count = 0;
+            std::string text;
+        };
+    }
+
+    std::vector<std::byte> Save(const Core::World& world)
+    {
+        std::ostringstream stream;
+        Core::WorldSnapshot::Save(world, stream);
+        const std::string bytes = stream.str();
+        const auto* begin = reinterpret_cast<const std::byte*>(bytes.data());
+        return {begin, begin + bytes.size()};
+    }
+
+    /// \brief Entities with trivial, reflected and sparse components, transforms, and a free slot.
+    std::vector<ECS::Entity> Populate(Core::World& world)
+    {
+        std::vector<ECS::Entity> entities;
+        for (int i = 0; i < 3000; ++i)
+        {
+            const float value = static_cast<float>(i);
+            if (i % 3 == 0)
+                entities.push_back(world.CreateEntity(SnapshotPosition {value, -value}));
+            else
+                entities.push_back(world.CreateEntity(SnapshotPosition {value, -value},
+                                                      SnapshotCharacter {"character " + std::to_string(i),
+                                                                         {i, "title " + std::to_string(i)},
+                                                                         value * 0.5f}));
+            if (i % 7 == 0)
+                world.AddComponent<SnapshotStunned>(entities.back(), i);
+            if (i % 11 == 0)
+                world.AddComponent<SnapshotNote>(entities.back(),
+                                                 "a long enough note to leave the small buffer " + std::to_string(i));
+        }
+        world.GetTransforms().Add(entities[0], {{1.0f, 0.0f, 0.0f}});
+        world.GetTransforms().Add(entities[1], {{0.0f, 2.0f, 0.0f}}, entities[0]);
+        world.DestroyEntity(entities[2]);
+        return entities;
+    }
+
+    void ExpectPopulated(const Core::World& world, const std::vector<ECS::Entity>& entities)
+    {
+        EXPECT_EQ(world.GetEntityCount(), entities.size() - 1);
+        EXPECT_FALSE(world.IsAlive(entities[2]));
+        for (int i = 0; i < static_cast<int>(entities.size()); ++i)
+        {
+            if (i == 2)
+                continue;
+            const ECS::Entity entity = entities[i];
+            ASSERT_TRUE(world.IsAlive(entity));
+            EXPECT_EQ(world.GetComponent<SnapshotPosition>(entity).x, static_cast<float>(i));
+            EXPECT_EQ(world.GetComponent<SnapshotPosition>(entity).y, -static_cast<float>(i));
+            EXPECT_EQ(world.HasComponent<SnapshotCharacter>(entity), i % 3 != 0);
+            if (i % 3 != 0)
+            {
+                const SnapshotCharacter& character = world.GetComponent<SnapshotCharacter>(entity);
+                EXPECT_EQ(character.name, "character " + std::to_string(i));
+                EXPECT_EQ(character.stats.health, i);
+                EXPECT_EQ(character.stats.title, "title " + std::to_string(i));
+                EXPECT_EQ(character.speed, static_cast<float>(i) * 0.5f);
+            }
+            EXPECT_EQ(world.HasComponent<SnapshotStunned>(entity), i % 7 == 0);
+            if (i % 7 == 0)
+            {
+                EXPECT_EQ(world.GetComponent<SnapshotStunned>(entity).turns, i);
+            }
+            EXPECT_EQ(world.HasComponent<SnapshotNote>(entity), i % 11 == 0);
+            if (i % 11 == 0)
+            {
+                EXPECT_EQ(world.GetComponent<SnapshotNote>(entity).text,
+                          "a long enough note to leave the small buffer " + std::to_string(i));
+            }
+        }
+
+        const Core::TransformHierarchy& transforms = world.GetTransforms();
+        EXPECT_EQ(transforms.GetCount(), 2u);
+        EXPECT_EQ(transforms.GetParent(entities[1]), entities[0]);
+        EXPECT_EQ(transforms.GetWorldMatrix(entities[1])[3].x, 1.0f);
+        EXPECT_EQ(transforms.GetWorldMatrix(entities[1])[3].y, 2.0f);
+    }
+}
+
+NGIN_REFLECTION_REGISTRATION()
+{
+    Meta::Reflection::RegisterClass<SnapshotStats>()
+            .RegisterProperty("health", &SnapshotStats::health)
+            .RegisterProperty("title", &SnapshotStats::title);
+    Meta::Reflection::RegisterClass<SnapshotCharacter>()
+            .RegisterProperty("name", &SnapshotCharacter::name)
+            .RegisterProperty("stats", &SnapshotCharacter::stats)
+            .RegisterProperty("speed", &SnapshotCharacter::speed);
+    Meta::Reflection::RegisterClass<SnapshotNote>()
+            .RegisterProperty("text", &SnapshotNote::text);
+    Meta::Reflection::RegisterClass<first::SnapshotNamesake>()
+            .RegisterProperty("label", &first::SnapshotNamesake::label);
+    Meta::Reflection::RegisterClass<second::SnapshotNamesake>()
+            .RegisterProperty("count", &second::SnapshotNamesake::count)
+            .RegisterProperty("text", &second::SnapshotNamesake::text);
+}
+
+TEST(WorldSnapshotTests, LoadRestoresTheWorld)
+{
+    Core::World world;
+    const std::vector<ECS::Entity> entities = Populate(world);
+    const std::vector<std::byte> snapshot = Save(world);
+    EXPECT_EQ(snapshot.size() % ECS::CHUNK_SIZE, 0u);
+
+    Core::World restored;
+    Core::WorldSnapshot::Load(restored, snapshot);
+    ExpectPopulated(restored, entities);
+    EXPECT_EQ(restored.GetArchetypeCount(), world.GetArchetypeCount());
+    EXPECT_EQ(restored.GetChunkCount(), world.GetChunkCount());
+
+    // The destroyed slot is reused with its next generation, as in the original world
+    const ECS::Entity created = restored.CreateEntity(SnapshotPosition {});
+    EXPECT_EQ(created.GetIndex(), entities[2].GetIndex());
+    EXPECT_EQ(created, world.CreateEntity(SnapshotPosition {}));
+
+    // Snapshots of a restored world are identical
+    restored.DestroyEntity(created);
+    world.DestroyEntity(created);
+    EXPECT_EQ(Save(restored).size(), Save(world).size());
+}
+
+TEST(WorldSnapshotTests, MapAdoptsTheChunksInPlace)
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ngin_world_snapshot_test.bin";
+    std::vector<ECS::Entity> entities;
+    {
+        Core::World world;
+        entities = Populate(world);
+        Core::WorldSnapshot::Save(world, path.string());
+    }
+
+    {
+        Core::World mapped;
+        Core::WorldSnapshot::Map(mapped, path.string());
+        ExpectPopulated(mapped, entities);
+
+        // Writes go to private copies of the mapped pages, not to the file
+        mapped.GetComponent<SnapshotPosition>(entities[0]).x = 42.0f;
+        Core::World loaded;
+        Core::WorldSnapshot::Map(loaded, path.string());
+        EXPECT_EQ(loaded.GetComponent<SnapshotPosition>(entities[0]).x, 0.0f);
+
+        // The adopted chunks are released and reused for new entities
+        const Size chunkCount = mapped.GetChunkCount();
+        for (Size i = 0; i < entities.size(); ++i)
+            mapped.DestroyEntity(entities[i]);
+        EXPECT_EQ(mapped.GetChunkCount(), 0u);
+        for (int i = 0; i < 3000; ++i)
+            mapped.CreateEntity(SnapshotPosition {static_cast<float>(i)});
+        EXPECT_LE(mapped.GetChunkCount(), chunkCount);
+        Size visited = 0;
+        mapped.Query<const SnapshotPosition&>().ForEach([&](const SnapshotPosition&) { ++visited; });
+        EXPECT_EQ(visited, 3000u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(WorldSnapshotTests, EmptyWorldRoundTrips)
+{
+    Core::World world;
+    Core::World restored;
+    Core::WorldSnapshot::Load(restored, Save(world));
+    EXPECT_EQ(restored.GetEntityCount(), 0u);
+    EXPECT_TRUE(restored.IsAlive(restored.CreateEntity()));
+}
+
+TEST(WorldSnapshotTests, EqualWorldsGiveEqualSnapshots)
+{
+    // The worlds only differ in the stale row left behind by the destroyed entity
+    const auto build = [](float staleValue)
+    {
+        Core::World world;
+        world.CreateEntity(SnapshotPosition {1.0f, 2.0f});
+        world.CreateEntity(SnapshotPosition {3.0f, 4.0f});
+        world.DestroyEntity(world.CreateEntity(SnapshotPosition {staleValue, staleValue}));
+        return Save(world);
+    };
+    EXPECT_EQ(build(5.0f), build(6.0f));
+}
+
+TEST(WorldSnapshotTests, RetiredSlotsRoundTrip)
+{
+    Core::World world;
+    const ECS::Entity kept = world.CreateEntity(SnapshotPosition {1.0f, 2.0f});
+    const ECS::Entity retired = world.CreateEntity(SnapshotPosition {3.0f, 4.0f});
+    world.DestroyEntity(retired);
+    std::vector<std::byte> snapshot = Save(world);
+
+    // Reaching the last generation takes 2^32 destructions, so retire the slot in the snapshot instead: its
+    // record is the only free one, it gets the last generation and the free list at byte 32 is emptied
+    constexpr UInt32 LAST = std::numeric_limits<UInt32>::max();
+    const UInt32 free[3] = {ECS::Archetype::INVALID_ARCHETYPE, retired.GetGeneration() + 1, LAST};
+    const auto* pattern = reinterpret_cast<const std::byte*>(free);
+    const auto record = std::search(snapshot.begin(), snapshot.end(), pattern, pattern + sizeof(free));
+    ASSERT_NE(record, snapshot.end());
+    std::memcpy(&*record + sizeof(UInt32), &LAST, sizeof(UInt32));
+    std::memcpy(snapshot.data() + 32, &LAST, sizeof(UInt32));
+
+    Core::World restored;
+    Core::WorldSnapshot::Load(restored, snapshot);
+
+    // A world with a retired slot saves and restores as well
+    Core::World reloaded;
+    Core::WorldSnapshot::Load(reloaded, Save(restored));
+    EXPECT_EQ(reloaded.GetEntityCount(), 1u);
+    EXPECT_EQ(reloaded.GetComponent<SnapshotPosition>(kept).y, 2.0f);
+    EXPECT_FALSE(reloaded.IsAlive(retired));
+    EXPECT_NE(reloaded.CreateEntity(SnapshotPosition {}).GetIndex(), retired.GetIndex());
+}
+
+TEST(WorldSnapshotTests, RejectsInvalidTargetsAndData)
+{
+    Core::World world;
+    Populate(world);
+    const std::vector<std::byte> snapshot = Save(world);
+
+    Core::World used;
+    used.CreateEntity();
+    EXPECT_THROW(Core::WorldSnapshot::Load(used, snapshot), std::invalid_argument);
+
+    for (const Size size: {Size(0), Size(16), snapshot.size() / 2, snapshot.size() - ECS::CHUNK_SIZE})
+    {
+        Core::World truncated;
+        EXPECT_THROW(Core::WorldSnapshot::Load(truncated, std::span(snapshot.data(), size)), std::invalid_argument);
+    }
+
+    std::vector<std::byte> corrupted = snapshot;
+    corrupted[0] = std::byte {'X'};
+    Core::World target;
+    EXPECT_THROW(Core::WorldSnapshot::Load(target, corrupted), std::invalid_argument);
+
+    // Counts too large for the data are rejected before anything is sized from them: the archetype count
+    // at byte 24, the record count at byte 48 and the transform count at byte 56 of the header
+    const auto withCount = [&](Size offset, auto count)
+    {
+        std::vector<std::byte> bytes = snapshot;
+        std::memcpy(bytes.data() + offset, &count, sizeof(count));
+        return bytes;
+    };
+    for (const std::vector<std::byte>& inflated: {withCount(24, UInt32(0xFFFFFFF0)),
+                                                  withCount(48, UInt64(ECS::Entity::INVALID_INDEX)),
+                                                  withCount(56, UInt64(1) << 60)})
+    {
+        Core::World oversized;
+        EXPECT_THROW(Core::WorldSnapshot::Load(oversized, inflated), std::invalid_argument);
+    }
+
+    Core::World missing;
+    EXPECT_THROW(Core::WorldSnapshot::Map(missing, "does/not/exist.bin"), std::runtime_error);
+}
+
+TEST(WorldSnapshotTests, ClassesSharingANameAcrossNamespacesAreToldApart)
+{
+    Core::World world;
+    const ECS::Entity entity = world.CreateEntity(first::SnapshotNamesake {"first"},
+                                                  second::SnapshotNamesake {2, "second"});
+
+    Core::World restored;
+    Core::WorldSnapshot::Load(restored, Save(world));
+    EXPECT_EQ(restored.GetComponent<first::SnapshotNamesake>(entity).label, "first");
+    EXPECT_EQ(restored.GetComponent<second::SnapshotNamesake>(entity).count, 2);
+    EXPECT_EQ(restored.GetComponent<second::SnapshotNamesake>(entity).text, "second");
+}
+
+TEST(WorldSnapshotTests, SaveRejectsUnreflectedComponents)
+{
+    Core::World world;
+    world.CreateEntity(SnapshotPosition {}, SnapshotUnreflected {"x"});
+    std::ostringstream stream;
+    EXPECT_THROW(Core::WorldSnapshot::Save(world, stream), std::invalid_argument);
+    EXPECT_TRUE(stream.str().empty());
+}
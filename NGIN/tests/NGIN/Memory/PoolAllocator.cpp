@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <NGIN/Memory/PoolAllocator.hpp>
+#include <NGIN/Memory/FallbackAllocator.hpp>
+#include <NGIN/Memory/Mallocator.hpp>
+
+#include <set>
+#include <utility>
+
+using namespace NGIN::Memory;
+
+class PoolAllocatorTest : public ::testing::Test
+{
+protected:
+    PoolAllocator allocator;
+
+    PoolAllocatorTest() : allocator(64, 8) {} // Eight blocks of 64 bytes for each test
+};
+
+TEST_F(PoolAllocatorTest, AllocatesDistinctAlignedBlocks)
+{
+    std::set<void *> blocks;
+    for (int i = 0; i < 8; ++i)
+    {
+        void *block = allocator.Allocate(64);
+        ASSERT_NE(block, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t), 0u);
+        EXPECT_TRUE(allocator.Owns(block));
+        blocks.insert(block);
+    }
+    EXPECT_EQ(blocks.size(), 8u);
+    EXPECT_EQ(allocator.GetFreeBlockCount(), 0u);
+}
+
+TEST_F(PoolAllocatorTest, Exhaustion)
+{
+    for (int i = 0; i < 8; ++i)
+        allocator.Allocate(1);
+    EXPECT_EQ(allocator.Allocate(1), nullptr);
+}
+
+TEST_F(PoolAllocatorTest, RejectsOversizedAndOveraligned)
+{
+    EXPECT_EQ(allocator.Allocate(65), nullptr);
+    EXPECT_EQ(allocator.Allocate(8, 256), nullptr);
+    EXPECT_EQ(allocator.GetFreeBlockCount(), 8u);
+}
+
+TEST_F(PoolAllocatorTest, DeallocateReusesBlock)
+{
+    void *block = allocator.Allocate(32);
+    allocator.Deallocate(block);
+    EXPECT_EQ(allocator.Allocate(32), block);
+
+    allocator.Deallocate(nullptr);
+    EXPECT_EQ(allocator.GetFreeBlockCount(), 7u);
+}
+
+TEST_F(PoolAllocatorTest, DeallocateAll)
+{
+    for (int i = 0; i < 8; ++i)
+        allocator.Allocate(64);
+    allocator.DeallocateAll();
+    EXPECT_EQ(allocator.GetFreeBlockCount(), 8u);
+    EXPECT_NE(allocator.Allocate(64), nullptr);
+}
+
+TEST_F(PoolAllocatorTest, Owns)
+{
+    int outside = 0;
+    EXPECT_FALSE(allocator.Owns(&outside));
+
+    PoolAllocator moved(std::move(allocator));
+    void *block = moved.Allocate(16);
+    EXPECT_TRUE(moved.Owns(block));
+    EXPECT_FALSE(allocator.Owns(block));
+}
+
+TEST(PoolAllocatorFallbackTest, SpillsToFallbackWhenExhausted)
+{
+    FallbackAllocator<PoolAllocator, Mallocator> allocator(PoolAllocator(32, 1), Mallocator());
+    void *pooled = allocator.Allocate(32);
+    void *spilled = allocator.Allocate(32);
+    ASSERT_NE(spilled, nullptr);
+    EXPECT_NE(pooled, spilled);
+
+    allocator.Deallocate(spilled);
+    allocator.Deallocate(pooled);
+    EXPECT_EQ(allocator.Allocate(32), pooled);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <NGIN/Meta/StoragePolicy/HybridStorage.hpp> // Replace with the actual path
+#include <memory>
+#include <cstdlib>
+#include <string>
 
 using namespace NGIN;
 
@@ -43,6 +46,53 @@ namespace
         SmallType(SmallType &&other) noexcept : x(other.x) { other.x = 0; }
         SmallType &operator=(SmallType &&other) = default;
     };
+
+    struct TrivialType
+    {
+        int values[4];
+    };
+
+    struct CopyableLargeType
+    {
+        char data[200];
+        std::string name;
+    };
+
+    struct NonCopyableType
+    {
+        std::unique_ptr<int> value;
+    };
+
+    int liveCount = 0;
+
+    struct CountingAllocator
+    {
+        int allocations = 0;
+        int deallocations = 0;
+
+        void *Allocate(size_t size, size_t, const std::source_location &)
+        {
+            ++allocations;
+            return std::malloc(size);
+        }
+
+        void Deallocate(void *ptr)
+        {
+            ++deallocations;
+            std::free(ptr);
+        }
+
+        bool Owns(void *) { return true; }
+    };
+
+    struct CountedType
+    {
+        int x;
+        explicit CountedType(int x) : x(x) { ++liveCount; }
+        CountedType(const CountedType &other) : x(other.x) { ++liveCount; }
+        CountedType(CountedType &&other) noexcept : x(other.x) { ++liveCount; }
+        ~CountedType() { --liveCount; }
+    };
 }
 class HybridStorageTest : public ::testing::Test
 {
@@ -127,4 +177,142 @@ TEST_F(HybridStorageTest, MoveConstructorForLargeType)
     EXPECT_EQ(destroyed, true);
 }
 
+TEST_F(HybridStorageTest, TrivialTypeIsTriviallyRelocatable)
+{
+    Meta::StoragePolicy::HybridStorage<32> policy{TrivialType{{1, 2, 3, 4}}};
+    EXPECT_TRUE(policy.IsTriviallyRelocatable());
+
+    Meta::StoragePolicy::HybridStorage<32> policy2(std::move(policy));
+    EXPECT_EQ(static_cast<TrivialType *>(policy2.get())->values[3], 4);
+}
+
+TEST_F(HybridStorageTest, NonTrivialInlineTypeIsNotTriviallyRelocatable)
+{
+    Meta::StoragePolicy::HybridStorage<128> policy{SmallType()};
+    EXPECT_FALSE(policy.IsTriviallyRelocatable());
+
+    Meta::StoragePolicy::HybridStorage<128> large{LargeType()};
+    EXPECT_TRUE(large.IsTriviallyRelocatable());
+}
+
+TEST_F(HybridStorageTest, CopyConstructorForLargeTypeCopiesWholeObject)
+{
+    CopyableLargeType value;
+    std::fill_n(value.data, 200, 'b');
+    value.name = "a string long enough to not fit the small string buffer";
+
+    Meta::StoragePolicy::HybridStorage<32> policy{std::move(value)};
+    Meta::StoragePolicy::HybridStorage<32> copy(policy);
+
+    auto *original = static_cast<CopyableLargeType *>(policy.get());
+    auto *copied = static_cast<CopyableLargeType *>(copy.get());
+    EXPECT_NE(original, copied);
+    EXPECT_EQ(copied->data[199], 'b');
+    EXPECT_EQ(copied->name, original->name);
+}
+
+TEST_F(HybridStorageTest, CopyOfNonCopyableTypeThrows)
+{
+    Meta::StoragePolicy::HybridStorage<32> policy{NonCopyableType{std::make_unique<int>(7)}};
+    EXPECT_THROW(Meta::StoragePolicy::HybridStorage<32> copy(policy), std::invalid_argument);
+}
+
+TEST_F(HybridStorageTest, AssignmentDestroysPreviousObject)
+{
+    liveCount = 0;
+    {
+        Meta::StoragePolicy::HybridStorage<32> policy{CountedType(1)};
+        Meta::StoragePolicy::HybridStorage<32> other{CountedType(2)};
+        EXPECT_EQ(liveCount, 2);
+
+        policy = std::move(other);
+        EXPECT_EQ(liveCount, 1);
+        EXPECT_EQ(static_cast<CountedType *>(policy.get())->x, 2);
+
+        Meta::StoragePolicy::HybridStorage<32> third{CountedType(3)};
+        policy = third;
+        EXPECT_EQ(liveCount, 2);
+        EXPECT_EQ(static_cast<CountedType *>(policy.get())->x, 3);
+    }
+    EXPECT_EQ(liveCount, 0);
+}
+
+TEST_F(HybridStorageTest, RelocateRange)
+{
+    using Storage = Meta::StoragePolicy::HybridStorage<32>;
+    liveCount = 0;
+    {
+        alignas(Storage) std::byte source[sizeof(Storage) * 3];
+        alignas(Storage) std::byte destination[sizeof(Storage) * 3];
+        auto *src = reinterpret_cast<Storage *>(source);
+        auto *dst = reinterpret_cast<Storage *>(destination);
+
+        new (&src[0]) Storage(TrivialType{{5, 6, 7, 8}});
+        new (&src[1]) Storage(CountedType(9));
+        new (&src[2]) Storage(LargeType());
+
+        Storage::Relocate(dst, src, 3);
+
+        EXPECT_EQ(static_cast<TrivialType *>(dst[0].get())->values[0], 5);
+        EXPECT_EQ(static_cast<CountedType *>(dst[1].get())->x, 9);
+        EXPECT_EQ(static_cast<LargeType *>(dst[2].get())->data[0], 'a');
+        EXPECT_EQ(liveCount, 1);
+
+        for (int i = 0; i < 3; ++i)
+            dst[i].~Storage();
+    }
+    EXPECT_EQ(liveCount, 0);
+}
+
+TEST_F(HybridStorageTest, LargeTypeSpillsToAllocator)
+{
+    CountingAllocator allocator;
+    {
+        Meta::StoragePolicy::HybridStorage<32> policy{LargeType(), allocator};
+        EXPECT_TRUE(policy.IsSpilledToAllocator());
+        EXPECT_EQ(allocator.allocations, 1);
+        EXPECT_EQ(static_cast<LargeType *>(policy.get())->data[0], 'a');
+
+        Meta::StoragePolicy::HybridStorage<32> moved(std::move(policy));
+        EXPECT_TRUE(moved.IsSpilledToAllocator());
+        EXPECT_EQ(allocator.allocations, 1);
+        EXPECT_EQ(allocator.deallocations, 0);
+    }
+    EXPECT_EQ(allocator.deallocations, 1);
+    EXPECT_EQ(destroyed, true);
+}
+
+TEST_F(HybridStorageTest, SmallTypeIgnoresAllocator)
+{
+    CountingAllocator allocator;
+    {
+        Meta::StoragePolicy::HybridStorage<32> policy{SmallType(), allocator};
+        EXPECT_FALSE(policy.IsSpilledToAllocator());
+        EXPECT_EQ(static_cast<SmallType *>(policy.get())->x, 42);
+    }
+    EXPECT_EQ(allocator.allocations, 0);
+    EXPECT_EQ(allocator.deallocations, 0);
+}
+
+TEST_F(HybridStorageTest, CopyOfSpilledTypeUsesAllocator)
+{
+    CountingAllocator allocator;
+    {
+        CopyableLargeType value;
+        std::fill_n(value.data, 200, 'c');
+        Meta::StoragePolicy::HybridStorage<32> policy{std::move(value), allocator};
+        Meta::StoragePolicy::HybridStorage<32> copy(policy);
+        EXPECT_TRUE(copy.IsSpilledToAllocator());
+        EXPECT_EQ(allocator.allocations, 2);
+        EXPECT_EQ(static_cast<CopyableLargeType *>(copy.get())->data[199], 'c');
+    }
+    EXPECT_EQ(allocator.deallocations, 2);
+}
+
 // If you wish to test for memory leaks, you might have to use additional tools or libraries.
+
+TEST_F(HybridStorageTest, LayoutIsBufferAndOperationsPointer)
+{
+    EXPECT_EQ(sizeof(Meta::StoragePolicy::HybridStorage<32>), 32 + sizeof(void *));
+    EXPECT_EQ(sizeof(Meta::StoragePolicy::HybridStorage<128>), 128 + sizeof(void *));
+}
@@ -134,3 +134,17 @@ TEST_F(StaticStorageTest, CompileTimeCheckForSize)
 
 }
 */
+
+// Test that move assignment destroys the previously stored object
+TEST_F(StaticStorageTest, MoveAssignmentDestroysPrevious)
+{
+	Meta::StoragePolicy::StaticStorage<128> policy1{SmallType()};
+	Meta::StoragePolicy::StaticStorage<128> policy2{MovableType(400)};
+
+	destroyed = false;
+	policy1 = std::move(policy2);
+	EXPECT_EQ(destroyed, true);
+
+	MovableType *ptr = static_cast<MovableType *>(policy1.get());
+	EXPECT_EQ(ptr->value, 400);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <NGIN/Meta/TypeMap.hpp>
+#include <string>
+
+using namespace NGIN::Meta;
+
+namespace
+{
+    template<int N>
+    struct Tag {};
+}
+
+TEST(TypeMapTests, InsertAndFind)
+{
+    TypeMap<int> map;
+    EXPECT_TRUE(map.Insert<int>(1));
+    EXPECT_TRUE(map.Insert<double>(2));
+    EXPECT_FALSE(map.Insert<int>(3));
+
+    ASSERT_NE(map.Find<int>(), nullptr);
+    EXPECT_EQ(*map.Find<int>(), 1);
+    EXPECT_EQ(*map.Find<double>(), 2);
+    EXPECT_EQ(map.Find<char>(), nullptr);
+    EXPECT_EQ(*map.Find(TypeID<double>()), 2);
+    EXPECT_EQ(map.GetSize(), 2);
+}
+
+TEST(TypeMapTests, CachedLookupSurvivesGrowth)
+{
+    TypeMap<int> map;
+    map.Insert<Tag<0>>(0);
+    EXPECT_EQ(*map.Find<Tag<0>>(), 0);
+
+    // Force several rehashes after the lookup of Tag<0> was cached
+    [&]<int... Is>(std::integer_sequence<int, Is...>)
+    {
+        (map.Insert<Tag<Is + 1>>(Is + 1), ...);
+    }(std::make_integer_sequence<int, 40> {});
+
+    EXPECT_EQ(map.GetSize(), 41);
+    EXPECT_EQ(*map.Find<Tag<0>>(), 0);
+    EXPECT_EQ(*map.Find<Tag<40>>(), 40);
+    EXPECT_EQ(*map.Find<Tag<17>>(), 17);
+}
+
+TEST(TypeMapTests, RemoveInvalidatesCache)
+{
+    TypeMap<std::string> map;
+    map.Insert<Tag<0>>("zero");
+    map.Insert<Tag<1>>("one");
+    map.Insert<Tag<2>>("two");
+    EXPECT_EQ(*map.Find<Tag<2>>(), "two");
+
+    // Tag<2> is swapped into the position of Tag<0>
+    EXPECT_TRUE(map.Remove<Tag<0>>());
+    EXPECT_FALSE(map.Remove<Tag<0>>());
+    EXPECT_EQ(map.Find<Tag<0>>(), nullptr);
+    EXPECT_EQ(*map.Find<Tag<2>>(), "two");
+    EXPECT_EQ(*map.Find<Tag<1>>(), "one");
+    EXPECT_EQ(map.GetSize(), 2);
+}
+
+TEST(TypeMapTests, CacheIsPerMap)
+{
+    TypeMap<int> first;
+    TypeMap<int> second;
+    first.Insert<int>(1);
+    second.Insert<float>(0);
+    second.Insert<int>(2);
+
+    EXPECT_EQ(*first.Find<int>(), 1);
+    EXPECT_EQ(*second.Find<int>(), 2);
+    EXPECT_EQ(*first.Find<int>(), 1);
+
+    TypeMap<int> copy = second;
+    *copy.Find<int>() = 3;
+    EXPECT_EQ(*second.Find<int>(), 2);
+    EXPECT_EQ(*copy.Find<int>(), 3);
+
+    first.Clear();
+    EXPECT_EQ(first.Find<int>(), nullptr);
+}
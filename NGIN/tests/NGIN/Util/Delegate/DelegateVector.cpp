@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <NGIN/Util/Delegate/DelegateVector.hpp>
+#include <NGIN/Util/Delegate/StaticDelegate.hpp>
+#include <memory>
+
+using namespace NGIN::Util;
+
+namespace
+{
+    using Delegate = StaticDelegate<int()>;
+
+    /// \brief Callable pointing into itself, only valid if it is moved through its move constructor.
+    struct SelfReferencing
+    {
+        int value;
+        const int* self = &value;
+
+        explicit SelfReferencing(int value) : value(value) {}
+
+        SelfReferencing(const SelfReferencing& other) : value(other.value) {}
+
+        SelfReferencing(SelfReferencing&& other) noexcept : value(other.value) {}
+
+        int operator()() const { return *self; }
+    };
+}
+
+TEST(DelegateVectorTest, PushBackGrowsAcrossReallocations)
+{
+    auto shared = std::make_shared<int>(1000);
+    DelegateVector<Delegate> delegates;
+    for (int i = 0; i < 50; ++i)
+    {
+        if (i % 2 == 0)
+            delegates.PushBack(Delegate(SelfReferencing(i)));
+        else
+            delegates.PushBack(Delegate([shared, i]() { return *shared + i; }));
+    }
+
+    ASSERT_EQ(delegates.GetSize(), 50u);
+    for (int i = 0; i < 50; ++i)
+        EXPECT_EQ(delegates[i](), i % 2 == 0 ? i : 1000 + i);
+    EXPECT_EQ(shared.use_count(), 26);
+
+    delegates.Clear();
+    EXPECT_TRUE(delegates.IsEmpty());
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(DelegateVectorTest, InsertKeepsOrder)
+{
+    DelegateVector<Delegate> delegates;
+    for (int i = 0; i < 4; ++i)
+        delegates.PushBack(Delegate(SelfReferencing(i * 10)));
+
+    // At capacity, then with room to spare
+    delegates.Insert(1, Delegate(SelfReferencing(5)));
+    delegates.Insert(0, Delegate(SelfReferencing(-5)));
+    delegates.Insert(6, Delegate(SelfReferencing(35)));
+
+    const int expected[] = {-5, 0, 5, 10, 20, 30, 35};
+    ASSERT_EQ(delegates.GetSize(), std::size(expected));
+    for (NGIN::Size i = 0; i < delegates.GetSize(); ++i)
+        EXPECT_EQ(delegates[i](), expected[i]);
+}
+
+TEST(DelegateVectorTest, TruncateAndMove)
+{
+    auto shared = std::make_shared<int>(7);
+    DelegateVector<Delegate> delegates;
+    for (int i = 0; i < 6; ++i)
+        delegates.PushBack(Delegate([shared]() { return *shared; }));
+
+    delegates.Truncate(2);
+    EXPECT_EQ(delegates.GetSize(), 2u);
+    EXPECT_EQ(shared.use_count(), 3);
+
+    DelegateVector<Delegate> moved(std::move(delegates));
+    EXPECT_TRUE(delegates.IsEmpty());
+    EXPECT_EQ(moved[1](), 7);
+
+    delegates = std::move(moved);
+    EXPECT_EQ(delegates.GetSize(), 2u);
+    EXPECT_EQ(shared.use_count(), 3);
+}
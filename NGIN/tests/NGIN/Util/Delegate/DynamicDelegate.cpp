@@ -97,4 +97,12 @@ TEST_F(DynamicDelegateTest, CapturingLambdaTest)
         { return x + a; };
     DynamicDelegate del(lambda);
     EXPECT_EQ(del.Return<int>(2), 3);
-}
\ No newline at end of file
+}
+/// \brief Test that the delegate is its storage, the invoker pointer and the return type ID, the storage
+/// being a four pointer inline buffer and an operations table pointer.
+TEST_F(DynamicDelegateTest, CompactLayoutTest)
+{
+    constexpr NGIN::Size storageSize = sizeof(void*) * 4 + sizeof(void*);
+    constexpr NGIN::Size invokerSize = sizeof(void*);
+    EXPECT_EQ(sizeof(DynamicDelegate), storageSize + invokerSize + sizeof(NGIN::UInt64));
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <NGIN/Util/Delegate/InplaceDelegate.hpp>
+#include <memory>
+#include <string>
+using namespace NGIN::Util;
+
+namespace
+{
+    int Sum(int x, int y)
+    {
+        return x + y;
+    }
+
+    struct TestClass
+    {
+        int factor = 3;
+
+        int Multiply(int x)
+        {
+            return x * factor;
+        }
+
+        int ConstMultiply(int x) const
+        {
+            return x * factor;
+        }
+    };
+
+    struct CountingCallable
+    {
+        static inline int liveInstances = 0;
+
+        CountingCallable() { ++liveInstances; }
+        CountingCallable(const CountingCallable&) { ++liveInstances; }
+        CountingCallable(CountingCallable&&) noexcept { ++liveInstances; }
+        ~CountingCallable() { --liveInstances; }
+
+        int operator()(int x) const { return x + 1; }
+    };
+}
+
+class InplaceDelegateTest : public ::testing::Test
+{
+};
+
+/// \brief Test if free functions can be wrapped.
+TEST_F(InplaceDelegateTest, FreeFunctionTest)
+{
+    InplaceDelegate<int(int, int)> del(Sum);
+    EXPECT_EQ(del(2, 3), 5);
+    EXPECT_TRUE(del.IsTriviallyRelocatable());
+}
+
+TEST_F(InplaceDelegateTest, NullFunctionPointerTest)
+{
+    ASSERT_ANY_THROW(InplaceDelegate<int(int, int)> del(static_cast<int (*)(int, int)>(nullptr)));
+}
+
+TEST_F(InplaceDelegateTest, MemberFunctionTest)
+{
+    TestClass obj;
+    InplaceDelegate<int(int)> del(&TestClass::Multiply, &obj);
+    InplaceDelegate<int(int)> constDel(&TestClass::ConstMultiply, static_cast<const TestClass*>(&obj));
+    EXPECT_EQ(del(2), 6);
+    EXPECT_EQ(constDel(3), 9);
+    EXPECT_TRUE(del.IsTriviallyRelocatable());
+}
+
+TEST_F(InplaceDelegateTest, StatefulLambdaTest)
+{
+    int a = 1;
+    InplaceDelegate<int(int)> del([a](int x) { return x + a; });
+    EXPECT_EQ(del(2), 3);
+}
+
+TEST_F(InplaceDelegateTest, EmptyDelegateTest)
+{
+    InplaceDelegate<void()> del;
+    EXPECT_FALSE(del);
+    del = []() {};
+    EXPECT_TRUE(del);
+    del.Reset();
+    EXPECT_FALSE(del);
+}
+
+TEST_F(InplaceDelegateTest, CopyAndMoveTest)
+{
+    InplaceDelegate<int(int)> del([](int x) { return x * 2; });
+    InplaceDelegate<int(int)> copy(del);
+    InplaceDelegate<int(int)> moved(std::move(del));
+
+    EXPECT_EQ(copy(2), 4);
+    EXPECT_EQ(moved(3), 6);
+    EXPECT_FALSE(del);
+}
+
+TEST_F(InplaceDelegateTest, NonTrivialCallableLifetimeTest)
+{
+    {
+        InplaceDelegate<int(int)> del {CountingCallable {}};
+        EXPECT_FALSE(del.IsTriviallyRelocatable());
+        EXPECT_EQ(CountingCallable::liveInstances, 1);
+
+        InplaceDelegate<int(int)> copy(del);
+        EXPECT_EQ(CountingCallable::liveInstances, 2);
+
+        InplaceDelegate<int(int)> moved(std::move(del));
+        EXPECT_EQ(CountingCallable::liveInstances, 2);
+        EXPECT_EQ(moved(1), 2);
+
+        copy = moved;
+        EXPECT_EQ(CountingCallable::liveInstances, 2);
+    }
+    EXPECT_EQ(CountingCallable::liveInstances, 0);
+}
+
+TEST_F(InplaceDelegateTest, MoveOnlyCallableTest)
+{
+    auto value = std::make_unique<int>(41);
+    MoveOnlyInplaceDelegate<int()> del([value = std::move(value)]() { return *value + 1; });
+    MoveOnlyInplaceDelegate<int()> moved(std::move(del));
+
+    EXPECT_EQ(moved(), 42);
+
+    // Copying a move-only callable is a compile error rather than a runtime one
+    using MoveOnlyLambda = decltype([value = std::unique_ptr<int>()]() { return 0; });
+    static_assert(!std::is_constructible_v<InplaceDelegate<int()>, MoveOnlyLambda>);
+    static_assert(std::is_constructible_v<MoveOnlyInplaceDelegate<int()>, MoveOnlyLambda>);
+    static_assert(!std::is_copy_constructible_v<MoveOnlyInplaceDelegate<int()>>);
+    static_assert(!std::is_copy_assignable_v<MoveOnlyInplaceDelegate<int()>>);
+    static_assert(std::is_copy_constructible_v<InplaceDelegate<int()>>);
+}
+
+TEST_F(InplaceDelegateTest, CapacityTest)
+{
+    struct Large
+    {
+        char data[64];
+
+        int operator()() const { return data[0]; }
+    };
+
+    static_assert(!InplaceDelegate<int()>::Fits<Large>);
+    static_assert(InplaceDelegate<int(), sizeof(Large)>::Fits<Large>);
+
+    // Only the buffer and two function pointers, no heap spill state
+    static_assert(sizeof(InplaceDelegate<int(), 16>) == 16 + 2 * sizeof(void*));
+
+    InplaceDelegate<int(), sizeof(Large)> del {Large {{7}}};
+    EXPECT_EQ(del(), 7);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <NGIN/Util/Delegate/MulticastDelegate.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+using namespace NGIN::Util;
+
+namespace
+{
+    int freeFunctionSum = 0;
+
+    void AddToSum(int x)
+    {
+        freeFunctionSum += x;
+    }
+
+    struct Accumulator
+    {
+        int total = 0;
+
+        void Add(int x)
+        {
+            total += x;
+        }
+    };
+}
+
+class MulticastDelegateTest : public ::testing::Test
+{
+};
+
+TEST_F(MulticastDelegateTest, BroadcastToAllTest)
+{
+    MulticastDelegate<void(int)> del;
+    Accumulator accumulator;
+    int lambdaSum = 0;
+    freeFunctionSum = 0;
+
+    del.Add(&AddToSum);
+    del.Add(&Accumulator::Add, &accumulator);
+    del.Add([&lambdaSum](int x) { lambdaSum += x; });
+
+    del(5);
+    EXPECT_EQ(freeFunctionSum, 5);
+    EXPECT_EQ(accumulator.total, 5);
+    EXPECT_EQ(lambdaSum, 5);
+    EXPECT_EQ(del.GetSize(), 3u);
+}
+
+TEST_F(MulticastDelegateTest, RemoveTest)
+{
+    MulticastDelegate<void(int)> del;
+    std::vector<int> called;
+
+    auto first = del.Add([&called](int) { called.push_back(1); });
+    auto second = del.Add([&called](int) { called.push_back(2); });
+    auto third = del.Add([&called](int) { called.push_back(3); });
+
+    EXPECT_TRUE(del.Remove(first));
+    EXPECT_FALSE(del.Remove(first));
+    EXPECT_FALSE(del.Contains(first));
+    EXPECT_TRUE(del.Contains(second));
+    EXPECT_TRUE(del.Contains(third));
+
+    del(0);
+    std::sort(called.begin(), called.end());
+    EXPECT_EQ(called, (std::vector<int> {2, 3}));
+
+    // Tokens of moved callbacks stay valid
+    EXPECT_TRUE(del.Remove(third));
+    called.clear();
+    del(0);
+    EXPECT_EQ(called, (std::vector<int> {2}));
+}
+
+TEST_F(MulticastDelegateTest, StaleTokenTest)
+{
+    MulticastDelegate<void()> del;
+    auto token = del.Add([]() {});
+    del.Remove(token);
+
+    auto reused = del.Add([]() {});
+    EXPECT_EQ(reused.index, token.index);
+    EXPECT_FALSE(del.Remove(token));
+    EXPECT_TRUE(del.Contains(reused));
+}
+
+TEST_F(MulticastDelegateTest, RemoveDuringBroadcastTest)
+{
+    struct Context
+    {
+        MulticastDelegate<void()> del;
+        int calls = 0;
+        MulticastDelegate<void()>::Token self;
+        MulticastDelegate<void()>::Token other;
+    } ctx;
+
+    ctx.self = ctx.del.Add([&ctx]()
+                           {
+                               ++ctx.calls;
+                               ctx.del.Remove(ctx.self);
+                               ctx.del.Remove(ctx.other);
+                           });
+    ctx.other = ctx.del.Add([&ctx]() { ++ctx.calls; });
+
+    ctx.del();
+    EXPECT_EQ(ctx.calls, 1);
+    EXPECT_TRUE(ctx.del.IsEmpty());
+
+    ctx.del();
+    EXPECT_EQ(ctx.calls, 1);
+}
+
+TEST_F(MulticastDelegateTest, AddDuringBroadcastTest)
+{
+    MulticastDelegate<void()> del;
+    int lateCalls = 0;
+    bool added = false;
+
+    del.Add([&]()
+            {
+                if (!added)
+                {
+                    added = true;
+                    del.Add([&]() { ++lateCalls; });
+                }
+            });
+
+    del();
+    EXPECT_EQ(lateCalls, 0);
+    del();
+    EXPECT_EQ(lateCalls, 1);
+    EXPECT_EQ(del.GetSize(), 2u);
+}
+
+TEST_F(MulticastDelegateTest, ThrowingCallbackEndsBroadcastTest)
+{
+    MulticastDelegate<void()> del;
+    bool shouldThrow = true;
+    del.Add([&]()
+            {
+                if (shouldThrow)
+                    throw std::runtime_error("callback");
+            });
+    EXPECT_THROW(del(), std::runtime_error);
+
+    // The broadcast is over, so new callbacks are added right away
+    shouldThrow = false;
+    int calls = 0;
+    del.Add([&]() { ++calls; });
+    del();
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(del.GetSize(), 2u);
+}
+
+TEST_F(MulticastDelegateTest, ClearTest)
+{
+    MulticastDelegate<void()> del;
+    int calls = 0;
+    auto token = del.Add([&]() { ++calls; });
+
+    del.Clear();
+    del();
+    EXPECT_EQ(calls, 0);
+    EXPECT_FALSE(del.Contains(token));
+    EXPECT_TRUE(del.IsEmpty());
+}
+
+TEST_F(MulticastDelegateTest, ConstReferenceArgumentTest)
+{
+    struct Payload
+    {
+        int value;
+    };
+
+    MulticastDelegate<void(const Payload&)> del;
+    int sum = 0;
+    del.Add([&sum](const Payload& payload) { sum += payload.value; });
+    del.Add([&sum](const Payload& payload) { sum += payload.value * 10; });
+
+    del(Payload {2});
+    EXPECT_EQ(sum, 22);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <NGIN/Util/Delegate/StaticDelegate.hpp>
 #include <functional>
+#include <memory>
+#include <array>
+#include <NGIN/Memory/LinearAllocator.hpp>
 using namespace NGIN::Util;
 
 namespace
@@ -176,3 +179,40 @@ TEST_F(StaticDelegateTest, NonCopyableCallable)
     StaticDelegate<int(int)> del(std::move(obj));
     EXPECT_EQ(del(1), 2);
 }
+
+TEST_F(StaticDelegateTest, RelocateTest)
+{
+    using Delegate = StaticDelegate<int(int, int)>;
+
+    auto shared = std::make_shared<int>(100);
+    alignas(Delegate) std::byte source[sizeof(Delegate) * 2];
+    alignas(Delegate) std::byte destination[sizeof(Delegate) * 2];
+    auto* src = reinterpret_cast<Delegate*>(source);
+    auto* dst = reinterpret_cast<Delegate*>(destination);
+
+    new (&src[0]) Delegate(ReturningSimpleFunction);
+    new (&src[1]) Delegate([shared](int x, int y) { return *shared + x + y; });
+
+    Delegate::Relocate(dst, src, 2);
+
+    EXPECT_EQ(dst[0](1, 2), 3);
+    EXPECT_EQ(dst[1](1, 2), 103);
+    EXPECT_EQ(shared.use_count(), 2);
+
+    dst[0].~Delegate();
+    dst[1].~Delegate();
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST_F(StaticDelegateTest, LargeCaptureSpillsToAllocator)
+{
+    NGIN::Memory::LinearAllocator allocator(1024);
+    std::array<int, 32> values {};
+    values.fill(2);
+
+    StaticDelegate<int(int, int)> del([values](int x, int y) { return values[31] + x + y; }, allocator);
+    EXPECT_EQ(del(3, 4), 9);
+
+    StaticDelegate<int(int, int)> moved(std::move(del));
+    EXPECT_EQ(moved(3, 4), 9);
+}